@@ -0,0 +1,34 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __altitude_h__
+#define __altitude_h__
+
+#include <stdint.h>
+
+// Converts pressure to altitude using the international standard atmosphere without any floating-point math.
+// The conversion uses quadratic interpolation in a table and the maximum error compared to
+// 44330 * (1 - (p / 101325)^(1 / 5.255)) is 22 mm between 10 and 1200 mbar, see tools/bench_altitude.cpp
+
+#define ALTITUDE_MIN_PRESSURE       (512L) // Pressures outside the table are clamped
+#define ALTITUDE_MAX_PRESSURE       (131071L)
+
+int32_t Altitude_FromPressure(int32_t pressure);
+
+int32_t Altitude_AboveGround(int32_t pressure, int32_t ground_pressure);
+
+#endif // __altitude_h__
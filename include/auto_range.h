@@ -0,0 +1,48 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __auto_range_h__
+#define __auto_range_h__
+
+#include <stdint.h>
+
+#include "launch_detector.h"
+#include "mpu6500.h"
+
+// Chooses the full-scale ranges of the IMU from the raw readings. When a reading gets close to saturation the widest
+// range is used right away, as the true value is unknown, and the range is narrowed one step at a time once all
+// readings have stayed low for a while, so the resolution is only given up while it is needed
+
+#define AUTO_RANGE_UP_THRESHOLD     (29491) // A raw reading above 90 % of the full scale is close to saturation
+#define AUTO_RANGE_DOWN_THRESHOLD   (13107) // Readings below 40 % of the full scale are below 80 % of the next lower range
+#define AUTO_RANGE_HOLD_MICROS      (1000000UL) // Time in us the readings must stay low before the range is narrowed
+#define AUTO_RANGE_MIN_GYRO         (MPU6500_GYRO_RANGE_250)
+#define AUTO_RANGE_MIN_ACC          (MPU6500_ACC_RANGE_4) // The launch detector must be able to measure its threshold
+
+static_assert(MPU6500_GetAccFullScale(AUTO_RANGE_MIN_ACC) > LAUNCH_DETECTOR_ACC_THRESHOLD, "The narrowest range must cover the launch threshold");
+
+/** Struct for the auto-ranging */
+typedef struct {
+  mpu6500_range_t range; /*!< Range chosen from the readings */
+  uint32_t gyro_timestamp, acc_timestamp; /*!< Time in us when a reading was last above the lower threshold */
+} auto_range_t;
+
+void AutoRange_Init(auto_range_t *auto_range, const mpu6500_range_t *range, uint32_t timestamp);
+
+bool AutoRange_Update(auto_range_t *auto_range, uint32_t timestamp, const mpu6500_range_t *range, const sensorRaw_t *gyro, const sensorRaw_t *acc);
+
+#endif // __auto_range_h__
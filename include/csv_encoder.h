@@ -0,0 +1,52 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __csv_encoder_h__
+#define __csv_encoder_h__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "log_format.h"
+
+#define CSV_ENCODER_MAX_ROW_SIZE    (128U) // Longest possible row including the newline
+#define CSV_ENCODER_FRACTION_BITS   (24U) // Fractional bits of the fixed-point scale factors
+#define CSV_ENCODER_CORRUPTED       "# The rest of the log file is corrupted\n" // Last row if the log could not be read to the end
+#define CSV_ENCODER_RANGE_HEADER    (0xFF) // The scale factors in the header are used until the first LOG_RECORD_RANGE record
+
+/** Struct for converting log records into CSV rows without using printf or floating-point math per value */
+typedef struct {
+  int64_t gyro_scale, acc_scale; /*!< Scale factors from raw counts to 1e-4 deg/s and 1e-4 m/s^2 */
+  mpu6500_range_t range; /*!< Range of the samples. Both are set to CSV_ENCODER_RANGE_HEADER until the range changes */
+  int32_t ground_altitude; /*!< Altitude of the ground reference pressure in mm */
+  int32_t pressure; /*!< Pressure of the previous row */
+  int32_t altitude; /*!< Altitude above the ground of the previous row in mm. The barometer is sampled slower than the IMU, so it is usually reused */
+  char row[CSV_ENCODER_MAX_ROW_SIZE]; /*!< Row which did not fit into the output buffer */
+  uint8_t row_length, row_position; /*!< Length of the pending row and the number of bytes already sent */
+} csv_encoder_t;
+
+void CsvEncoder_Init(csv_encoder_t *csv_encoder, const log_header_t *header);
+
+void CsvEncoder_Restore(csv_encoder_t *csv_encoder, int32_t pressure, const mpu6500_range_t *range);
+
+size_t CsvEncoder_Format(csv_encoder_t *csv_encoder, const log_record_t *record, char *out);
+
+size_t CsvEncoder_Write(csv_encoder_t *csv_encoder, const log_record_t *record, uint8_t *buffer, size_t size);
+
+size_t CsvEncoder_Flush(csv_encoder_t *csv_encoder, uint8_t *buffer, size_t size);
+
+#endif // __csv_encoder_h__
@@ -0,0 +1,60 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __csv_index_h__
+#define __csv_index_h__
+
+#include <stdint.h>
+
+#include "csv_encoder.h"
+#include "log_reader.h"
+
+// Maps offsets in the CSV file to positions in the binary log, so a download of the CSV file can be resumed
+// without converting all the rows before the requested offset. The index is built in the background after the log is closed
+
+#define CSV_INDEX_SIZE              (64U) // Number of checkpoints. Every second one is removed when it is full
+#define CSV_INDEX_UPDATE_RECORDS    (100U) // Number of records converted for every call to CsvIndex_Update
+
+/** Position in the log from where the conversion can be started */
+typedef struct {
+  uint32_t csv_offset; /*!< Offset in the CSV file of the first row after the checkpoint */
+  uint32_t log_offset; /*!< Offset in the log of the next record or compressed block, see LogReader_Tell */
+  int32_t pressure; /*!< Pressure of the previous row, as the altitude is only calculated when it changes */
+  mpu6500_range_t range; /*!< Range of the samples, see csv_encoder_t */
+} csv_index_entry_t;
+
+/** Struct for the index of the CSV file */
+typedef struct {
+  uint32_t id; /*!< Identity of the log, see LogFormat_GetId */
+  uint32_t length; /*!< Number of bytes converted so far. This is the length of the CSV file when complete */
+  bool complete; /*!< Set when the whole log has been converted */
+  uint32_t boundaries; /*!< Number of positions seen where the conversion can be started */
+  uint32_t stride; /*!< Only every "stride" position is stored. This is doubled every time the index is full */
+  uint8_t count; /*!< Number of checkpoints */
+  csv_index_entry_t entries[CSV_INDEX_SIZE];
+  csv_encoder_t encoder; /*!< Used to find the length of every row */
+} csv_index_t;
+
+void CsvIndex_Reset(csv_index_t *csv_index);
+
+void CsvIndex_Init(csv_index_t *csv_index, uint32_t id, const log_header_t *header);
+
+bool CsvIndex_Update(csv_index_t *csv_index, log_reader_t *log_reader);
+
+bool CsvIndex_Seek(const csv_index_t *csv_index, log_reader_t *log_reader, csv_encoder_t *csv_encoder, uint32_t offset);
+
+#endif // __csv_index_h__
@@ -0,0 +1,75 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __estimator_h__
+#define __estimator_h__
+
+#include <stdint.h>
+
+#include "mpu6500.h"
+
+// Estimates the attitude, altitude and vertical velocity from the raw sensor readings.
+// The attitude is found using a complementary filter, which integrates the gyroscope and corrects it towards the gravity
+// measured by the accelerometer when the rocket is not accelerating. The vertical acceleration is then integrated and corrected
+// towards the barometer altitude using a second order complementary filter.
+// Everything is done in fixed point, as the ESP8266 does not have an FPU. See tools/bench_estimator.cpp for the accuracy
+
+#define ESTIMATOR_ATTITUDE_KP       (2.0f) // Proportional gain in 1/s of the attitude correction i.e. a time constant of 0.5 s
+#define ESTIMATOR_ATTITUDE_KI       (0.05f) // Integral gain in 1/s^2 used to estimate the gyroscope bias
+#define ESTIMATOR_ACC_MIN           (0.9f) // The attitude is only corrected when the acceleration in g is within these limits,
+#define ESTIMATOR_ACC_MAX           (1.1f) // as the accelerometer only measures the gravity when the rocket is not accelerating
+#define ESTIMATOR_ALTITUDE_GAIN     (2.0f) // Gains in 1/s and 1/s^2 of the barometer correction, which gives a critically
+#define ESTIMATOR_VELOCITY_GAIN     (1.0f) // damped filter with a time constant of 1 s
+#define ESTIMATOR_SETTLE_TIME       (3000000UL) // Time in us after the first barometer reading before the velocity has settled
+#define ESTIMATOR_MAX_DT            (100000UL) // Longer time steps in us are clamped, so a gap in the readings does not make the filter diverge
+
+/** Struct for the estimator. The quaternion is stored in Q30 and the altitude and velocity in Q16 */
+typedef struct {
+  int32_t q[4]; /*!< Attitude quaternion (w, x, y, z) of the body frame relative to the earth frame */
+  int32_t gyro_bias[3]; /*!< Estimated gyroscope bias in rad/s in Q30 */
+  int64_t altitude; /*!< Altitude above the ground in mm */
+  int64_t velocity; /*!< Vertical velocity in mm/s */
+  int32_t vertical_acc; /*!< Vertical acceleration without gravity in mm/s^2 */
+  int32_t ground_pressure; /*!< Pressure in pascal the altitude is measured from */
+
+  // Constants calculated from the scale factors
+  int32_t gyro_k; /*!< Converts the raw gyroscope readings into rad/s in Q24 */
+  int32_t acc_k; /*!< Converts the raw accelerometer readings into g in Q20 */
+  uint32_t acc_min_squared, acc_max_squared; /*!< Squared limits in raw accelerometer units */
+
+  uint32_t imu_timestamp, baro_timestamp; /*!< Time in us of the last readings */
+  uint32_t settle_timestamp; /*!< Time in us of the first barometer reading */
+  bool imu_valid, baro_valid; /*!< Set after the first reading */
+} estimator_t;
+
+void Estimator_Init(estimator_t *estimator, float gyro_scale_factor, float acc_scale_factor, int32_t ground_pressure);
+
+void Estimator_SetScale(estimator_t *estimator, float gyro_scale_factor, float acc_scale_factor);
+
+void Estimator_UpdateImu(estimator_t *estimator, uint32_t timestamp, const sensorRaw_t *gyro, const sensorRaw_t *acc);
+
+void Estimator_UpdatePressure(estimator_t *estimator, uint32_t timestamp, int32_t pressure);
+
+int32_t Estimator_GetAltitude(const estimator_t *estimator);
+
+int32_t Estimator_GetVelocity(const estimator_t *estimator);
+
+uint32_t Estimator_GetAttitude(const estimator_t *estimator);
+
+bool Estimator_IsSettled(const estimator_t *estimator);
+
+#endif // __estimator_h__
@@ -0,0 +1,70 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __flash_log_h__
+#define __flash_log_h__
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Append-only log stored directly in a raw flash region without a file system. The first sector holds the length of
+// the log and the data follows in the next sectors. Only the first sector is erased when the log is opened, the rest is
+// erased one sector at a time using FlashLog_EraseAhead() before it is written. Erasing a sector blocks for longer than the
+// MPU-6500 FIFO can buffer at 1 kHz, so it is never done by FlashLog_Write(), which stops at the end of the erased part.
+// Erased flash reads as 0xFF and can be programmed without erasing it again, which is used to store the length when the log is closed
+
+#define FLASH_LOG_SECTOR_SIZE       (4096U)
+#define FLASH_LOG_MAGIC             (0x48534C46UL) // "FLSH" in little endian
+#define FLASH_LOG_ERASED            (0xFFFFFFFFUL)
+
+/** Stored at the start of the first sector */
+typedef struct {
+  uint32_t magic; /*!< Set to FLASH_LOG_MAGIC when the log is opened */
+  uint32_t length; /*!< Number of bytes in the log. Erased until the log is closed */
+} flash_log_info_t;
+
+/** Struct for the raw flash region */
+typedef struct {
+  uint32_t start; /*!< Flash address of the first data sector */
+  uint32_t end; /*!< Flash address of the end of the region */
+  uint32_t write_address; /*!< Next address to be programmed */
+  uint32_t erase_address; /*!< Everything between the write address and this address is erased */
+  uint32_t length; /*!< Number of bytes in the log */
+  bool open; /*!< Set while the log is being written */
+} flash_log_t;
+
+bool FlashLog_Init(flash_log_t *flash_log, uint32_t address, uint32_t size);
+
+bool FlashLog_Open(flash_log_t *flash_log);
+
+bool FlashLog_IsOpen(const flash_log_t *flash_log);
+
+size_t FlashLog_Write(flash_log_t *flash_log, const uint8_t *data, size_t size);
+
+bool FlashLog_IsErased(const flash_log_t *flash_log, uint32_t size);
+
+bool FlashLog_EraseAhead(flash_log_t *flash_log);
+
+void FlashLog_Close(flash_log_t *flash_log);
+
+uint32_t FlashLog_GetLength(const flash_log_t *flash_log);
+
+uint32_t FlashLog_GetFree(const flash_log_t *flash_log);
+
+size_t FlashLog_Read(const flash_log_t *flash_log, uint32_t offset, uint8_t *data, size_t size);
+
+#endif // __flash_log_h__
@@ -0,0 +1,100 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __flight_index_h__
+#define __flight_index_h__
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Every flight is stored in its own numbered log file. A small index file holds a summary of every flight, so the flights
+// can be listed without opening the log files. The index is append-only: a new entry is written when a log is started
+// and when it is closed, and later entries replace earlier ones with the same id. It is only rewritten when it grows too large
+
+#define FLIGHT_INDEX_FILENAME       "/flights.idx"
+#define FLIGHT_INDEX_TMP_FILENAME   "/flights.tmp"
+#define FLIGHT_INDEX_MAGIC          (0x58444946UL) // "FIDX" in little endian
+#define FLIGHT_INDEX_VERSION        (1U)
+#define FLIGHT_INDEX_MAX_FLIGHTS    (32U) // Maximum number of flights which are kept
+#define FLIGHT_INDEX_MAX_OPEN       (4U) // Maximum number of logs which are read at once, see FlightIndex_Open
+#define FLIGHT_INDEX_MIN_FREE       (50U) // Percentage of the file system which must be free when a log is started, see flight_evict_e
+#define FLIGHT_INDEX_PATH_SIZE      (24U) // Size of the buffer for the path of a log file
+#define FLIGHT_INDEX_JSON_SIZE      (64U + 136U * FLIGHT_INDEX_MAX_FLIGHTS)
+
+#define FLIGHT_FLAG_CLOSED          (1U << 0) // The log was closed. Otherwise it is still being written or was never closed
+#define FLIGHT_FLAG_DOWNLOADED      (1U << 1) // The whole log has been downloaded as either binary or CSV
+#define FLIGHT_FLAG_DELETED         (1U << 2) // The log was deleted. Only used in the index file
+
+/** Decides which flights are deleted when a log is started and there is not enough room */
+typedef enum {
+  FLIGHT_EVICT_NONE = 0, // Nothing is deleted. The log stops when the file system is full
+  FLIGHT_EVICT_OLDEST = 1, // The oldest flights are deleted
+  FLIGHT_EVICT_DOWNLOADED = 2, // The oldest flights which have been downloaded are deleted, so a flight is never lost before it is downloaded
+} flight_evict_e;
+
+/** Summary of a flight. This is stored in the index file as well */
+typedef struct {
+  uint32_t id; /*!< Number of the flight. The ids are never reused */
+  uint32_t start_time; /*!< Unix time when the log was started as given by the browser. Zero if not known */
+  uint32_t records; /*!< Number of records written to the log */
+  uint32_t size; /*!< Size of the log file in bytes */
+  uint16_t sample_rate; /*!< Sample rate in Hz when the log was started */
+  uint16_t flags; /*!< See FLIGHT_FLAG_* */
+} __attribute__((packed)) flight_entry_t;
+static_assert(sizeof(flight_entry_t) == 20, "The size of the entries in the index file must not change");
+
+/** Header of the index file */
+typedef struct {
+  uint32_t magic; /*!< Set to FLIGHT_INDEX_MAGIC */
+  uint16_t version; /*!< Set to FLIGHT_INDEX_VERSION */
+  uint16_t entry_size; /*!< Size of every entry */
+  uint32_t next_id; /*!< Id of the next flight when the file was written. Later entries might have a larger id */
+} __attribute__((packed)) flight_index_header_t;
+
+/** Struct for the flights stored on the file system */
+typedef struct {
+  flight_entry_t flights[FLIGHT_INDEX_MAX_FLIGHTS]; /*!< Sorted by id, so the oldest flight is first */
+  uint8_t count; /*!< Number of flights */
+  uint32_t next_id; /*!< Id of the next flight */
+  uint16_t file_entries; /*!< Number of entries in the index file. It is rewritten when this gets too large */
+  flight_evict_e policy;
+  uint32_t open[FLIGHT_INDEX_MAX_OPEN]; /*!< Flights whose log is being read, so they are never evicted. Zero if unused */
+} flight_index_t;
+
+void FlightIndex_Init(flight_index_t *flight_index, flight_evict_e policy);
+
+uint32_t FlightIndex_Start(flight_index_t *flight_index, uint32_t start_time, uint16_t sample_rate);
+
+void FlightIndex_Close(flight_index_t *flight_index, uint32_t id, uint32_t records);
+
+void FlightIndex_SetDownloaded(flight_index_t *flight_index, uint32_t id);
+
+bool FlightIndex_Delete(flight_index_t *flight_index, uint32_t id);
+
+bool FlightIndex_Open(flight_index_t *flight_index, uint32_t id);
+
+void FlightIndex_Release(flight_index_t *flight_index, uint32_t id);
+
+const flight_entry_t *FlightIndex_Find(const flight_index_t *flight_index, uint32_t id);
+
+const flight_entry_t *FlightIndex_GetLatest(const flight_index_t *flight_index);
+
+void FlightIndex_GetPath(uint32_t id, char *path);
+
+size_t FlightIndex_FormatJson(const flight_index_t *flight_index, char *buffer, size_t size);
+
+#endif // __flight_index_h__
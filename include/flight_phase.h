@@ -0,0 +1,79 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __flight_phase_h__
+#define __flight_phase_h__
+
+#include <stdint.h>
+
+#include "launch_detector.h"
+#include "mpu6500.h"
+#include "ms5611.h"
+
+// Tracks the phase of the flight from the accelerometer and barometer readings, so the sample rates can follow it.
+// The launch is detected using the launch detector, after that the raw readings are compared against precomputed thresholds
+
+#define FLIGHT_PHASE_BURNOUT_THRESHOLD      (2.0f) // The motor has burned out when the acceleration in g drops below this
+#define FLIGHT_PHASE_BURNOUT_DURATION       (20000UL) // Time in us the acceleration must stay below the burnout threshold
+#define FLIGHT_PHASE_APOGEE_DROP            (2000L) // Apogee is passed when the altitude is below the highest altitude and either the estimated velocity is negative or the altitude in mm has dropped this much
+#define FLIGHT_PHASE_APOGEE_COUNT           (5U) // Number of consecutive pressure readings past the apogee
+#define FLIGHT_PHASE_APOGEE_DURATION        (2000000UL) // Time in us the apogee phase lasts, so the deployment is logged at the full rate
+#define FLIGHT_PHASE_LANDED_WINDOW          (5000L) // Landed when the altitude in mm stays within this distance...
+#define FLIGHT_PHASE_LANDED_DURATION        (5000000UL) // ...for this long in us
+
+typedef enum {
+  FLIGHT_PHASE_PAD = 0,
+  FLIGHT_PHASE_BOOST = 1,
+  FLIGHT_PHASE_COAST = 2,
+  FLIGHT_PHASE_APOGEE = 3,
+  FLIGHT_PHASE_DESCENT = 4,
+  FLIGHT_PHASE_LANDED = 5,
+  FLIGHT_PHASE_COUNT,
+} flight_phase_e;
+
+/** Sample rates used in each phase */
+typedef struct {
+  uint16_t sample_rate; /*!< IMU sample rate in Hz. It is limited to the configured sample rate */
+  ms5611_osr_mask_e osr_mask; /*!< Barometer oversampling ratio */
+} flight_phase_config_t;
+
+/** Struct for the flight phase detector */
+typedef struct {
+  flight_phase_e phase;
+  uint32_t phase_timestamp; /*!< Time in us when the phase was entered */
+  launch_detector_t launch_detector;
+  uint32_t burnout_threshold_squared; /*!< Squared threshold in raw accelerometer units */
+  uint32_t burnout_timestamp; /*!< Time in us when the acceleration went below the threshold */
+  bool burnout_below; /*!< Set while the acceleration is below the threshold */
+  int32_t ground_pressure; /*!< Pressure in pascal the altitude is measured from */
+  int32_t max_altitude; /*!< Highest altitude in mm */
+  uint8_t apogee_count; /*!< Number of consecutive pressure readings past the apogee */
+  int32_t landed_altitude; /*!< Altitude in mm the landed window is centered on */
+  uint32_t landed_timestamp; /*!< Time in us when the altitude entered the window */
+} flight_phase_t;
+
+void FlightPhase_Init(flight_phase_t *flight_phase, float acc_scale_factor, int32_t ground_pressure);
+
+void FlightPhase_SetScale(flight_phase_t *flight_phase, float acc_scale_factor);
+
+bool FlightPhase_UpdateImu(flight_phase_t *flight_phase, uint32_t timestamp, const sensorRaw_t *acc);
+
+bool FlightPhase_UpdatePressure(flight_phase_t *flight_phase, uint32_t timestamp, int32_t pressure, int32_t velocity);
+
+const flight_phase_config_t *FlightPhase_GetConfig(flight_phase_e phase);
+
+#endif // __flight_phase_h__
@@ -0,0 +1,34 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __http_range_h__
+#define __http_range_h__
+
+#include <stdint.h>
+
+// Parses the "Range" header of a HTTP request, so a download can be resumed where it stopped.
+// Only a single range is supported. Anything else is ignored and the whole file is sent, as allowed by RFC 7233
+
+typedef enum {
+  HTTP_RANGE_NONE = 0, // The whole file should be sent
+  HTTP_RANGE_PARTIAL = 1, // Only the range should be sent using "206 Partial Content"
+  HTTP_RANGE_UNSATISFIABLE = 2, // The range is outside the file, so "416 Range Not Satisfiable" should be sent
+} http_range_e;
+
+http_range_e HttpRange_Parse(const char *value, uint32_t size, uint32_t *first, uint32_t *last);
+
+#endif // __http_range_h__
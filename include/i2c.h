@@ -18,9 +18,15 @@
 #ifndef __i2c_h__
 #define __i2c_h__
 
+#include <stddef.h>
 #include <stdint.h>
 
-void I2C_Init(int sda, int scl);
+#define I2C_CLOCK                   (400000UL) // Highest clock in the specification of both the MPU-6500 and the MS5611
+#define I2C_WIRE_BUFFER_SIZE        (128U) // The Wire library can read at most this number of bytes at a time
+#define I2C_WRITE_BUFFER_SIZE       (16U) // Most bytes written at once by the fast driver including the register
+
+void I2C_Init(int sda, int scl, bool fast = false);
+size_t I2C_GetMaxReadSize();
 uint8_t I2C_Write(uint8_t addr, uint8_t regAddr, bool sendStop = true);
 uint8_t I2C_WriteData(uint8_t addr, uint8_t regAddr, uint8_t data, bool sendStop = true);
 uint8_t I2C_WriteData(uint8_t addr, uint8_t regAddr, uint8_t *data, size_t size, bool sendStop = true);
@@ -0,0 +1,75 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __i2c_scheduler_h__
+#define __i2c_scheduler_h__
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Queue of I2C transactions submitted by the drivers. Every transaction has a priority, a release time before which it
+// is not started and a deadline. The ready transactions are done in order of priority and then deadline, and a low
+// priority transaction is held back if it would still be running when a high priority one is released.
+// This lets the barometer convert while the IMU is read and keeps the barometer from delaying the IMU reads
+
+#define I2C_SCHEDULER_SIZE          (4U) // Maximum number of pending transactions
+#define I2C_SCHEDULER_RETRIES       (2U) // A failed transaction is retried this number of times
+#define I2C_SCHEDULER_MARGIN_MICROS (50U) // Added to the estimated duration of a transaction to cover the driver overhead
+
+typedef enum {
+  I2C_PRIORITY_LOW = 0, // The barometer
+  I2C_PRIORITY_HIGH, // The IMU
+} i2c_priority_e;
+
+typedef enum {
+  I2C_JOB_IDLE = 0,
+  I2C_JOB_PENDING, // Submitted, but not done yet
+  I2C_JOB_DONE, // The result is in "rcode" and the data buffer
+} i2c_job_state_e;
+
+/** A transaction. It is owned by the driver and must stay valid until it is done or cancelled */
+typedef struct {
+  uint8_t addr; /*!< Address of the device */
+  i2c_priority_e priority;
+  uint8_t reg; /*!< Register or command written first */
+  uint8_t *data; /*!< Data written after the register or buffer for the data read */
+  uint16_t size; /*!< Number of bytes to write or read. Can be zero for a write */
+  bool read; /*!< Set if the data is read after the register is written */
+  bool send_stop; /*!< Release the bus between writing the register and reading the data */
+  uint32_t release_timestamp; /*!< The transaction is not started before this time in us */
+  uint32_t deadline; /*!< The transaction should be done by this time in us. Only a missed deadline of a high priority transaction is counted */
+  bool deferred; /*!< Set if the transaction was held back for a high priority transaction */
+  i2c_job_state_e state;
+  uint8_t rcode; /*!< Result of the transaction. Set when done */
+  uint32_t timestamp; /*!< Time in us when the transaction was started. Set when done */
+} i2c_job_t;
+
+static inline void I2CJob_Init(i2c_job_t *job, uint8_t addr, i2c_priority_e priority) {
+  job->addr = addr;
+  job->priority = priority;
+  job->state = I2C_JOB_IDLE;
+}
+
+void I2CScheduler_Init();
+
+void I2CScheduler_Submit(i2c_job_t *job, uint32_t release_timestamp, uint32_t deadline);
+
+void I2CScheduler_Cancel(i2c_job_t *job);
+
+uint8_t I2CScheduler_Run();
+
+#endif // __i2c_scheduler_h__
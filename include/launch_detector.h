@@ -0,0 +1,57 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __launch_detector_h__
+#define __launch_detector_h__
+
+#include <stdint.h>
+
+#include "mpu6500.h"
+
+// Detects the launch either from the acceleration or from the altitude rise measured by the barometer.
+// The raw readings are compared against precomputed thresholds, so it is cheap enough to run for every sample
+
+#define LAUNCH_DETECTOR_ACC_THRESHOLD       (3.0f) // Magnitude of the acceleration in g which must be exceeded
+#define LAUNCH_DETECTOR_ACC_DURATION        (50000UL) // Time in us the acceleration must stay above the threshold
+#define LAUNCH_DETECTOR_ALTITUDE_THRESHOLD  (10000L) // Altitude above the ground in mm which must be exceeded
+#define LAUNCH_DETECTOR_ALTITUDE_COUNT      (10U) // Number of consecutive pressure readings above the altitude threshold
+
+typedef enum {
+  LAUNCH_DETECTOR_NONE = 0,
+  LAUNCH_DETECTOR_ACC = 1, // The acceleration was above the threshold
+  LAUNCH_DETECTOR_ALTITUDE = 2, // The altitude was above the threshold
+} launch_detector_cause_e;
+
+/** Struct for the launch detector */
+typedef struct {
+  uint32_t acc_threshold_squared; /*!< Squared threshold in raw accelerometer units */
+  uint32_t acc_timestamp; /*!< Time in us when the acceleration went above the threshold */
+  bool acc_above; /*!< Set while the acceleration is above the threshold */
+  int32_t ground_pressure; /*!< Pressure in pascal the altitude is measured from */
+  uint8_t altitude_count; /*!< Number of consecutive pressure readings above the altitude threshold */
+  launch_detector_cause_e cause; /*!< Set when a launch is detected */
+} launch_detector_t;
+
+void LaunchDetector_Init(launch_detector_t *launch_detector, float acc_scale_factor, int32_t ground_pressure);
+
+void LaunchDetector_SetScale(launch_detector_t *launch_detector, float acc_scale_factor);
+
+bool LaunchDetector_UpdateImu(launch_detector_t *launch_detector, uint32_t timestamp, const sensorRaw_t *acc);
+
+bool LaunchDetector_UpdatePressure(launch_detector_t *launch_detector, int32_t pressure);
+
+#endif // __launch_detector_h__
@@ -0,0 +1,65 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __log_codec_h__
+#define __log_codec_h__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "log_format.h"
+
+// Records are stored in blocks which can be decoded independently. Every value is stored as the difference to the
+// previous record in the block using a zig-zag varint. The timestamp is stored as the change in the time difference,
+// so samples at a constant rate only take up a single byte
+
+#define LOG_CODEC_MAX_RECORD_SIZE   (27U) // Worst case size of an encoded record
+#define LOG_CODEC_BLOCK_SIZE        (2048U) // Maximum size of a block. This must be a multiple of the flash page size
+
+/** Header stored at the start of every compressed block */
+typedef struct {
+  uint16_t length; /*!< Length of the block in bytes including this header and any padding at the end */
+  uint16_t count; /*!< Number of records in the block */
+} __attribute__((packed)) log_block_header_t;
+
+// Returns the offset of the block after the one at "offset". The header of the log is written through the buffers of the
+// log writer and every block but the last fills a whole buffer, so the blocks end at multiples of LOG_CODEC_BLOCK_SIZE.
+// A reader continues from here when a block is corrupted
+static inline uint32_t LogCodec_NextBlock(uint32_t offset) {
+  return (offset / LOG_CODEC_BLOCK_SIZE + 1) * LOG_CODEC_BLOCK_SIZE;
+}
+
+// Returns true if the header of the block at "offset" is plausible, as a block never crosses the end of a buffer
+static inline bool LogCodec_IsValidBlock(uint32_t offset, const log_block_header_t *block_header) {
+  return block_header->length >= sizeof(log_block_header_t) && offset + block_header->length <= LogCodec_NextBlock(offset);
+}
+
+/** The previous record used for predicting the next one. This is reset at the start of every block */
+typedef struct {
+  uint32_t timestamp;
+  uint32_t dt;
+  int32_t pressure;
+  sensorRaw_t gyro, acc;
+} log_codec_state_t;
+
+void LogCodec_Reset(log_codec_state_t *state);
+
+size_t LogCodec_Encode(log_codec_state_t *state, const log_record_t *record, uint8_t *out);
+
+size_t LogCodec_Decode(log_codec_state_t *state, const uint8_t *in, size_t len, log_record_t *record);
+
+#endif // __log_codec_h__
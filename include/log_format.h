@@ -0,0 +1,175 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __log_format_h__
+#define __log_format_h__
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "mpu6500.h"
+
+#define LOG_MAGIC                   (0x474F4C52UL) // "RLOG" in little endian
+#define LOG_VERSION                 (3U)
+
+#define LOG_FLAG_COMPRESSED         (1UL << 0) // The records are stored in compressed blocks, see log_codec.h
+
+#define LOG_ATTITUDE_SCALE          (511) // The vector part of the attitude quaternion is stored as three 10-bit values
+
+typedef enum {
+  LOG_RECORD_SAMPLE = 0, // IMU and barometer sample
+  LOG_RECORD_DROPPED = 1, // Samples were dropped before this record. arg[0]: number of dropped samples
+  LOG_RECORD_STATS = 2, // Performance counters written when the log is closed. arg[0]: see log_stats_e, arg[1] and arg[2]: values
+  LOG_RECORD_LAUNCH = 3, // The launch was detected. The samples before it were kept in RAM. arg[0]: see launch_detector_cause_e
+  LOG_RECORD_PHASE = 4, // The flight phase changed. arg[0]: see flight_phase_e, arg[1]: sample rate in Hz from now on, arg[2]: barometer oversampling ratio
+  LOG_RECORD_ESTIMATE = 5, // Output of the estimator. arg[0]: altitude in mm, arg[1]: vertical velocity in mm/s, arg[2]: attitude, see LogFormat_GetTilt()
+  LOG_RECORD_RANGE = 6, // The samples from now on use other full-scale ranges. arg[0]: see mpu6500_gyro_range_e, arg[1]: see mpu6500_acc_range_e
+  LOG_RECORD_CORRUPTED = 7, // Never written to a log. Returned by the readers in place of a compressed block which could not be decoded. arg[0]: offset of the block
+} log_record_type_e;
+
+typedef enum {
+  LOG_STATS_SAMPLES = 0, // arg[1]: expected number of samples, arg[2]: logged samples
+  LOG_STATS_LOOP = 1, // arg[1]: mean loop time in us, arg[2]: worst case loop time in us
+  LOG_STATS_I2C = 2, // arg[1]: number of I2C transactions, arg[2]: number of failed transactions
+  LOG_STATS_I2C_LATENCY = 3, // arg[1]: mean I2C transaction time in us, arg[2]: worst case transaction time in us
+  LOG_STATS_FLASH = 4, // arg[1]: mean time to write a buffer in us, arg[2]: worst case time in us
+  LOG_STATS_HEAP = 5, // arg[1]: free heap in bytes, arg[2]: lowest free heap in bytes
+  LOG_STATS_ESTIMATOR = 6, // arg[1]: mean time to update the estimator in us, arg[2]: worst case time in us
+  LOG_STATS_LATENCY = 7, // arg[1]: mean time from when an IMU sample was taken until it was read in us, arg[2]: worst case in us
+  LOG_STATS_HIGH_WATER = 8, // arg[1]: most records waiting to be written, arg[2]: most samples read from the MPU-6500 FIFO at once
+  LOG_STATS_I2C_BUS = 9, // arg[1]: fraction of the time the I2C bus was busy in 0.1 %, arg[2]: I2C transactions per second
+  LOG_STATS_I2C_SCHEDULER = 10, // arg[1]: number of retried I2C transactions, arg[2]: number of transactions done after their deadline
+} log_stats_e;
+
+/** Header written at the start of every log file */
+typedef struct {
+  uint32_t magic; /*!< Set to LOG_MAGIC */
+  uint16_t version; /*!< Set to LOG_VERSION */
+  uint16_t header_size; /*!< Size of the header. New fields are added at the end, so older readers can skip them */
+  uint16_t record_size; /*!< Size of each record */
+  uint16_t sample_rate; /*!< Sample rate in Hz when the log was started */
+  float gyroScaleFactor; /*!< Gyroscope scale factor in LSB/(deg/s) */
+  float accScaleFactor; /*!< Accelerometer scale factor in LSB/g */
+  uint16_t prom_c[6]; /*!< MS5611 calibration data */
+  uint32_t flags; /*!< See LOG_FLAG_*. Added in version 2 */
+  int32_t ground_pressure; /*!< Pressure in pascal at the ground when the log was started. Added in version 3 */
+} __attribute__((packed)) log_header_t;
+static_assert(sizeof(log_header_t) == 40, "Fields must only be added at the end of the header");
+
+/** Record stored in the log file. The raw sensor readings are stored, so no conversions are done while logging */
+typedef struct {
+  uint32_t timestamp; /*!< Time since the log was started in us */
+  uint8_t type; /*!< See log_record_type_e */
+  union {
+    struct {
+      uint8_t pressure[3]; /*!< Pressure in pascal as a 24-bit little endian value */
+      sensorRaw_t gyro; /*!< Raw gyroscope readings */
+      sensorRaw_t acc; /*!< Raw accelerometer readings */
+    } __attribute__((packed)) sample;
+    struct {
+      uint8_t reserved[3];
+      uint32_t arg[3];
+    } __attribute__((packed)) event;
+  };
+} __attribute__((packed)) log_record_t;
+static_assert(sizeof(log_record_t) == 20, "The record size must not change");
+
+static inline void LogFormat_SetPressure(log_record_t *record, int32_t pressure) {
+  record->sample.pressure[0] = (uint8_t)pressure;
+  record->sample.pressure[1] = (uint8_t)(pressure >> 8);
+  record->sample.pressure[2] = (uint8_t)(pressure >> 16);
+}
+
+// Fills in the LOG_RECORD_CORRUPTED record returned in place of the block at "offset". The timestamp is not known
+static inline void LogFormat_SetCorrupted(log_record_t *record, uint32_t offset) {
+  memset(record, 0, sizeof(log_record_t));
+  record->type = LOG_RECORD_CORRUPTED;
+  record->event.arg[0] = offset;
+}
+
+// Returns a description of the two values of a LOG_RECORD_STATS record
+static inline const char *LogFormat_GetStatsName(uint32_t id) {
+  switch (id) {
+    case LOG_STATS_SAMPLES:
+      return "Samples expected/logged";
+    case LOG_STATS_LOOP:
+      return "Loop time mean/max (us)";
+    case LOG_STATS_I2C:
+      return "I2C transactions/errors";
+    case LOG_STATS_I2C_LATENCY:
+      return "I2C latency mean/max (us)";
+    case LOG_STATS_FLASH:
+      return "Flash write mean/max (us)";
+    case LOG_STATS_HEAP:
+      return "Free heap now/min (bytes)";
+    case LOG_STATS_ESTIMATOR:
+      return "Estimator mean/max (us)";
+    case LOG_STATS_LATENCY:
+      return "Sample latency mean/max (us)";
+    case LOG_STATS_HIGH_WATER:
+      return "Queue/FIFO high-water (records/samples)";
+    case LOG_STATS_I2C_BUS:
+      return "I2C bus utilisation (0.1 %)/transactions per s";
+    case LOG_STATS_I2C_SCHEDULER:
+      return "I2C retries/missed deadlines";
+  }
+  return "Unknown";
+}
+
+// Returns the name of the flight phase in a LOG_RECORD_PHASE record. The order follows flight_phase_e
+static inline const char *LogFormat_GetPhaseName(uint32_t phase) {
+  static const char *const names[] = { "pad", "boost", "coast", "apogee", "descent", "landed" };
+  return phase < sizeof(names) / sizeof(names[0]) ? names[phase] : "unknown";
+}
+
+// Returns a component of the attitude quaternion in a LOG_RECORD_ESTIMATE record. Index 0 to 2 is x, y and z
+static inline float LogFormat_GetAttitude(const log_record_t *record, uint8_t index) {
+  int32_t value = (int32_t)(record->event.arg[2] << (22 - 10 * index)) >> 22; // Sign extend the 10-bit value
+  return (float)value / LOG_ATTITUDE_SCALE;
+}
+
+// Returns the angle in degrees between the z-axis of the body and vertical in a LOG_RECORD_ESTIMATE record
+static inline float LogFormat_GetTilt(const log_record_t *record) {
+  float x = LogFormat_GetAttitude(record, 0), y = LogFormat_GetAttitude(record, 1);
+  float cos_tilt = 1.0f - 2.0f * (x * x + y * y);
+  return acosf(cos_tilt < -1.0f ? -1.0f : cos_tilt) * RAD_TO_DEGf;
+}
+
+// Returns the ranges in a LOG_RECORD_RANGE record. The scale factors in the header are used before the first one
+static inline mpu6500_range_t LogFormat_GetRange(const log_record_t *record) {
+  mpu6500_range_t range = { (uint8_t)(record->event.arg[0] & 0x03), (uint8_t)(record->event.arg[1] & 0x03) };
+  return range;
+}
+
+static inline int32_t LogFormat_GetPressure(const log_record_t *record) {
+  return (int32_t)record->sample.pressure[0] | ((int32_t)record->sample.pressure[1] << 8) | ((int32_t)record->sample.pressure[2] << 16);
+}
+
+// Identifies a log by a FNV-1a hash of the header and the size in bytes. This is used as the ETag when it is downloaded
+static inline uint32_t LogFormat_GetId(const log_header_t *header, uint32_t size) {
+  uint32_t hash = 2166136261UL;
+  const uint8_t *p = (const uint8_t*)header;
+  for (size_t i = 0; i < sizeof(log_header_t) + sizeof(size); i++) {
+    hash ^= i < sizeof(log_header_t) ? p[i] : (uint8_t)(size >> (8 * (i - sizeof(log_header_t))));
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+#endif // __log_format_h__
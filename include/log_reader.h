@@ -0,0 +1,57 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __log_reader_h__
+#define __log_reader_h__
+
+#include <stdint.h>
+#include <FS.h>
+
+#include "flash_log.h"
+#include "log_codec.h"
+#include "log_format.h"
+
+#define LOG_READER_BUFFER_SIZE      LOG_CODEC_BLOCK_SIZE
+
+/** Struct for reading the records of a log file one at a time */
+typedef struct {
+  File file;
+  const flash_log_t *flash_log; /*!< Raw flash region read instead of the file if set */
+  uint32_t flash_offset; /*!< Read position in the raw flash region */
+  log_header_t header; /*!< Header of the log file. Fields not present in the file are set to zero */
+  uint8_t buffer[LOG_READER_BUFFER_SIZE]; /*!< Raw records or the current compressed block */
+  uint16_t length, position; /*!< Number of bytes in the buffer and the current read position */
+  uint16_t block_remaining; /*!< Number of records left in the current compressed block */
+  uint32_t block_offset; /*!< Offset in the log of the current compressed block */
+  log_codec_state_t codec; /*!< Predictor state of the current compressed block */
+  uint32_t corrupted_blocks; /*!< Number of compressed blocks skipped, as they could not be decoded */
+  bool error; /*!< Set if the file is corrupted and the rest of it can not be read */
+} log_reader_t;
+
+bool LogReader_Open(log_reader_t *log_reader, File file);
+
+bool LogReader_OpenFlash(log_reader_t *log_reader, const flash_log_t *flash_log);
+
+bool LogReader_Next(log_reader_t *log_reader, log_record_t *record);
+
+bool LogReader_Tell(const log_reader_t *log_reader, uint32_t *offset);
+
+bool LogReader_Seek(log_reader_t *log_reader, uint32_t offset);
+
+void LogReader_Close(log_reader_t *log_reader);
+
+#endif // __log_reader_h__
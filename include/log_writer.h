@@ -0,0 +1,73 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __log_writer_h__
+#define __log_writer_h__
+
+#include <stdint.h>
+#include <FS.h>
+
+#include "flash_log.h"
+#include "log_codec.h"
+#include "log_format.h"
+
+#define LOG_WRITER_BUFFER_SIZE      LOG_CODEC_BLOCK_SIZE // Size of each buffer. A buffer holds exactly one compressed block
+
+/** Struct for the buffered log writer */
+typedef struct {
+  File file;
+  flash_log_t *flash_log; /*!< Raw flash region used instead of the file if set */
+  uint8_t buffer[2][LOG_WRITER_BUFFER_SIZE] __attribute__((aligned(4))); /*!< One buffer is filled while the other is waiting to be written. The flash is written in whole words */
+  uint16_t length[2]; /*!< Number of bytes in each buffer */
+  uint16_t records[2]; /*!< Number of records ending in each buffer */
+  bool full[2]; /*!< Set when a buffer is waiting to be written */
+  uint8_t active; /*!< Index of the buffer currently being filled */
+  bool write_error; /*!< Set if a write to the file failed. It is cleared when the log is opened or closed, so it only refers to the open log */
+
+  // Compression state. Every buffer holds a single compressed block
+  bool compressed; /*!< Set if the records are compressed */
+  bool block_open; /*!< Set if a block has been started in the active buffer */
+  uint16_t block_start; /*!< Offset of the block header in the active buffer */
+  uint16_t block_count; /*!< Number of records in the current block */
+  log_codec_state_t codec; /*!< Predictor state of the current block */
+
+  uint32_t written; /*!< Number of records written to the file */
+  uint32_t dropped; /*!< Number of records dropped since the last dropped marker */
+  uint32_t total_dropped; /*!< Total number of dropped records */
+  uint32_t flush_count; /*!< Number of buffers written to the file */
+  uint32_t max_flush_micros; /*!< Worst case time it took to write a buffer to the file */
+} log_writer_t;
+
+void LogWriter_Open(log_writer_t *log_writer, File file, const log_header_t *header);
+
+void LogWriter_OpenFlash(log_writer_t *log_writer, flash_log_t *flash_log, const log_header_t *header);
+
+bool LogWriter_IsOpen(const log_writer_t *log_writer);
+
+bool LogWriter_HasRoom(const log_writer_t *log_writer);
+
+bool LogWriter_Write(log_writer_t *log_writer, const log_record_t *record);
+
+void LogWriter_Service(log_writer_t *log_writer);
+
+bool LogWriter_NeedsErase(const log_writer_t *log_writer, uint32_t size);
+
+void LogWriter_EraseAhead(log_writer_t *log_writer);
+
+void LogWriter_Close(log_writer_t *log_writer);
+
+#endif // __log_writer_h__
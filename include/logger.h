@@ -0,0 +1,135 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __logger_h__
+#define __logger_h__
+
+#include <stdint.h>
+#include <FS.h>
+
+#include "auto_range.h"
+#include "estimator.h"
+#include "flight_phase.h"
+#include "log_writer.h"
+#include "mpu6500.h"
+#include "ms5611.h"
+#include "record_queue.h"
+#include "stats.h"
+#include "telemetry.h"
+
+// The sampling core: polls the sensors and writes the samples to the log file.
+// It is kept separate from the web server, so it can be run in the native simulator as well
+
+// The time before the launch kept in RAM while armed. This can be set using build flags e.g. -DLOGGER_PRETRIGGER_MS=1000.
+// Every sample takes up 20 bytes in the record queue, so a longer time needs a larger RECORD_QUEUE_SIZE at high sample rates
+#ifndef LOGGER_PRETRIGGER_MS
+#define LOGGER_PRETRIGGER_MS        (500U)
+#endif
+#define LOGGER_PRETRIGGER_SIZE      (RECORD_QUEUE_SIZE - 1U - MPU6500_FIFO_SIZE / MPU6500_FIFO_SAMPLE_SIZE - 16U) // Most records kept while armed. The rest of the queue is left for a burst of samples from the FIFO
+static_assert(RECORD_QUEUE_SIZE > 1U + MPU6500_FIFO_SIZE / MPU6500_FIFO_SAMPLE_SIZE + 16U, "There must be room for a burst of samples from the FIFO while armed");
+static_assert(LOGGER_PRETRIGGER_MS * MPU6500_MAX_SAMPLE_RATE / 1000U <= LOGGER_PRETRIGGER_SIZE, "The record queue can not hold LOGGER_PRETRIGGER_MS of samples at the maximum sample rate, increase RECORD_QUEUE_SIZE");
+
+// The part of a raw flash region erased before the samples are logged, also when armed. The flash is never erased while
+// the samples are kept, so the log is stopped when it reaches the end of this. This can be set using build flags e.g. -DLOGGER_FLASH_ERASE_SIZE=2097152
+#ifndef LOGGER_FLASH_ERASE_SIZE
+#define LOGGER_FLASH_ERASE_SIZE     (1024UL * 1024UL) // About 100 s of compressed samples at 1 kHz. Erasing it takes around 15 s
+#endif
+
+/** Struct for the sensors and the log file */
+typedef struct {
+  mpu6500_t mpu6500;
+  ms5611_t ms5611;
+  log_writer_t log_writer;
+  uint16_t sample_rate; /*!< Sample rate of the IMU in Hz */
+  uint32_t start_timestamp; /*!< Time in us when the log was started */
+  uint32_t stop_timestamp; /*!< Time in us when the log was stopped */
+  uint32_t samples; /*!< Number of samples accepted by the log writer */
+  int32_t ground_pressure_filtered; /*!< Low-pass filtered pressure in 1/16 Pa used as the ground reference when the log is started */
+  uint8_t fs_check_counter; /*!< Number of samples since the file system was checked */
+  bool erasing; /*!< Set while the raw flash region is erased. The samples are logged once it is done */
+
+  // The records are queued here by the sampling path before they are written. While armed only the newest records
+  // are kept, so the samples before the launch are written once it is detected
+  record_queue_t queue;
+  uint32_t queue_dropped; /*!< Number of samples dropped after the newest record, because the queue was full or they were lost by the FIFO */
+  uint32_t dropped; /*!< Number of samples in the dropped markers written to the log */
+  bool armed; /*!< Set while waiting for the launch */
+  uint32_t commit_timestamp; /*!< Time in us of the first sample written to the log */
+
+  flight_phase_t flight_phase;
+  bool adaptive_rate; /*!< Set if the sample rates follow the flight phase */
+  bool phase_pending; /*!< Set when the phase changed, but the sample rates have not been changed yet */
+  uint32_t rate_timestamp; /*!< Time in us when the sample rate was last changed */
+  uint32_t expected_samples; /*!< Number of samples the previous sample rates should have given */
+
+  auto_range_t auto_range;
+  bool auto_ranging; /*!< Set if the ranges of the IMU follow the readings */
+  bool range_pending; /*!< Set when the range should be changed, but it has not been changed yet */
+  mpu6500_range_t range; /*!< Range of the previous sample written to the log */
+
+  uint32_t imu_dropped; /*!< Number of samples lost by the FIFO when the previous sample was read */
+
+  estimator_t estimator;
+  bool log_estimates; /*!< Set if the output of the estimator is written to the log */
+  uint32_t estimate_timestamp; /*!< Time in us since the log was started of the last estimate written to the log */
+
+  telemetry_t *telemetry; /*!< The samples are streamed to this if set */
+} logger_t;
+
+void Logger_Init(logger_t *logger, uint16_t sample_rate, bool use_fifo);
+
+void Logger_SetSampleRate(logger_t *logger, uint16_t sample_rate);
+
+int32_t Logger_GetGroundPressure(const logger_t *logger);
+
+void Logger_Start(logger_t *logger, File file, int32_t ground_pressure, bool compressed);
+
+void Logger_StartFlash(logger_t *logger, flash_log_t *flash_log, int32_t ground_pressure, bool compressed);
+
+void Logger_Stop(logger_t *logger);
+
+bool Logger_IsLogging(const logger_t *logger);
+
+bool Logger_IsErasing(const logger_t *logger);
+
+void Logger_Arm(logger_t *logger);
+
+bool Logger_IsArmed(const logger_t *logger);
+
+void Logger_SetAdaptiveRate(logger_t *logger, bool enabled);
+
+void Logger_SetAutoRange(logger_t *logger, bool enabled);
+
+void Logger_SetLogEstimates(logger_t *logger, bool enabled);
+
+void Logger_SetTelemetry(logger_t *logger, telemetry_t *telemetry);
+
+flight_phase_e Logger_GetPhase(const logger_t *logger);
+
+void Logger_GetSamples(const logger_t *logger, stats_samples_t *samples);
+
+void Logger_UpdateBus(logger_t *logger);
+
+void Logger_UpdateBarometer(logger_t *logger);
+
+void Logger_UpdateImu(logger_t *logger);
+
+void Logger_Service(logger_t *logger);
+
+void Logger_Loop(logger_t *logger);
+
+#endif // __logger_h__
@@ -20,13 +20,95 @@
 
 #include <stdint.h>
 
+#include "i2c_scheduler.h"
+
 #define MPU6500_MAX_SAMPLE_RATE     (1000U) // Maximum frequency supported by this driver
 #define MPU6500_MIN_SAMPLE_RATE     (4U) // Minimum frequency supported by this driver
 
+#define MPU6500_FIFO_SIZE           (512U) // Size of the FIFO in bytes
+#define MPU6500_FIFO_SAMPLE_SIZE    (12U) // Each sample in the FIFO consists of the accelerometer and gyroscope readings
+#define MPU6500_FIFO_BATCH_SAMPLES  (10U) // The FIFO is read when at least this number of samples should be available
+
 #define GRAVITATIONAL_ACCELERATION  (9.80665f) // https://en.wikipedia.org/wiki/Gravitational_acceleration
 #define DEG_TO_RADf                 (0.017453292519943295769236907684886f)
 #define RAD_TO_DEGf                 (57.295779513082320876798154814105f)
 
+typedef enum {
+  MPU6500_GYRO_RANGE_250 = 0, // +-250 deg/s
+  MPU6500_GYRO_RANGE_500 = 1, // +-500 deg/s
+  MPU6500_GYRO_RANGE_1000 = 2, // +-1000 deg/s
+  MPU6500_GYRO_RANGE_2000 = 3, // +-2000 deg/s
+} mpu6500_gyro_range_e;
+
+typedef enum {
+  MPU6500_ACC_RANGE_2 = 0, // +-2 g
+  MPU6500_ACC_RANGE_4 = 1, // +-4 g
+  MPU6500_ACC_RANGE_8 = 2, // +-8 g
+  MPU6500_ACC_RANGE_16 = 3, // +-16 g
+} mpu6500_acc_range_e;
+
+// The settings giving 250 Hz and 3600 Hz are not supported, as the internal sample rate is then 8 kHz
+typedef enum {
+  MPU6500_GYRO_DLPF_184 = 1, // 184 Hz bandwidth, 2.9 ms delay
+  MPU6500_GYRO_DLPF_92 = 2, // 92 Hz bandwidth, 3.9 ms delay
+  MPU6500_GYRO_DLPF_41 = 3, // 41 Hz bandwidth, 5.9 ms delay
+  MPU6500_GYRO_DLPF_20 = 4, // 20 Hz bandwidth, 9.9 ms delay
+  MPU6500_GYRO_DLPF_10 = 5, // 10 Hz bandwidth, 17.85 ms delay
+  MPU6500_GYRO_DLPF_5 = 6, // 5 Hz bandwidth, 33.48 ms delay
+} mpu6500_gyro_dlpf_e;
+
+typedef enum {
+  MPU6500_ACC_DLPF_218 = 0, // 218.1 Hz bandwidth, 1.88 ms delay
+  MPU6500_ACC_DLPF_99 = 2, // 99 Hz bandwidth, 2.88 ms delay
+  MPU6500_ACC_DLPF_45 = 3, // 44.8 Hz bandwidth, 4.88 ms delay
+  MPU6500_ACC_DLPF_21 = 4, // 21.2 Hz bandwidth, 8.87 ms delay
+  MPU6500_ACC_DLPF_10 = 5, // 10.2 Hz bandwidth, 16.83 ms delay
+  MPU6500_ACC_DLPF_5 = 6, // 5.05 Hz bandwidth, 32.48 ms delay
+} mpu6500_acc_dlpf_e;
+
+// The configuration written by MPU6500_Init(). These can be set using build flags e.g. -DMPU6500_GYRO_RANGE=MPU6500_GYRO_RANGE_2000.
+// The ranges are only the initial ranges if the range is changed using MPU6500_SetRange()
+#ifndef MPU6500_GYRO_RANGE
+#define MPU6500_GYRO_RANGE          MPU6500_GYRO_RANGE_250
+#endif
+#ifndef MPU6500_ACC_RANGE
+#define MPU6500_ACC_RANGE           MPU6500_ACC_RANGE_16
+#endif
+#ifndef MPU6500_GYRO_DLPF
+#define MPU6500_GYRO_DLPF           MPU6500_GYRO_DLPF_184
+#endif
+#ifndef MPU6500_ACC_DLPF
+#define MPU6500_ACC_DLPF            MPU6500_ACC_DLPF_218
+#endif
+
+// Gyroscope scale factor from the datasheet in LSB/(deg/s)
+static constexpr float MPU6500_GetGyroScaleFactor(uint8_t range) {
+  return range == MPU6500_GYRO_RANGE_250 ? 131.0f : range == MPU6500_GYRO_RANGE_500 ? 65.5f : range == MPU6500_GYRO_RANGE_1000 ? 32.8f : 16.4f;
+}
+
+// Accelerometer scale factor from the datasheet in LSB/g
+static constexpr float MPU6500_GetAccScaleFactor(uint8_t range) {
+  return 16384.0f / (1U << range);
+}
+
+// The inverse of the scale factors in rad/s and m/s^2 per LSB, so a reading is converted using a single multiplication
+static constexpr float MPU6500_GetGyroResolution(uint8_t range) {
+  return DEG_TO_RADf / MPU6500_GetGyroScaleFactor(range);
+}
+
+static constexpr float MPU6500_GetAccResolution(uint8_t range) {
+  return GRAVITATIONAL_ACCELERATION / MPU6500_GetAccScaleFactor(range);
+}
+
+// Full scale in deg/s and g
+static constexpr uint16_t MPU6500_GetGyroFullScale(uint8_t range) {
+  return 250U << range;
+}
+
+static constexpr uint16_t MPU6500_GetAccFullScale(uint8_t range) {
+  return 2U << range;
+}
+
 typedef union {
   struct {
     int16_t X, Y, Z;
@@ -48,20 +130,71 @@ typedef union {
   float data[3];
 } angle_t;
 
+/** Full-scale ranges of the gyroscope and accelerometer */
+typedef struct {
+  uint8_t gyro; /*!< See mpu6500_gyro_range_e */
+  uint8_t acc; /*!< See mpu6500_acc_range_e */
+} mpu6500_range_t;
+
+static inline bool MPU6500_RangeEquals(const mpu6500_range_t *a, const mpu6500_range_t *b) {
+  return a->gyro == b->gyro && a->acc == b->acc;
+}
+
 /** Struct for MPU-6500 data */
 typedef struct {
-  float gyroScaleFactor; /*!< Gyroscope scale factor */
-  float accScaleFactor; /*!< Accelerometer scale factor */
+  float gyroScaleFactor; /*!< Gyroscope scale factor of the readings */
+  float accScaleFactor; /*!< Accelerometer scale factor of the readings */
+  float gyroResolution; /*!< Inverse of the gyroscope scale factor in rad/s */
+  float accResolution; /*!< Inverse of the accelerometer scale factor in m/s^2 */
+  mpu6500_range_t range; /*!< Range of the readings */
+  mpu6500_range_t config_range; /*!< Range the sensor is set to. The samples in the FIFO might still use the previous range */
+  sensorRaw_t gyroRaw; /*!< Raw gyroscope readings */
+  sensorRaw_t accRaw; /*!< Raw accelerometer readings */
   angle_t gyroRate; /*!< Gyroscope readings in rad/s */
   sensor_t accSi; /*!< Accelerometer readings in m/s^2 */
+  uint32_t timestamp; /*!< Time in us when the readings were sampled */
+  uint32_t sample_period_micros; /*!< Time between samples given by the sample rate divider */
+
+  // FIFO state
+  bool fifo_enabled;
+  uint32_t fifo_dropped; /*!< Number of samples lost due to FIFO overflows. It is increased right before the first sample taken after the lost ones is returned */
+  uint32_t fifo_lost; /*!< Number of samples lost after the samples in the buffer. They are added to fifo_dropped once the buffer has been returned */
+  uint32_t fifo_timestamp; /*!< Time in us of the newest sample read from the FIFO */
+  uint32_t fifo_poll_timestamp; /*!< Time in us when the FIFO count was last read */
+  uint32_t fifo_buf_timestamp; /*!< Time in us of the first sample in the buffer */
+  uint32_t fifo_buf_period; /*!< Time in us between the samples in the buffer */
+  uint16_t fifo_buf_len, fifo_buf_index; /*!< Number of bytes in the buffer and the index of the next sample */
+  mpu6500_range_t fifo_buf_range; /*!< Range of the samples in the buffer */
+  i2c_job_t fifo_job; /*!< Reads the FIFO count and then the samples through the I2C scheduler */
+  uint8_t fifo_count_buf[2]; /*!< FIFO count read by the job */
+  uint16_t fifo_read_len, fifo_read_index; /*!< Number of bytes being read from the FIFO and the number read so far */
+  bool fifo_read_overflow; /*!< Set if the FIFO was full when the count was read */
+  uint8_t fifo_buf[MPU6500_FIFO_SIZE]; /*!< Samples read from the FIFO, but not yet returned */
 } mpu6500_t;
 
-void MPU6500_Init(mpu6500_t *mpu6500, uint16_t sample_rate);
+void MPU6500_Init(mpu6500_t *mpu6500, uint16_t sample_rate, bool use_fifo = false);
 
-void MPU6500_SetSampleRate(uint16_t sample_rate);
+uint8_t MPU6500_SetSampleRate(mpu6500_t *mpu6500, uint16_t sample_rate);
+
+uint8_t MPU6500_SetRange(mpu6500_t *mpu6500, const mpu6500_range_t *range);
+
+bool MPU6500_HasBufferedData(const mpu6500_t *mpu6500);
 
 uint8_t MPU6500_DateReady(bool *ready);
 
 uint8_t MPU6500_GetData(mpu6500_t *mpu6500);
 
+uint8_t MPU6500_FifoRead(mpu6500_t *mpu6500);
+
+uint8_t MPU6500_FifoGetData(mpu6500_t *mpu6500, bool *ready);
+
+// Converts the raw accelerometer and gyroscope readings into SI units
+static inline void MPU6500_ConvertData(mpu6500_t *mpu6500) {
+  const float acc_resolution = mpu6500->accResolution, gyro_resolution = mpu6500->gyroResolution;
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    mpu6500->accSi.data[axis] = (float)mpu6500->accRaw.data[axis] * acc_resolution; // Convert to m/s^2
+    mpu6500->gyroRate.data[axis] = (float)mpu6500->gyroRaw.data[axis] * gyro_resolution; // Convert to rad/s
+  }
+}
+
 #endif // __mpu6500_h__
@@ -18,6 +18,10 @@
 #ifndef __ms5611_h__
 #define __ms5611_h__
 
+#include <stdint.h>
+
+#include "i2c_scheduler.h"
+
 typedef enum {
   MS5611_OSR_4096 = 0x08,
   MS5611_OSR_2048 = 0x06,
@@ -26,23 +30,88 @@ typedef enum {
   MS5611_OSR_256  = 0x00
 } ms5611_osr_mask_e;
 
+typedef enum {
+  MS5611_STATE_IDLE = 0,
+  MS5611_STATE_CONV_D1, // Pressure conversion in progress
+  MS5611_STATE_CONV_D2, // Temperature conversion in progress
+} ms5611_state_e;
+
 /** Struct for MS5611 data */
 typedef struct {
 // public
   int32_t pressure; // Pressure in pascal
-  float altitude; // Altitude in meters
   float temperature; // Temperature in celcius
 
 // private
   ms5611_osr_mask_e osr_mask;
   uint32_t osr_delay_micros;
   uint16_t prom_c[6];
+  ms5611_state_e state; // Conversion currently running
+  uint32_t conversion_timestamp; // Time in us when the current conversion was started
+  uint32_t conversion_delay_micros; // Time in us the current conversion takes
+  uint8_t temperature_interval; // Temperature is converted once every n pressure conversions
+  uint8_t temperature_counter; // Number of pressure conversions since the last temperature conversion
+  int32_t TEMP; // Compensated temperature from the last temperature conversion with 0.01 C resolution
+  int64_t OFF, SENS; // Cached offset and sensitivity at the last measured temperature
+  i2c_job_t job; // Starts a conversion or reads the result through the I2C scheduler
+  uint8_t adc_buf[3]; // Result of the conversion read by the job
 } ms5611_t;
 
-void MS5611_Init(ms5611_t *ms5611, ms5611_osr_mask_e ms5611_osr_mask);
+static inline int64_t MS5611_Square(int64_t x) {
+  return x * x;
+}
+
+// Calculates the temperature and the offset and sensitivity used for the pressure compensation.
+// This is kept in the header, so the 64-bit math can be benchmarked on a computer, see src/bench/bench_kernels.h
+static inline void MS5611_CalculateTemperature(ms5611_t *ms5611, uint32_t D2) {
+  // Difference between actual and reference temperature
+  int32_t dT = D2 - (uint32_t)ms5611->prom_c[4] * 256;
+
+  // Actual temperature (-40 ... 85 C with 0.01 C resolution)
+  int32_t TEMP = 2000L + ((int64_t)dT * (int64_t)ms5611->prom_c[5]) / 8388608UL;
+
+  // Offset at actual temperature
+  int64_t OFF = (int64_t)ms5611->prom_c[1] * 65536 + ((int64_t)ms5611->prom_c[3] * dT) / 128;
+
+  // Sensitivity at actual temperature
+  int64_t SENS = (int64_t)ms5611->prom_c[0] * 32768 + ((int64_t)ms5611->prom_c[2] * dT) / 256;
+
+  // Check if the temperature is below 20 C
+  int32_t T2 = 0;
+  int64_t OFF2 = 0, SENS2 = 0;
+  if (TEMP < 2000) {
+    T2 = MS5611_Square(dT) / 2147483648UL;
+    OFF2 = 5 * MS5611_Square(TEMP - 2000) / 2;
+    SENS2 = 5 * MS5611_Square(TEMP - 2000) / 4;
+
+    // Check if the temperature is below -15 C
+    if (TEMP < -1500) {
+      OFF2 = OFF2 + 7 * MS5611_Square(TEMP + 1500);
+      SENS2 = SENS2 + 11 * MS5611_Square(TEMP + 1500) / 2;
+    }
+  }
+
+  // Second order temperature compensation
+  ms5611->TEMP = TEMP - T2;
+  ms5611->OFF = OFF - OFF2;
+  ms5611->SENS = SENS - SENS2;
+
+  // Convert temperature to celsius
+  ms5611->temperature = (float)ms5611->TEMP / 100.0f;
+}
+
+// Calculates the pressure using the compensation values from the last temperature conversion
+static inline void MS5611_CalculatePressure(ms5611_t *ms5611, uint32_t D1) {
+  // Temperature compensated pressure (10 ... 1200 mbar with 0.01 mbar resolution i.e. pascal)
+  ms5611->pressure = (D1 * ms5611->SENS / 2097152UL - ms5611->OFF) / 32768;
+}
+
+void MS5611_Init(ms5611_t *ms5611, ms5611_osr_mask_e ms5611_osr_mask, uint8_t temperature_interval = 1);
+
+void MS5611_SetOsr(ms5611_t *ms5611, ms5611_osr_mask_e ms5611_osr_mask);
 
 uint8_t MS5611_GetData(ms5611_t *ms5611);
 
-float MS5611_GetAbsoluteAltitude(int32_t pressure);
+uint8_t MS5611_Update(ms5611_t *ms5611, bool *ready);
 
 #endif // __ms5611_h__
@@ -0,0 +1,52 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __radio_quiet_h__
+#define __radio_quiet_h__
+
+#include <stdint.h>
+
+#include "logger.h"
+
+// Decides when the radio is turned off during a flight. The hotspot, the DNS server and the web server take CPU time
+// between the samples, so they are stopped once the samples are being logged and started again after the landing.
+// When the logger is armed the radio stays on until the launch, so the logger can still be checked on the launch pad
+
+#define RADIO_QUIET_GRACE_MILLIS    (2000UL) // Time from the start of the log until the radio is turned off, so the response to the start request is sent
+#define RADIO_QUIET_TIMEOUT_MILLIS  (600000UL) // The radio is turned on again after 10 minutes even if the landing was not detected
+
+typedef enum {
+  RADIO_QUIET_NONE = 0,
+  RADIO_QUIET_TURN_OFF, // Stop the hotspot, the DNS server and the web server
+  RADIO_QUIET_TURN_ON, // Start them again
+} radio_quiet_action_e;
+
+/** Struct for the radio-quiet mode */
+typedef struct {
+  bool enabled; /*!< Set if the radio is turned off during a flight */
+  bool quiet; /*!< Set while the radio is off */
+  bool logging; /*!< Set once the start of the current log has been seen */
+  bool done; /*!< Set when the radio was turned on again, so it stays on until the log is stopped */
+  uint32_t start_millis; /*!< Time in ms when the log was started */
+  uint32_t off_millis; /*!< Time in ms when the radio was turned off */
+} radio_quiet_t;
+
+void RadioQuiet_Init(radio_quiet_t *radio_quiet, bool enabled);
+
+radio_quiet_action_e RadioQuiet_Update(radio_quiet_t *radio_quiet, const logger_t *logger, uint32_t now_millis);
+
+#endif // __radio_quiet_h__
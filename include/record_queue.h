@@ -0,0 +1,58 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __record_queue_h__
+#define __record_queue_h__
+
+#include <stdint.h>
+
+#include "log_format.h"
+
+// Single producer single consumer queue of records between the sampling path and the log writer. Both currently run in
+// loop(): the records are pushed by Logger_UpdateImu() and popped by Logger_Service(). The producer only writes the tail
+// and the consumer only writes the head, so the sampling path could be moved to another context without adding locks
+
+#ifndef RECORD_QUEUE_SIZE
+#define RECORD_QUEUE_SIZE           (576U) // One slot is always left empty, so 575 records fit. This can be set using build flags e.g. -DRECORD_QUEUE_SIZE=1088
+#endif
+
+/** Struct for the record queue */
+typedef struct {
+  log_record_t records[RECORD_QUEUE_SIZE];
+  volatile uint16_t head; /*!< Index of the oldest record. Only written by the consumer */
+  volatile uint16_t tail; /*!< Index where the next record is added. Only written by the producer */
+} record_queue_t;
+
+void RecordQueue_Init(record_queue_t *queue);
+
+static inline uint16_t RecordQueue_GetCount(const record_queue_t *queue) {
+  return (uint16_t)((queue->tail + RECORD_QUEUE_SIZE - queue->head) % RECORD_QUEUE_SIZE);
+}
+
+static inline uint16_t RecordQueue_GetFree(const record_queue_t *queue) {
+  return RECORD_QUEUE_SIZE - 1 - RecordQueue_GetCount(queue);
+}
+
+bool RecordQueue_Push(record_queue_t *queue, const log_record_t *record);
+
+const log_record_t *RecordQueue_GetNewest(const record_queue_t *queue);
+
+const log_record_t *RecordQueue_Peek(const record_queue_t *queue);
+
+void RecordQueue_Pop(record_queue_t *queue);
+
+#endif // __record_queue_h__
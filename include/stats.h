@@ -0,0 +1,120 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __stats_h__
+#define __stats_h__
+
+#include <Arduino.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Lightweight performance counters. The durations are measured using the CPU cycle counter and sorted into
+// power of two buckets, so recording a value only costs a few instructions and no division
+
+#define STATS_HISTOGRAM_BUCKETS     (16U)
+#define STATS_HISTOGRAM_SHIFT       (7U) // The first bucket holds durations below 2^7 cycles i.e. 1.6 us at 80 MHz
+#define STATS_JSON_SIZE             (1536U) // Room needed by Stats_FormatJson
+
+/** Histogram of durations measured in CPU cycles */
+typedef struct {
+  uint32_t count; /*!< Number of recorded durations */
+  uint32_t max; /*!< Worst case duration in cycles */
+  uint64_t sum; /*!< Sum of all durations in cycles */
+  uint32_t buckets[STATS_HISTOGRAM_BUCKETS]; /*!< Bucket i holds durations below 2^(i + STATS_HISTOGRAM_SHIFT) cycles. The last one holds the rest */
+} stats_histogram_t;
+
+/** Counters for the hot path */
+typedef struct {
+  stats_histogram_t loop; /*!< Time between two iterations of the main loop */
+  stats_histogram_t i2c; /*!< Duration of the I2C transactions */
+  stats_histogram_t flash; /*!< Time it took to write a buffer to the file */
+  stats_histogram_t estimator; /*!< Time it took to update the estimator with an IMU sample */
+  stats_histogram_t latency; /*!< Time from when an IMU sample was taken until it was read. For the FIFO this is the time the oldest unread sample has waited */
+  uint32_t i2c_errors; /*!< Number of failed I2C transactions */
+  uint32_t i2c_retries; /*!< Number of I2C transactions done again by the scheduler after failing */
+  uint32_t i2c_deferred; /*!< Number of low priority I2C transactions held back for a high priority one */
+  uint32_t i2c_missed_deadlines; /*!< Number of reads of the IMU done after their deadline i.e. when the FIFO might have overflowed */
+  uint32_t reset_millis; /*!< Time in ms when the counters were reset */
+  uint32_t loop_timestamp; /*!< Cycle count at the start of the current loop iteration */
+  uint32_t min_free_heap; /*!< Lowest free heap seen in bytes */
+  uint16_t queue_high_water; /*!< Most records waiting in the queue between the sampling path and the log writer */
+  uint16_t fifo_high_water; /*!< Most samples read from the MPU-6500 FIFO at once */
+} stats_t;
+
+/** Number of samples the logger has written compared to what the sample rate should give */
+typedef struct {
+  uint32_t expected; /*!< Sample rate multiplied by the time the log has been running */
+  uint32_t logged; /*!< Samples accepted by the log writer */
+  uint32_t dropped; /*!< Samples lost by the FIFO or dropped because the queue or the buffers were full or a write failed */
+} stats_samples_t;
+
+extern stats_t stats;
+
+static inline uint32_t Stats_Timestamp() {
+  return ESP.getCycleCount();
+}
+
+static inline void Stats_Add(stats_histogram_t *histogram, uint32_t cycles) {
+  uint32_t scaled = cycles >> STATS_HISTOGRAM_SHIFT;
+  uint32_t bucket = scaled ? 32 - __builtin_clz(scaled) : 0;
+  if (bucket >= STATS_HISTOGRAM_BUCKETS)
+    bucket = STATS_HISTOGRAM_BUCKETS - 1;
+  histogram->buckets[bucket]++;
+  histogram->count++;
+  histogram->sum += cycles;
+  if (cycles > histogram->max)
+    histogram->max = cycles;
+}
+
+// Adds the number of cycles since "start" to the histogram
+static inline void Stats_Record(stats_histogram_t *histogram, uint32_t start) {
+  Stats_Add(histogram, Stats_Timestamp() - start);
+}
+
+// Adds a duration in us, which was not measured using the cycle counter
+static inline void Stats_RecordMicros(stats_histogram_t *histogram, uint32_t micros) {
+  Stats_Add(histogram, micros * ESP.getCpuFreqMHz());
+}
+
+static inline void Stats_HighWater(uint16_t *high_water, uint16_t value) {
+  if (value > *high_water)
+    *high_water = value;
+}
+
+// Records the result and duration of an I2C transaction started at "start"
+static inline uint8_t Stats_I2C(uint8_t rcode, uint32_t start) {
+  Stats_Record(&stats.i2c, start);
+  if (rcode != 0)
+    stats.i2c_errors++;
+  return rcode;
+}
+
+void Stats_Reset();
+
+void Stats_Loop();
+
+uint32_t Stats_GetMeanMicros(const stats_histogram_t *histogram);
+
+uint32_t Stats_GetMaxMicros(const stats_histogram_t *histogram);
+
+uint32_t Stats_GetI2CUtilisation();
+
+uint32_t Stats_GetI2CRate();
+
+size_t Stats_FormatJson(char *buffer, size_t size, const stats_samples_t *samples);
+
+#endif // __stats_h__
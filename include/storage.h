@@ -0,0 +1,58 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __storage_h__
+#define __storage_h__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <FS.h>
+
+// All access to the file system goes through these functions, so the backend can be selected at build time using
+// -DSTORAGE_BACKEND=STORAGE_LITTLEFS. Note that the two backends do not use the same format, so the file system
+// is formatted the first time the other backend is used
+
+#define STORAGE_SPIFFS              0
+#define STORAGE_LITTLEFS            1
+
+#ifndef STORAGE_BACKEND
+#define STORAGE_BACKEND             STORAGE_SPIFFS
+#endif
+
+bool Storage_Begin();
+
+bool Storage_Format();
+
+File Storage_Open(const char *path, const char *mode);
+
+bool Storage_Exists(const char *path);
+
+bool Storage_Remove(const char *path);
+
+bool Storage_Rename(const char *from, const char *to);
+
+size_t Storage_GetSize();
+
+size_t Storage_GetFree();
+
+bool Storage_IsFull();
+
+fs::FS &Storage_GetFS();
+
+const char *Storage_GetName();
+
+#endif // __storage_h__
@@ -0,0 +1,89 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __telemetry_h__
+#define __telemetry_h__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "log_format.h"
+#include "mpu6500.h"
+
+// Live stream of the samples. The sampling path decimates the samples to the rate requested by the client and
+// batches them into frames in a small ring. The web server sends the frames from the main loop. The ring is
+// single producer single consumer, so the sampling path never waits for the network. If the client is too slow
+// to keep up, then the newest frame is dropped instead of queuing more frames, and the next frame says how many
+// samples were lost
+
+#define TELEMETRY_VERSION           (1U)
+#define TELEMETRY_FRAME_RECORDS     (24U) // Samples per frame i.e. 500 bytes, so a frame fits in a single TCP segment
+#define TELEMETRY_FRAMES            (4U) // Frames in the ring. One is being filled, so up to three are waiting to be sent
+#define TELEMETRY_MAX_LATENCY       (100000UL) // A frame is sent after at most 100 ms, even if it is not full
+#define TELEMETRY_MAX_RATE          (MPU6500_MAX_SAMPLE_RATE)
+
+/** Header at the start of every frame. It is followed by "count" records with the samples */
+typedef struct {
+  uint8_t version; /*!< Set to TELEMETRY_VERSION */
+  uint8_t count; /*!< Number of records in the frame */
+  uint16_t sequence; /*!< Incremented for every frame */
+  uint32_t dropped; /*!< Number of samples dropped before this frame, because the client was too slow */
+  float gyroScaleFactor; /*!< Gyroscope scale factor in LSB/(deg/s) */
+  float accScaleFactor; /*!< Accelerometer scale factor in LSB/g */
+  int32_t ground_pressure; /*!< Pressure in pascal at the ground */
+} __attribute__((packed)) telemetry_header_t;
+static_assert(sizeof(telemetry_header_t) == 20, "The header is decoded by the live page");
+
+/** A frame as it is sent to the client. The timestamps of the records are the time in us since boot */
+typedef struct {
+  telemetry_header_t header;
+  log_record_t records[TELEMETRY_FRAME_RECORDS];
+} __attribute__((packed)) telemetry_frame_t;
+
+/** Struct for the telemetry ring */
+typedef struct {
+  telemetry_frame_t frames[TELEMETRY_FRAMES];
+  volatile uint8_t head; /*!< Frame being filled. Only written by the sampling path */
+  volatile uint8_t tail; /*!< Oldest frame waiting to be sent. Only written by the web server */
+  volatile uint32_t interval; /*!< Time in us between two streamed samples. Zero when disabled */
+  uint32_t next_timestamp; /*!< Time in us when the next sample is due */
+  uint32_t frame_timestamp; /*!< Time in us of the first sample in the frame being filled */
+  uint32_t dropped; /*!< Samples dropped since the last frame was published */
+  uint16_t sequence; /*!< Sequence number of the next frame */
+  float gyroScaleFactor, accScaleFactor; /*!< Copied into the header of every frame */
+  int32_t ground_pressure;
+  uint32_t samples; /*!< Total number of samples added after the decimation */
+  uint32_t total_dropped; /*!< Total number of samples dropped */
+} telemetry_t;
+
+void Telemetry_Init(telemetry_t *telemetry);
+
+void Telemetry_SetRate(telemetry_t *telemetry, uint16_t rate);
+
+void Telemetry_SetScale(telemetry_t *telemetry, float gyroScaleFactor, float accScaleFactor, int32_t ground_pressure);
+
+static inline bool Telemetry_IsEnabled(const telemetry_t *telemetry) {
+  return telemetry->interval != 0;
+}
+
+void Telemetry_Add(telemetry_t *telemetry, uint32_t timestamp, int32_t pressure, const sensorRaw_t *gyro, const sensorRaw_t *acc);
+
+const telemetry_frame_t *Telemetry_Peek(const telemetry_t *telemetry, size_t *length);
+
+void Telemetry_Pop(telemetry_t *telemetry);
+
+#endif // __telemetry_h__
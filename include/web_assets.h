@@ -0,0 +1,464 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Generated from the web directory by tools/web_assets.py. Do not edit
+
+#ifndef __web_assets_h__
+#define __web_assets_h__
+
+#include <Arduino.h>
+
+/** A gzip compressed file stored in the flash */
+typedef struct {
+  const char *url; /*!< The file is served at this URL */
+  const char *type; /*!< Content type */
+  const uint8_t *data; /*!< Compressed content */
+  uint32_t length; /*!< Length of the compressed content in bytes */
+  const char *etag; /*!< Hash of the content, so a cached copy is only sent again when the firmware changes it */
+} web_asset_t;
+
+// index.html: 3098 bytes, 1351 bytes compressed
+static const uint8_t web_index_html[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xB5, 0x57, 0x4B, 0x6F, 0xDB, 0x38,
+  0x10, 0xBE, 0xE7, 0x57, 0x4C, 0x75, 0x91, 0x8C, 0xDA, 0x72, 0x5A, 0xEC, 0xA9, 0xB1, 0x5D, 0xF4,
+  0x91, 0x6D, 0xB7, 0x48, 0xDB, 0xA0, 0x09, 0xB0, 0xBB, 0x40, 0x81, 0x80, 0x96, 0xC6, 0x16, 0x11,
+  0x4A, 0xD4, 0x92, 0x94, 0x1D, 0x77, 0x91, 0xFF, 0xBE, 0x33, 0x24, 0x25, 0xDB, 0x69, 0xD2, 0xDB,
+  0x06, 0x48, 0x44, 0x72, 0x1E, 0x9C, 0xF9, 0xE6, 0xC1, 0xC9, 0xEC, 0xD9, 0xFB, 0xAF, 0xEF, 0xAE,
+  0xFF, 0xBE, 0x3C, 0x87, 0xCA, 0xD5, 0x6A, 0x71, 0x32, 0x7B, 0x36, 0x99, 0xC0, 0x95, 0x13, 0xC6,
+  0x41, 0x2B, 0xD6, 0x98, 0xC3, 0x75, 0x85, 0x7E, 0x05, 0xD2, 0x82, 0x75, 0xC2, 0xC9, 0x62, 0x0C,
+  0x56, 0x83, 0x74, 0x7C, 0x50, 0x88, 0xA2, 0xC2, 0x12, 0x96, 0x3B, 0x70, 0xC4, 0xB6, 0x34, 0x7A,
+  0x6B, 0xD1, 0x04, 0x19, 0xE6, 0x45, 0xD0, 0x2B, 0x4F, 0x51, 0x7A, 0xBD, 0x46, 0xC3, 0x12, 0x06,
+  0x45, 0x09, 0x2B, 0xA3, 0x6B, 0x98, 0x32, 0x47, 0x67, 0x4F, 0x80, 0x7F, 0x44, 0x53, 0x7A, 0xC6,
+  0x95, 0x92, 0xEB, 0xCA, 0xD9, 0xC8, 0x41, 0x62, 0x16, 0x26, 0x13, 0xB2, 0xCA, 0x1B, 0x37, 0xAB,
+  0x48, 0x78, 0x31, 0xAB, 0xD1, 0x09, 0x68, 0x44, 0x8D, 0xF3, 0x64, 0x23, 0x71, 0xDB, 0x6A, 0xE3,
+  0x12, 0x28, 0x74, 0xE3, 0xB0, 0x71, 0xF3, 0x64, 0x2B, 0x4B, 0x57, 0xCD, 0x4B, 0xDC, 0xC8, 0x02,
+  0x27, 0x7E, 0x33, 0x96, 0x8D, 0x74, 0x52, 0xA8, 0x89, 0x2D, 0x84, 0xC2, 0xF9, 0x8B, 0xFC, 0x74,
+  0x5C, 0xD3, 0x51, 0xDD, 0xD5, 0x87, 0x27, 0xE2, 0xEE, 0xC1, 0x49, 0x47, 0xAE, 0xF8, 0xAD, 0x58,
+  0xD2, 0x49, 0xA3, 0xC7, 0xFD, 0x65, 0x93, 0x95, 0x74, 0xF3, 0x42, 0x6F, 0xD0, 0x24, 0x64, 0x99,
+  0x93, 0x4E, 0xE1, 0xE2, 0x9B, 0x2E, 0x6E, 0xD1, 0x5D, 0x78, 0x37, 0x67, 0xD3, 0x70, 0x36, 0x53,
+  0xB2, 0xB9, 0x25, 0x87, 0xD5, 0x3C, 0xB1, 0x6E, 0xA7, 0xD0, 0x56, 0x88, 0x64, 0x69, 0x65, 0x70,
+  0x35, 0x4F, 0xA6, 0xFE, 0x28, 0x2F, 0xAC, 0x4D, 0x16, 0xB3, 0xA9, 0x77, 0xEC, 0x64, 0xB6, 0xD4,
+  0xE5, 0x8E, 0x3E, 0xA5, 0xDC, 0x80, 0x2C, 0x59, 0x8A, 0x01, 0x4A, 0x16, 0x17, 0x5A, 0x94, 0xB2,
+  0x59, 0xCF, 0xA6, 0x44, 0x20, 0xF2, 0x4A, 0x9B, 0xDA, 0xD3, 0x79, 0x91, 0x00, 0xC1, 0x51, 0x69,
+  0xDA, 0x5D, 0x7E, 0xBD, 0xBA, 0x26, 0xED, 0xB2, 0x2C, 0xB1, 0x39, 0x54, 0x82, 0xCE, 0x91, 0x30,
+  0x5F, 0x23, 0x9B, 0xB6, 0x73, 0xE0, 0x76, 0x2D, 0x21, 0xD7, 0x74, 0xF5, 0x92, 0x1C, 0x88, 0x38,
+  0x5A, 0x51, 0xB7, 0x0A, 0x6F, 0x0C, 0x85, 0x2C, 0x81, 0x56, 0x89, 0x02, 0x2B, 0xAD, 0x4A, 0x34,
+  0xF3, 0xE4, 0xCA, 0x53, 0xC0, 0x53, 0xC8, 0xD0, 0xA5, 0x21, 0xD5, 0x4F, 0xEB, 0x59, 0x1B, 0xDD,
+  0x35, 0xE5, 0x4D, 0x6B, 0xD0, 0xDA, 0xCE, 0x3C, 0xD4, 0xF5, 0xC1, 0x53, 0xA1, 0xA7, 0x42, 0x76,
+  0x29, 0x46, 0x83, 0x52, 0x82, 0x19, 0xD5, 0xB1, 0x8D, 0x94, 0x5B, 0xC5, 0xED, 0x52, 0xDF, 0xF5,
+  0xDA, 0x05, 0xB9, 0xBB, 0x80, 0x3F, 0x05, 0xE5, 0x1E, 0xB9, 0x0E, 0x4A, 0x74, 0x4D, 0x51, 0xCD,
+  0xA6, 0x51, 0x92, 0xD5, 0x1C, 0x89, 0x07, 0x28, 0x7A, 0x61, 0x27, 0x6B, 0xEF, 0x41, 0xC0, 0xF0,
+  0x90, 0xCF, 0x76, 0xCB, 0x5A, 0x52, 0x60, 0x3C, 0x5A, 0x61, 0x4D, 0x7C, 0x0C, 0x2E, 0x31, 0x8A,
+  0x3E, 0x5E, 0x4A, 0x6E, 0x48, 0xFE, 0x82, 0xFE, 0x02, 0x27, 0xC2, 0x6C, 0x2A, 0x0E, 0x40, 0x8E,
+  0x69, 0xBB, 0xD7, 0x6F, 0x0B, 0x23, 0x5B, 0xB7, 0x38, 0x59, 0x91, 0x89, 0x4E, 0xEA, 0x06, 0x50,
+  0x61, 0x4D, 0xF9, 0x99, 0x39, 0xB1, 0x1E, 0x83, 0xC3, 0x3B, 0x37, 0xF6, 0x8A, 0x47, 0xF0, 0x2F,
+  0x15, 0xC0, 0x46, 0x18, 0x40, 0x98, 0x43, 0xA9, 0x8B, 0x8E, 0xB9, 0xF2, 0x82, 0xCA, 0xC4, 0xE1,
+  0xF9, 0x5E, 0x66, 0x74, 0x46, 0x6C, 0x98, 0xB3, 0xE0, 0xBB, 0x90, 0xE9, 0xC4, 0xCE, 0x3B, 0x3E,
+  0x97, 0x2B, 0xC8, 0x82, 0x32, 0xCC, 0xF9, 0x4B, 0x24, 0xFE, 0x30, 0xC9, 0xA0, 0xEB, 0x0C, 0xDD,
+  0x7E, 0x76, 0x72, 0x7F, 0x32, 0x9D, 0xC2, 0x9B, 0xB2, 0xB4, 0xA1, 0x20, 0x29, 0x35, 0x69, 0xA5,
+  0x41, 0xC4, 0x92, 0xCB, 0x21, 0xF9, 0xA7, 0x43, 0xB3, 0x4B, 0xC0, 0x92, 0xA9, 0x85, 0xB3, 0x07,
+  0xE5, 0x38, 0x8E, 0xD5, 0x8E, 0x75, 0xEB, 0x76, 0x1E, 0x7A, 0xA6, 0x35, 0xB8, 0x45, 0xEB, 0x40,
+  0x37, 0xB8, 0xF7, 0x52, 0x94, 0xE5, 0xEF, 0x5E, 0x24, 0x0B, 0x2E, 0x7A, 0x95, 0x7B, 0x1F, 0x19,
+  0xAE, 0xF9, 0x00, 0x45, 0x4A, 0xDB, 0x34, 0x80, 0x31, 0x1A, 0x0F, 0x95, 0x7F, 0x80, 0xC2, 0x1A,
+  0x5D, 0x84, 0xE0, 0xED, 0xEE, 0x8F, 0x32, 0x4B, 0x23, 0x4B, 0xEA, 0xC1, 0x20, 0xE1, 0xBC, 0x50,
+  0xC2, 0xDA, 0x2F, 0x14, 0x5E, 0x92, 0x8A, 0xD4, 0xB4, 0xA7, 0x89, 0xB6, 0xC5, 0xA6, 0x7C, 0x57,
+  0x49, 0x55, 0x66, 0xC3, 0x8D, 0x82, 0xEE, 0x4B, 0x39, 0x7C, 0xFC, 0x9D, 0xFA, 0x05, 0x3C, 0x8F,
+  0x56, 0x8E, 0x1E, 0x93, 0x7C, 0x10, 0x91, 0x6B, 0xB2, 0xF5, 0x8B, 0x2E, 0x31, 0x4B, 0x21, 0x7D,
+  0x5C, 0xE0, 0xF8, 0x2A, 0x6A, 0x60, 0xB9, 0xBB, 0x73, 0xFE, 0xB6, 0x7E, 0xBD, 0xBF, 0x30, 0xA7,
+  0x36, 0x4B, 0x3E, 0xB2, 0xF1, 0x37, 0x4B, 0x25, 0x9A, 0xDB, 0xF4, 0x7F, 0x32, 0x61, 0x29, 0x9B,
+  0xC1, 0x04, 0x5E, 0x1F, 0xFB, 0x1C, 0x61, 0x3D, 0xBE, 0x54, 0x6E, 0x46, 0x9C, 0x33, 0x43, 0x64,
+  0xC9, 0xCE, 0xAC, 0x33, 0x6A, 0x4C, 0xD1, 0x69, 0x70, 0x1F, 0xD1, 0xBB, 0xCA, 0x90, 0xF9, 0x94,
+  0x0A, 0xF0, 0xD7, 0xE7, 0x8B, 0x8F, 0xCE, 0xB5, 0xDF, 0x90, 0x34, 0x5B, 0x97, 0x79, 0xCD, 0x44,
+  0xCD, 0x75, 0xA3, 0xA8, 0x7D, 0x11, 0x53, 0xAF, 0x2A, 0x23, 0x69, 0x9F, 0xB2, 0x4C, 0x0D, 0x2D,
+  0x0E, 0xE6, 0x73, 0x78, 0x79, 0x7A, 0x3A, 0xF2, 0xCA, 0xB3, 0x4F, 0x57, 0x5F, 0xBF, 0xE4, 0xAD,
+  0x30, 0x16, 0x3D, 0x0B, 0x75, 0x8B, 0x56, 0x37, 0xD6, 0x3B, 0x4E, 0x06, 0xC3, 0xFD, 0xA0, 0x99,
+  0xCC, 0xCD, 0xD2, 0x0F, 0xE7, 0xD7, 0xE4, 0x1B, 0x99, 0x36, 0xDC, 0x68, 0xC9, 0x8B, 0xCC, 0x5B,
+  0xCF, 0x46, 0xA7, 0xF1, 0x9D, 0x21, 0xA6, 0xC1, 0x02, 0xBB, 0x77, 0x80, 0xB3, 0x8F, 0x03, 0x70,
+  0xD0, 0xE7, 0x5E, 0x01, 0x03, 0x64, 0xF3, 0x83, 0xA6, 0x48, 0xFB, 0x14, 0x3E, 0xFE, 0x80, 0x8C,
+  0x9E, 0x89, 0x9E, 0x4C, 0xCB, 0x9B, 0x9F, 0x59, 0x46, 0xDF, 0x9B, 0x07, 0x6D, 0xAE, 0xE7, 0x7F,
+  0xD0, 0x1B, 0x3D, 0xFF, 0xA5, 0x48, 0xFB, 0x02, 0xB6, 0x79, 0x78, 0x31, 0x09, 0x8A, 0x14, 0x8D,
+  0xB0, 0xD4, 0xB3, 0xD3, 0x51, 0x30, 0xEF, 0x39, 0x1D, 0x7D, 0x6F, 0xCE, 0xC3, 0x61, 0xAC, 0x4B,
+  0x61, 0xAB, 0x1C, 0xF8, 0xBD, 0xE1, 0x23, 0xCB, 0xEF, 0xB5, 0x85, 0x6D, 0x85, 0x4D, 0x2C, 0x55,
+  0x06, 0xD2, 0xAB, 0x46, 0x65, 0xF1, 0x27, 0xFD, 0xD4, 0x48, 0xB1, 0x3C, 0xD6, 0xFE, 0x86, 0x8F,
+  0xC6, 0xB0, 0xA5, 0xE6, 0xCA, 0x1A, 0xF7, 0xFD, 0xF5, 0x69, 0x2D, 0x2A, 0xDC, 0x7E, 0xAC, 0x27,
+  0x94, 0x3F, 0xB4, 0x95, 0xB0, 0x83, 0xE7, 0x7E, 0x73, 0x16, 0x01, 0xEF, 0x23, 0xFE, 0x74, 0x99,
+  0xC7, 0x78, 0xF9, 0x78, 0x86, 0xF5, 0x13, 0x7D, 0x2F, 0x12, 0xC3, 0x4B, 0xBA, 0xAD, 0xA4, 0xC3,
+  0xAB, 0x96, 0x9E, 0x1B, 0x0E, 0x27, 0xA1, 0x3C, 0xA1, 0x1E, 0xC7, 0x18, 0xC4, 0x7B, 0xA3, 0xB5,
+  0x44, 0xEC, 0x7D, 0x78, 0x46, 0x7C, 0xB2, 0x54, 0xC8, 0x99, 0xC1, 0x4F, 0xEA, 0xAF, 0x3A, 0x0F,
+  0xD1, 0x83, 0x41, 0xBC, 0xCA, 0x45, 0xA8, 0x89, 0xF9, 0xA0, 0xF4, 0x35, 0x70, 0x9A, 0xE9, 0x36,
+  0x85, 0x57, 0x7E, 0x45, 0xE1, 0x48, 0x07, 0x6E, 0x4A, 0x5E, 0xFF, 0xAA, 0x3C, 0xAC, 0x01, 0x4F,
+  0xE4, 0x67, 0x29, 0xDF, 0x08, 0xD5, 0xB1, 0xD9, 0x9F, 0x85, 0xAB, 0xF2, 0x95, 0xD2, 0xDA, 0x64,
+  0xEF, 0xC9, 0xC2, 0xBC, 0xD1, 0x5B, 0xE2, 0x9C, 0xC2, 0x8B, 0x53, 0x2A, 0x0E, 0xCE, 0x7C, 0xA0,
+  0x1E, 0x1E, 0x87, 0x2B, 0x1A, 0xD0, 0x58, 0xB6, 0x9F, 0xB0, 0x42, 0x11, 0x73, 0xE8, 0x9D, 0xB8,
+  0xA5, 0x34, 0xF0, 0x03, 0xD4, 0xC1, 0x50, 0xC6, 0x7D, 0xE2, 0x49, 0xC0, 0xE3, 0x88, 0x90, 0x8E,
+  0xF2, 0xF0, 0x66, 0xEE, 0x3D, 0x3B, 0xFB, 0xA5, 0x9C, 0x77, 0x8B, 0xA4, 0x7A, 0xFB, 0x0F, 0xE0,
+  0xB8, 0x22, 0x34, 0xFA, 0xBD, 0x47, 0x25, 0xCC, 0x94, 0xFD, 0xC9, 0x00, 0xCE, 0x70, 0xE1, 0x4A,
+  0xA8, 0x90, 0x24, 0x9C, 0x66, 0x91, 0x6D, 0xE4, 0x87, 0xC3, 0xF0, 0x86, 0xED, 0xEB, 0xC4, 0x27,
+  0xFF, 0x0D, 0xB1, 0x84, 0x2A, 0xEE, 0x8F, 0xFD, 0xC1, 0xFE, 0x01, 0x4A, 0xC3, 0x97, 0x6E, 0xA6,
+  0xCE, 0x17, 0x62, 0x77, 0xA8, 0xEA, 0x9E, 0x7E, 0x23, 0x98, 0xF1, 0x21, 0xDB, 0x23, 0x68, 0x2B,
+  0xBD, 0x25, 0x04, 0xA5, 0xB1, 0x8E, 0xB8, 0x42, 0x13, 0xE1, 0x51, 0xF4, 0xB0, 0x85, 0xA8, 0xFE,
+  0x72, 0x95, 0xF7, 0xFD, 0xD3, 0x20, 0x8D, 0x84, 0xD4, 0xB4, 0x46, 0x39, 0x79, 0x76, 0x4E, 0x93,
+  0x71, 0x36, 0x70, 0xAF, 0x7A, 0xEE, 0x60, 0xEC, 0x8A, 0x5E, 0x2E, 0x6D, 0xB1, 0x7C, 0xC4, 0x5E,
+  0x5F, 0x32, 0xAB, 0x5C, 0x96, 0xDC, 0x1F, 0x42, 0x01, 0xF9, 0xAC, 0x28, 0x50, 0x2A, 0x92, 0xB3,
+  0xF2, 0x07, 0xFA, 0x84, 0x78, 0xF9, 0xDB, 0xC8, 0x77, 0x90, 0xDB, 0xB7, 0xE3, 0x28, 0xF2, 0x48,
+  0xBB, 0x62, 0xD7, 0x5F, 0xD3, 0x7C, 0xD2, 0xEB, 0x8C, 0x28, 0xDC, 0xFB, 0x2F, 0xFF, 0xE5, 0xDF,
+  0xD9, 0x34, 0x0E, 0x2B, 0x34, 0x41, 0xF1, 0xFC, 0x49, 0xD3, 0xA8, 0xFF, 0x4F, 0xE0, 0x3F, 0x73,
+  0xEF, 0x25, 0x12, 0x1A, 0x0C, 0x00, 0x00,
+};
+
+// live.html: 2319 bytes, 1082 bytes compressed
+static const uint8_t web_live_html[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x56, 0x6D, 0x6F, 0xDB, 0x36,
+  0x10, 0xFE, 0xEE, 0x5F, 0x71, 0xF5, 0x17, 0x4B, 0xB3, 0x2D, 0xD9, 0x49, 0x9C, 0x05, 0xB1, 0x2C,
+  0xA0, 0x4D, 0x5B, 0xAC, 0xC0, 0xD6, 0x15, 0x6D, 0xB6, 0x61, 0x08, 0xFA, 0x81, 0xA6, 0x68, 0x89,
+  0x8B, 0x4C, 0x7A, 0x24, 0x65, 0xD7, 0xDB, 0xF2, 0xDF, 0x77, 0x47, 0x4A, 0x89, 0x9D, 0x79, 0x43,
+  0x17, 0xC0, 0xCE, 0x89, 0x77, 0xF7, 0xDC, 0x73, 0x6F, 0x94, 0xB3, 0x17, 0xAF, 0x7F, 0xBC, 0xB9,
+  0xFD, 0xF5, 0xC3, 0x1B, 0xA8, 0xDC, 0xBA, 0xCE, 0x7B, 0xD9, 0x8B, 0xF1, 0x18, 0x3E, 0xD4, 0xDA,
+  0x59, 0x70, 0x95, 0x00, 0xCB, 0xD6, 0x9B, 0x5A, 0x58, 0xB0, 0xCE, 0x08, 0xB6, 0x16, 0x05, 0xE8,
+  0xAD, 0x30, 0x5E, 0xF3, 0x8B, 0x58, 0x7E, 0xD2, 0xFC, 0x5E, 0x38, 0x60, 0x0E, 0xD2, 0x9D, 0x4D,
+  0xE0, 0x16, 0x4F, 0x57, 0x06, 0xAD, 0x2C, 0x30, 0x23, 0xA0, 0x10, 0x5C, 0x17, 0xE8, 0xC1, 0x2C,
+  0x8A, 0x96, 0x1B, 0xB9, 0xC4, 0x07, 0xA9, 0xC0, 0x89, 0x5A, 0xAC, 0x85, 0x33, 0xFB, 0xA4, 0x4A,
+  0x7A, 0x40, 0x7F, 0xE4, 0x68, 0xC4, 0xEF, 0x8D, 0xB0, 0x0E, 0x4D, 0x0C, 0x73, 0x82, 0xEC, 0xBE,
+  0xFB, 0x03, 0x24, 0x06, 0x16, 0xCA, 0x81, 0xD3, 0x3E, 0x64, 0xAD, 0xCB, 0x12, 0xA3, 0x23, 0xA0,
+  0x13, 0x5F, 0x1C, 0x8C, 0xC7, 0x48, 0xD7, 0xB3, 0xCE, 0x2A, 0xC1, 0x8A, 0x3C, 0x43, 0x54, 0x06,
+  0x0A, 0x09, 0x2C, 0xFA, 0x5B, 0x29, 0x76, 0x1B, 0x6D, 0x5C, 0x1F, 0xB8, 0x56, 0x0E, 0x31, 0x16,
+  0xFD, 0x9D, 0x2C, 0x5C, 0xB5, 0x28, 0xC4, 0x56, 0x72, 0x31, 0xF6, 0x0F, 0x23, 0xA9, 0xA4, 0x93,
+  0xAC, 0x1E, 0x5B, 0xCE, 0x6A, 0xB1, 0x98, 0x26, 0x93, 0x7E, 0x9E, 0x39, 0xE9, 0x6A, 0x91, 0x7F,
+  0xF4, 0xA9, 0x7D, 0xEF, 0x03, 0x66, 0x69, 0x38, 0xEB, 0x65, 0xB5, 0x54, 0xF7, 0xC8, 0xB4, 0x5E,
+  0xF4, 0xAD, 0xDB, 0x63, 0x59, 0x2A, 0x21, 0x30, 0x42, 0x65, 0xC4, 0x6A, 0xD1, 0x4F, 0xFD, 0x51,
+  0xC2, 0xAD, 0x45, 0x10, 0x4A, 0x77, 0xE3, 0xC0, 0x1A, 0x8E, 0x8A, 0x0D, 0x56, 0x33, 0xF9, 0x8D,
+  0x8E, 0xD3, 0x70, 0x8E, 0x82, 0x27, 0xDC, 0xCB, 0x96, 0xBA, 0xD8, 0xE7, 0x19, 0xEB, 0x20, 0xFA,
+  0xF9, 0x2B, 0xC6, 0xEF, 0xB3, 0x94, 0xE5, 0x90, 0xD5, 0x6C, 0x29, 0xEA, 0xFC, 0x23, 0x16, 0xE3,
+  0x1A, 0x32, 0x8B, 0x35, 0xE3, 0x0E, 0x64, 0xB1, 0xE8, 0x53, 0x79, 0x10, 0x4A, 0x6F, 0x9C, 0xD4,
+  0x2A, 0x9F, 0x4E, 0xB2, 0xB4, 0x15, 0xBB, 0xA3, 0xB3, 0xD9, 0xF3, 0x23, 0x08, 0xEE, 0xA2, 0xC8,
+  0x67, 0xFF, 0x34, 0x9F, 0x4E, 0x4E, 0x41, 0x1C, 0x9C, 0xA5, 0xC1, 0x3B, 0xC7, 0x86, 0x64, 0x69,
+  0x60, 0xD5, 0xCB, 0x0A, 0xB9, 0xF5, 0x6C, 0xA4, 0x5A, 0xE9, 0x7E, 0x7E, 0xA3, 0x95, 0x42, 0x13,
+  0xA9, 0xCA, 0x2C, 0x45, 0x4D, 0xD0, 0xE7, 0x2F, 0x6B, 0xAC, 0x5B, 0x53, 0x08, 0x88, 0xD6, 0x71,
+  0x38, 0xCF, 0x38, 0x53, 0x5B, 0x6C, 0x1F, 0x79, 0xB2, 0x1A, 0x4B, 0x17, 0x7A, 0xD2, 0xBF, 0x9A,
+  0x4C, 0xB0, 0x8C, 0x42, 0x96, 0x15, 0xF6, 0x69, 0x7A, 0x49, 0x6D, 0x48, 0x83, 0x69, 0x07, 0xC5,
+  0x39, 0x92, 0xC0, 0xD4, 0x29, 0x9B, 0xA8, 0x3C, 0x05, 0xC7, 0xF9, 0xFF, 0x80, 0x53, 0x65, 0x53,
+  0x33, 0x13, 0x46, 0x2D, 0x2A, 0x44, 0x99, 0xDA, 0x13, 0x90, 0xE5, 0xDE, 0xE8, 0xAF, 0xC3, 0x6C,
+  0xDB, 0xDA, 0xDB, 0x22, 0xE6, 0x7B, 0x58, 0xC0, 0x6C, 0x32, 0x19, 0x75, 0xAB, 0xB0, 0x00, 0x94,
+  0x6B, 0x6D, 0x1D, 0x49, 0x73, 0x6F, 0x62, 0x85, 0x91, 0x5E, 0xF3, 0x27, 0x60, 0x15, 0xAE, 0xE1,
+  0xEE, 0xEE, 0xF3, 0xE7, 0x11, 0x60, 0x06, 0x5E, 0x1C, 0x41, 0xF8, 0xE0, 0x17, 0x31, 0x38, 0x3E,
+  0x83, 0x87, 0x00, 0xE1, 0x99, 0x2F, 0xA0, 0xD0, 0xBC, 0x59, 0xE3, 0x74, 0x27, 0xA5, 0x70, 0x6F,
+  0x68, 0xAD, 0x94, 0x7B, 0xB5, 0x7F, 0x57, 0x44, 0x03, 0xD2, 0x0F, 0xE2, 0x11, 0x50, 0x7F, 0xFE,
+  0xCB, 0x8E, 0xF4, 0x83, 0x38, 0x60, 0xEE, 0x88, 0x92, 0x12, 0xBB, 0xA7, 0xD5, 0x8E, 0x06, 0x3B,
+  0x7B, 0x9D, 0xA6, 0x03, 0x18, 0x62, 0x06, 0xDC, 0x57, 0x3F, 0xA9, 0x28, 0x95, 0x21, 0x0C, 0x70,
+  0xE5, 0xC9, 0x11, 0x17, 0x7F, 0x29, 0x15, 0x33, 0xFB, 0xDB, 0xFD, 0x86, 0x18, 0x0D, 0x98, 0x31,
+  0x6C, 0xBF, 0x6C, 0x56, 0x2B, 0x61, 0x06, 0x5E, 0xAD, 0x95, 0xDE, 0x08, 0x85, 0xAA, 0x55, 0xA3,
+  0x38, 0x41, 0x44, 0x31, 0x26, 0x8E, 0x0A, 0x5C, 0xED, 0x22, 0x22, 0xA2, 0xC9, 0x96, 0xD5, 0x8D,
+  0x88, 0xE7, 0x94, 0x9C, 0x77, 0xE0, 0x58, 0x2F, 0xF1, 0xDC, 0x83, 0xA8, 0x26, 0xB4, 0xF8, 0x37,
+  0x61, 0xA3, 0x29, 0xD8, 0x6B, 0x69, 0x79, 0x98, 0x3D, 0x51, 0x0C, 0xBC, 0xBF, 0xC7, 0x43, 0x84,
+  0x8A, 0xA9, 0x52, 0x7C, 0x6D, 0xD0, 0xCE, 0x08, 0x36, 0x8D, 0xAD, 0x22, 0xDC, 0x72, 0x31, 0x82,
+  0xA0, 0x46, 0x27, 0x7A, 0x4C, 0xBC, 0xA2, 0xF3, 0x90, 0x2B, 0xF0, 0x46, 0x49, 0x2D, 0x54, 0xE9,
+  0x2A, 0xC8, 0xE1, 0x7D, 0x1C, 0xCC, 0x6C, 0x25, 0x57, 0x2E, 0x22, 0xD0, 0x90, 0x08, 0x0E, 0x80,
+  0x65, 0xC7, 0x3C, 0x08, 0x13, 0xAF, 0x3D, 0x2A, 0xF8, 0xB6, 0xAD, 0xF7, 0x6B, 0xE6, 0xD8, 0xCF,
+  0x78, 0x61, 0x45, 0x22, 0x29, 0x50, 0xC4, 0xAA, 0x06, 0x3D, 0xD7, 0x8D, 0x4F, 0x73, 0x4B, 0x6D,
+  0xFB, 0x49, 0x2A, 0x77, 0x15, 0x4D, 0x1F, 0x95, 0x34, 0x1B, 0x9F, 0xE8, 0xDE, 0xEA, 0x0C, 0xDE,
+  0xD6, 0x9A, 0xB9, 0xF3, 0xB3, 0xE8, 0x6A, 0x04, 0xCE, 0x20, 0x4F, 0x3F, 0x51, 0x27, 0x2D, 0xA6,
+  0x67, 0x8F, 0x26, 0xA5, 0xC1, 0x18, 0x45, 0x67, 0xF0, 0x4E, 0x79, 0xF5, 0x65, 0xAB, 0xA6, 0x50,
+  0x61, 0x8A, 0x87, 0x43, 0x92, 0xFD, 0x14, 0x0F, 0x0F, 0xF8, 0xA0, 0xF1, 0xC5, 0xA1, 0xAD, 0x36,
+  0x10, 0x11, 0x37, 0xE9, 0x67, 0x1D, 0xFF, 0x65, 0x21, 0x07, 0x14, 0x87, 0xC3, 0x90, 0x77, 0x20,
+  0x4F, 0x33, 0x79, 0x36, 0xC1, 0x31, 0xC2, 0xAF, 0x6F, 0x40, 0xCE, 0x1F, 0x15, 0x1B, 0x83, 0x15,
+  0x6B, 0x8C, 0x38, 0xCE, 0x5A, 0xA3, 0xE5, 0x2C, 0x86, 0xBF, 0x10, 0xFD, 0xF8, 0xF0, 0x32, 0x86,
+  0x2C, 0x83, 0xAB, 0x53, 0xAA, 0x6F, 0xBD, 0x6A, 0x7A, 0x19, 0x07, 0x70, 0xDF, 0xC0, 0xB0, 0x78,
+  0x09, 0x2E, 0xDD, 0xDD, 0x04, 0xF7, 0xE9, 0xE2, 0xE2, 0xFC, 0x9C, 0xE2, 0x47, 0x53, 0x18, 0xC3,
+  0x0F, 0xCC, 0x55, 0xC9, 0x46, 0xEF, 0xA2, 0x47, 0x0A, 0x69, 0x5B, 0x9D, 0x11, 0x4C, 0x51, 0x9E,
+  0x25, 0x67, 0xB3, 0x59, 0x1C, 0xB7, 0x70, 0x8F, 0xA9, 0xB2, 0x2F, 0xD2, 0x86, 0x6C, 0xBD, 0x94,
+  0xC1, 0x79, 0x90, 0x9E, 0xF2, 0x3D, 0x8E, 0x4D, 0x6D, 0xBB, 0x23, 0x03, 0x8C, 0xDF, 0xD5, 0x7C,
+  0x7A, 0xE9, 0x19, 0x5F, 0x51, 0x3D, 0x90, 0x0E, 0x69, 0xDB, 0xAA, 0x12, 0x87, 0xAE, 0xCF, 0x6D,
+  0xE4, 0x67, 0xA9, 0x70, 0xFE, 0x2F, 0x68, 0xD3, 0x8B, 0x93, 0x70, 0xDD, 0x4C, 0xB4, 0x68, 0x0F,
+  0xBD, 0xF0, 0x39, 0xB5, 0x5C, 0x6F, 0x7D, 0xEB, 0xAF, 0x81, 0xD6, 0xBF, 0xBD, 0xCC, 0x70, 0xEF,
+  0xDB, 0xCB, 0xAC, 0xFD, 0x61, 0x10, 0xB4, 0x74, 0x32, 0xEF, 0x1D, 0x2E, 0x52, 0x61, 0xD8, 0x2E,
+  0x0A, 0x15, 0xA0, 0xD7, 0x5F, 0x34, 0xC0, 0x9A, 0xA3, 0xEB, 0x53, 0x03, 0x46, 0xA0, 0x9A, 0xBA,
+  0x1E, 0xE1, 0xE6, 0xCC, 0x9F, 0x6C, 0x38, 0x3F, 0xB0, 0xE1, 0xFC, 0x94, 0x0D, 0x95, 0xE3, 0xC9,
+  0x88, 0x9E, 0x8E, 0xAD, 0xDA, 0xDF, 0x11, 0x2F, 0x95, 0x5C, 0xFB, 0xFB, 0xCA, 0x27, 0x11, 0x11,
+  0x1D, 0x54, 0x3F, 0xF4, 0x02, 0xAF, 0x79, 0xEF, 0xE0, 0x55, 0x1C, 0xDE, 0xC1, 0x69, 0xF8, 0xF9,
+  0xF3, 0x37, 0x49, 0xC9, 0x1C, 0x2E, 0x0F, 0x09, 0x00, 0x00,
+};
+
+// log.js: 4811 bytes, 1796 bytes compressed
+static const uint8_t web_log_js[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9D, 0x57, 0xEB, 0x73, 0xDA, 0x46,
+  0x10, 0xFF, 0xCE, 0x5F, 0xB1, 0xF9, 0x62, 0xA4, 0x42, 0x30, 0x02, 0x81, 0x89, 0xB1, 0xDD, 0xA1,
+  0xF8, 0x91, 0x4C, 0xB1, 0x9D, 0x31, 0x49, 0x67, 0x5A, 0x86, 0x32, 0xB2, 0x38, 0x40, 0x63, 0x59,
+  0xD2, 0x48, 0x27, 0x6C, 0x27, 0xE1, 0x7F, 0xEF, 0xEE, 0xDD, 0x49, 0x3A, 0x01, 0x76, 0xD3, 0x66,
+  0x1C, 0xFB, 0x1E, 0x7B, 0xFB, 0xFC, 0xED, 0x43, 0x87, 0x87, 0x70, 0xCE, 0xDC, 0x70, 0xCE, 0x12,
+  0x70, 0xE0, 0xDE, 0x0B, 0x9C, 0xF8, 0x05, 0xFC, 0x70, 0x09, 0x0B, 0xCF, 0x67, 0xE0, 0x24, 0x80,
+  0x17, 0x6E, 0xEC, 0xDD, 0xB3, 0x39, 0x78, 0x01, 0x5D, 0xCC, 0x16, 0x61, 0xFC, 0xE8, 0xF0, 0xC6,
+  0x0A, 0x9C, 0x60, 0x2E, 0x0E, 0xE8, 0xB1, 0xDB, 0x58, 0xD5, 0x21, 0x09, 0x81, 0xAF, 0x18, 0x9D,
+  0x2D, 0x59, 0x0C, 0xF3, 0x10, 0x59, 0x06, 0x21, 0x87, 0x95, 0xB3, 0x66, 0xC0, 0x43, 0x70, 0xC3,
+  0x60, 0xCD, 0x62, 0x0E, 0x1E, 0x6F, 0x54, 0x0E, 0x0F, 0xE1, 0x8E, 0xF1, 0x34, 0x0E, 0x12, 0xF1,
+  0x64, 0xC5, 0x9C, 0x39, 0x3E, 0x21, 0x8E, 0xB4, 0x4D, 0x9C, 0xC7, 0xC8, 0x27, 0x85, 0xF0, 0x27,
+  0x8E, 0x9D, 0x97, 0x04, 0xC2, 0x85, 0xB8, 0xE0, 0xDE, 0x23, 0x23, 0x3D, 0x92, 0x3A, 0x38, 0x3E,
+  0xF7, 0x78, 0x3A, 0x17, 0xDB, 0x47, 0xDC, 0xBA, 0x2E, 0xF3, 0x59, 0xEC, 0x70, 0x2F, 0x0C, 0xE8,
+  0x68, 0x29, 0x98, 0x39, 0xC1, 0x32, 0xF5, 0x9D, 0x18, 0xF0, 0x5C, 0x10, 0xCE, 0xD9, 0xF2, 0x30,
+  0xA9, 0xAC, 0xF1, 0x64, 0x74, 0x7B, 0x35, 0xBB, 0x1E, 0x5C, 0x7D, 0x1A, 0xC2, 0x29, 0x34, 0x9F,
+  0xED, 0x23, 0xFB, 0xD2, 0x1E, 0x76, 0x5A, 0x75, 0x71, 0x7E, 0x39, 0x1A, 0x5C, 0xCD, 0x86, 0xB7,
+  0xD7, 0x9F, 0xEF, 0x2E, 0xC6, 0xE3, 0x8B, 0x73, 0xA4, 0xB0, 0xE4, 0xC5, 0xDD, 0xC5, 0xF0, 0xF6,
+  0xEE, 0x7C, 0x36, 0xFE, 0xF4, 0xD7, 0x05, 0x1E, 0xB6, 0x9A, 0xF2, 0xF4, 0xB7, 0xD1, 0xED, 0xF0,
+  0xF7, 0xE2, 0xD0, 0xEE, 0xF5, 0x73, 0x09, 0xD9, 0x83, 0xC1, 0xF5, 0xE7, 0x11, 0xDD, 0x36, 0x4B,
+  0x7C, 0x46, 0x83, 0xAF, 0x37, 0xC3, 0x8F, 0x78, 0xDC, 0x2E, 0x1D, 0x7F, 0xFE, 0x38, 0x18, 0x13,
+  0xB1, 0x5D, 0x3A, 0xBD, 0x1B, 0xDC, 0x5C, 0xD1, 0x69, 0x57, 0x72, 0xBF, 0xFA, 0xF3, 0xEE, 0x76,
+  0x36, 0x1E, 0x0E, 0x46, 0x17, 0xB3, 0xCB, 0xC1, 0xF0, 0xCB, 0xED, 0xDD, 0x18, 0xEF, 0x26, 0x56,
+  0x1B, 0x35, 0xED, 0x76, 0x1A, 0x9D, 0x3A, 0xB4, 0x5B, 0x8D, 0x5E, 0x1D, 0xAC, 0x6E, 0xC3, 0x9E,
+  0xD6, 0x61, 0x30, 0x1C, 0xEE, 0x21, 0xEE, 0xB6, 0x7B, 0x28, 0xA3, 0x67, 0x7D, 0x40, 0xBB, 0xED,
+  0xE6, 0x87, 0x6E, 0x5D, 0x68, 0x3F, 0x95, 0x02, 0x84, 0x16, 0x82, 0xAE, 0x1A, 0x39, 0xF3, 0x6A,
+  0x1D, 0xAA, 0xF7, 0x61, 0x98, 0x70, 0x5A, 0xB8, 0xA1, 0x23, 0x17, 0x4E, 0x14, 0x2E, 0x19, 0xA3,
+  0x15, 0xA1, 0x84, 0x05, 0xE2, 0xD0, 0x47, 0xC7, 0xB3, 0x79, 0x15, 0xD9, 0x54, 0x16, 0x69, 0xE0,
+  0x8A, 0x80, 0x64, 0xC1, 0x32, 0xA2, 0x98, 0x25, 0x49, 0x1A, 0x33, 0x13, 0xBE, 0x57, 0x00, 0x62,
+  0x01, 0x01, 0xB0, 0xED, 0x76, 0xBB, 0x09, 0xBF, 0x80, 0x61, 0xC1, 0x7B, 0xB8, 0x76, 0xF8, 0xAA,
+  0x11, 0x85, 0x4F, 0x39, 0x29, 0x1C, 0x82, 0xD5, 0xB4, 0xDA, 0x2D, 0xB4, 0xC9, 0xC2, 0x75, 0xA7,
+  0xD1, 0xEA, 0x74, 0x4C, 0xB3, 0x5F, 0xD9, 0x68, 0xFC, 0xE7, 0x02, 0xC1, 0xA3, 0x70, 0x69, 0xDC,
+  0xA7, 0x8B, 0x05, 0x8B, 0x25, 0x7B, 0x32, 0x63, 0x8D, 0x16, 0x04, 0xEC, 0x09, 0xCE, 0x1D, 0xEE,
+  0xFC, 0xE1, 0xB1, 0xA7, 0x8C, 0x00, 0xD1, 0xEA, 0x7D, 0x63, 0x78, 0x29, 0xF7, 0x8D, 0xFB, 0x17,
+  0xCE, 0x46, 0x2C, 0x58, 0xF2, 0x55, 0x1F, 0x5F, 0x7A, 0x0B, 0x30, 0xC4, 0xFD, 0x09, 0xFA, 0x11,
+  0x7E, 0xFC, 0x80, 0x75, 0x63, 0xC9, 0xF8, 0x57, 0x2F, 0xE0, 0xED, 0x96, 0x81, 0x41, 0xE4, 0x71,
+  0x8A, 0x26, 0xBC, 0x3B, 0x2D, 0x60, 0x64, 0xE2, 0x2B, 0x40, 0x8C, 0xC6, 0xE1, 0x13, 0x54, 0x6F,
+  0x10, 0xF5, 0x4E, 0x9E, 0x45, 0xD5, 0xBE, 0xD2, 0x45, 0xA2, 0x7C, 0x2C, 0xE5, 0xE6, 0x1C, 0xAD,
+  0xAE, 0xD1, 0x55, 0x1C, 0x33, 0xD1, 0x1A, 0x61, 0xA6, 0x80, 0x76, 0x74, 0x26, 0x55, 0xD7, 0xB5,
+  0x42, 0x1E, 0xBD, 0x2D, 0xAD, 0x34, 0xAC, 0x96, 0x74, 0xFB, 0x1A, 0x24, 0x69, 0x14, 0x85, 0x31,
+  0x67, 0xF3, 0xD7, 0x34, 0x44, 0xED, 0xBE, 0x8B, 0x27, 0x98, 0xAE, 0x09, 0xBA, 0xF7, 0xB8, 0x24,
+  0xC8, 0x56, 0x82, 0xEA, 0x82, 0x44, 0xA6, 0xEA, 0x8C, 0x12, 0xAC, 0x4C, 0x66, 0x35, 0x4B, 0x74,
+  0x0B, 0xDF, 0x59, 0x26, 0xC7, 0x25, 0x33, 0x10, 0xF7, 0x5D, 0xF8, 0xB5, 0xE4, 0xDA, 0x76, 0x2B,
+  0xB3, 0xE2, 0x18, 0x73, 0x45, 0x3C, 0x5C, 0xC6, 0x61, 0x1A, 0xCC, 0x67, 0x19, 0x1A, 0xB6, 0x59,
+  0xD8, 0xCD, 0x8C, 0xC5, 0x27, 0xC9, 0xA1, 0xAB, 0x71, 0x40, 0x06, 0x9B, 0xCC, 0xB4, 0xE5, 0x4B,
+  0x1C, 0x8E, 0x5D, 0xC7, 0xCF, 0x7D, 0x7F, 0xE9, 0x87, 0x0E, 0xBD, 0xB0, 0x32, 0x99, 0xA2, 0x88,
+  0xEC, 0x27, 0xE9, 0xE6, 0x24, 0x52, 0x1D, 0x24, 0xB8, 0x71, 0x6E, 0x32, 0xD6, 0xE4, 0x46, 0x74,
+  0x99, 0xD2, 0x2C, 0xD3, 0xB0, 0x2E, 0xAA, 0xD5, 0x31, 0x4C, 0xA6, 0xA2, 0x58, 0xA9, 0x85, 0xEB,
+  0xE2, 0x82, 0x56, 0xF2, 0x3F, 0xFE, 0x22, 0xC5, 0xB6, 0xCF, 0xD8, 0x1A, 0x93, 0x29, 0x91, 0x4F,
+  0xDC, 0x30, 0x8E, 0xD3, 0x08, 0xC3, 0x75, 0x0C, 0x0B, 0xC7, 0x4F, 0x18, 0x99, 0x84, 0x82, 0x73,
+  0xEC, 0xC7, 0x88, 0xFD, 0x78, 0x6E, 0x90, 0xB0, 0x84, 0x63, 0x34, 0x50, 0xEE, 0x4B, 0xC4, 0xEA,
+  0x10, 0x49, 0xD6, 0x42, 0x26, 0xFE, 0x8A, 0x97, 0xA6, 0x8A, 0x2A, 0x21, 0x8C, 0x48, 0xE0, 0xF4,
+  0x74, 0xB7, 0x48, 0x65, 0x44, 0x92, 0xCC, 0x4B, 0xD0, 0x4C, 0x43, 0xDA, 0x6C, 0x9A, 0x80, 0x55,
+  0xFB, 0x0B, 0x56, 0xE1, 0x85, 0x17, 0x27, 0x1C, 0xF2, 0xFC, 0xF4, 0x12, 0x48, 0x13, 0x44, 0x93,
+  0x23, 0x6B, 0xB9, 0xF2, 0x10, 0xB6, 0x09, 0x08, 0x7D, 0x42, 0x13, 0xBA, 0x27, 0x51, 0x3C, 0xA1,
+  0xF0, 0x5F, 0x5E, 0x12, 0xA4, 0xB7, 0x1A, 0x5B, 0x71, 0x46, 0x94, 0x53, 0x64, 0x5F, 0xB9, 0x3C,
+  0x86, 0x48, 0x24, 0x0B, 0xFD, 0x43, 0xF6, 0x0D, 0x32, 0xBE, 0x11, 0xA5, 0xC9, 0xAA, 0x70, 0x03,
+  0x95, 0x0D, 0xD6, 0x2D, 0x51, 0xA1, 0x48, 0x49, 0x54, 0x94, 0x23, 0x13, 0x2B, 0x8E, 0x32, 0x2F,
+  0xA3, 0x24, 0xC5, 0x0D, 0x0A, 0xAB, 0xF3, 0x8C, 0x96, 0x61, 0xCD, 0xEE, 0xCB, 0x15, 0x66, 0xA2,
+  0x5C, 0xD5, 0x6A, 0x85, 0x93, 0x24, 0x63, 0xF2, 0xF3, 0x84, 0xAE, 0xA6, 0x92, 0x7F, 0xB1, 0x47,
+  0x2D, 0x72, 0xE0, 0xE5, 0x12, 0x94, 0x36, 0xAE, 0xAB, 0xBF, 0xC9, 0xB7, 0xF8, 0x24, 0xC3, 0x61,
+  0xFE, 0x62, 0x23, 0xFE, 0x6E, 0x80, 0x51, 0xFC, 0x5F, 0x89, 0x9F, 0x68, 0x10, 0x85, 0x66, 0x3A,
+  0xDE, 0x77, 0x9B, 0xC5, 0x04, 0xF1, 0x30, 0x69, 0x4E, 0xE1, 0x00, 0xDA, 0xD3, 0x4C, 0x88, 0x86,
+  0xFE, 0x9D, 0x7E, 0x21, 0xE8, 0x2D, 0x9D, 0xFE, 0x6D, 0x65, 0x64, 0x6B, 0x33, 0x35, 0xE7, 0x4B,
+  0x48, 0x4B, 0x5B, 0x27, 0x5B, 0x51, 0x12, 0x5D, 0x03, 0xF1, 0xBC, 0xAA, 0x4E, 0x95, 0xC9, 0x6F,
+  0xF1, 0x16, 0x9D, 0xE9, 0xE7, 0x59, 0xCB, 0x46, 0xA6, 0x0C, 0x9E, 0x52, 0xD9, 0xAC, 0xA6, 0xC1,
+  0x43, 0x10, 0x3E, 0x05, 0x4A, 0xDA, 0xA6, 0xA2, 0xF2, 0x38, 0x0A, 0x29, 0xDE, 0x45, 0x7D, 0xC9,
+  0xCA, 0xF1, 0xBB, 0x0C, 0xA3, 0xA2, 0x88, 0xA1, 0x0F, 0xF6, 0x0C, 0x09, 0x66, 0xE6, 0x79, 0x01,
+  0x9F, 0xBE, 0xE0, 0x55, 0xDB, 0x19, 0x1A, 0x4E, 0x4E, 0x45, 0xED, 0x56, 0xD7, 0xBB, 0x85, 0x3A,
+  0x8F, 0x9E, 0x50, 0x47, 0xEF, 0x12, 0x3D, 0x43, 0x72, 0xEC, 0x98, 0xF0, 0x03, 0xE1, 0xB9, 0x7D,
+  0xDC, 0x35, 0xE1, 0xE4, 0x04, 0x7A, 0xFB, 0x2F, 0x8F, 0xC4, 0xA5, 0x55, 0x24, 0x83, 0x2A, 0x19,
+  0x7A, 0xE5, 0x45, 0xCA, 0xBC, 0xC6, 0xED, 0x30, 0xB0, 0x4D, 0x2A, 0x27, 0x39, 0x7A, 0x27, 0x59,
+  0xBD, 0xC5, 0x32, 0x2F, 0x09, 0x7A, 0xE5, 0xB7, 0xFA, 0x55, 0xD1, 0x07, 0xF6, 0xDC, 0x65, 0xA5,
+  0x77, 0xFA, 0x16, 0x73, 0xCB, 0x7E, 0x83, 0x43, 0xF7, 0x8D, 0xBB, 0xDE, 0x6B, 0xDC, 0x0B, 0x9B,
+  0x77, 0x75, 0x2F, 0xDD, 0x69, 0xBD, 0x61, 0xCF, 0x65, 0x26, 0x3B, 0x03, 0xAD, 0xCC, 0x52, 0x42,
+  0x64, 0x5E, 0xB3, 0x31, 0x84, 0x44, 0xFC, 0x4E, 0xC5, 0xBD, 0x22, 0xBD, 0x2F, 0xA6, 0x1E, 0xA4,
+  0xCB, 0xD1, 0x87, 0x85, 0xF5, 0x02, 0x9B, 0xED, 0x0B, 0xDC, 0xFB, 0xA1, 0xFB, 0x00, 0x88, 0xDF,
+  0x98, 0x27, 0xF0, 0xE4, 0xF1, 0x15, 0x4E, 0xCB, 0x09, 0xF8, 0x62, 0x30, 0xC9, 0xC7, 0xE3, 0x20,
+  0x7D, 0xBC, 0xC7, 0xBA, 0x8A, 0x33, 0xB1, 0x0C, 0x64, 0xD2, 0x10, 0x65, 0x79, 0xED, 0xF8, 0x29,
+  0x0D, 0xCD, 0x58, 0x1F, 0xBF, 0x79, 0xCB, 0xF7, 0xDF, 0x9C, 0x25, 0xC1, 0x08, 0x35, 0x4E, 0x90,
+  0xCE, 0xC7, 0xC9, 0x58, 0x8E, 0xE1, 0xC8, 0x41, 0x4A, 0xC4, 0x6A, 0xBA, 0xF6, 0xC2, 0x34, 0x51,
+  0x5C, 0x70, 0x22, 0x62, 0x4C, 0x1B, 0xE8, 0xDD, 0x28, 0x6A, 0xC0, 0xA0, 0x68, 0x3F, 0x4A, 0x37,
+  0xAC, 0x84, 0xC9, 0x83, 0x17, 0x45, 0x34, 0x3E, 0x78, 0x0F, 0x6C, 0x7B, 0xE2, 0x97, 0x5C, 0x70,
+  0x12, 0x1B, 0x12, 0x93, 0xD9, 0x0D, 0x7B, 0xE6, 0xBF, 0xD1, 0x3B, 0xC3, 0x54, 0x49, 0x46, 0x83,
+  0x56, 0xA2, 0x86, 0x32, 0x81, 0xB1, 0x01, 0x4D, 0xF8, 0xC5, 0x58, 0xC6, 0x82, 0x79, 0x5F, 0x6F,
+  0x6F, 0xD2, 0x04, 0x23, 0x4B, 0x0D, 0x31, 0xD3, 0x91, 0xA1, 0xA2, 0x32, 0x57, 0x4A, 0x05, 0x3B,
+  0x59, 0x79, 0x0B, 0x2E, 0x2B, 0xB6, 0x5C, 0x62, 0xC9, 0xEE, 0xC0, 0xC1, 0x81, 0x08, 0xC1, 0x89,
+  0xE0, 0xAC, 0x2E, 0x30, 0xF5, 0x8E, 0xCA, 0xC9, 0x46, 0x6A, 0xD1, 0x34, 0x48, 0xDA, 0x4D, 0x90,
+  0xBE, 0x56, 0xCB, 0xEB, 0xA2, 0x14, 0x87, 0x4F, 0x0C, 0x41, 0x74, 0x80, 0xDF, 0x0B, 0x47, 0x97,
+  0x26, 0xCE, 0xAB, 0xF9, 0xA8, 0x8A, 0x28, 0x11, 0x7C, 0xF3, 0x04, 0x93, 0x55, 0x23, 0x27, 0xEF,
+  0x35, 0x4D, 0x33, 0x87, 0xA0, 0x0A, 0xBF, 0xE4, 0x7A, 0x76, 0x76, 0x96, 0x99, 0xB1, 0xD1, 0xA7,
+  0xB4, 0xDC, 0xEB, 0x55, 0x89, 0x11, 0xCD, 0x21, 0x69, 0x80, 0xD1, 0xC5, 0xE0, 0x1A, 0x82, 0x43,
+  0x66, 0x85, 0xE2, 0x6A, 0x14, 0x6C, 0x2D, 0x13, 0xFE, 0x86, 0xF7, 0xEA, 0xE0, 0x00, 0xB7, 0x19,
+  0xA7, 0xA7, 0x15, 0x7D, 0xDA, 0x19, 0xD2, 0x29, 0x04, 0x4B, 0xDD, 0xB7, 0x32, 0xC8, 0x02, 0xB5,
+  0x75, 0x8C, 0xD1, 0x33, 0xF9, 0xD3, 0x10, 0x86, 0x2E, 0xFC, 0x30, 0x8C, 0x0D, 0x79, 0x7F, 0xB8,
+  0xF5, 0xE1, 0x63, 0x52, 0x3A, 0x90, 0x4B, 0xCA, 0xC7, 0xFD, 0x9C, 0x6D, 0x51, 0x95, 0xC5, 0x47,
+  0xD0, 0x9C, 0xCB, 0xBF, 0x79, 0x43, 0x17, 0x3B, 0x6A, 0x59, 0xF4, 0xC1, 0x81, 0x4B, 0xFA, 0x91,
+  0xE3, 0x92, 0x7E, 0x20, 0xF9, 0x71, 0xCC, 0x13, 0x7D, 0x48, 0x11, 0xD3, 0xF0, 0x7B, 0x15, 0x64,
+  0xBB, 0x70, 0xF4, 0x5E, 0x57, 0x66, 0x0A, 0xA9, 0x94, 0x2A, 0xCF, 0xE1, 0x7A, 0x11, 0x74, 0x71,
+  0x28, 0xE0, 0xBB, 0xF7, 0x68, 0x68, 0x4B, 0x9B, 0xD6, 0x45, 0xAF, 0x12, 0xF3, 0x8C, 0x74, 0x4C,
+  0x4D, 0x31, 0xD6, 0x81, 0xA0, 0x44, 0xA1, 0x6E, 0xD4, 0x7C, 0x88, 0xFA, 0x4C, 0x7A, 0x36, 0xDF,
+  0x89, 0x20, 0xFC, 0xBB, 0xDE, 0xAA, 0x69, 0xD8, 0x3B, 0x93, 0x8A, 0x27, 0x41, 0xEF, 0xA1, 0x0C,
+  0xA1, 0x36, 0x2E, 0xCB, 0x43, 0x8A, 0xF0, 0xB7, 0x81, 0xBF, 0x6B, 0x3A, 0x7C, 0x64, 0x62, 0x61,
+  0xE7, 0xD2, 0x50, 0x28, 0x14, 0xD0, 0x82, 0xA5, 0x0D, 0x54, 0x35, 0x64, 0xB3, 0x43, 0xAB, 0xE7,
+  0x63, 0xC6, 0xB1, 0xB8, 0x25, 0xF3, 0x0B, 0x00, 0x6A, 0x0A, 0x29, 0x54, 0x88, 0xE6, 0xAE, 0xA5,
+  0x82, 0xD5, 0xD7, 0x28, 0x5E, 0x1B, 0x6C, 0x11, 0x0A, 0x41, 0xEA, 0xFB, 0xD9, 0xEF, 0x49, 0x26,
+  0xB6, 0x0E, 0xBB, 0xAB, 0xA9, 0xA9, 0x73, 0x74, 0xC3, 0x80, 0x7B, 0x41, 0xCA, 0x8A, 0xB3, 0x4D,
+  0xBE, 0xCA, 0xA1, 0x88, 0x1E, 0x2E, 0xA7, 0x98, 0xCA, 0xA6, 0xE2, 0xD1, 0xCF, 0x4C, 0x88, 0x9A,
+  0x54, 0x6D, 0x1A, 0x44, 0x7F, 0x6A, 0xBB, 0xFD, 0xC1, 0x10, 0xAD, 0x1A, 0x48, 0x64, 0xF7, 0x7F,
+  0x8B, 0x2C, 0x86, 0x49, 0x94, 0x58, 0x6C, 0xFE, 0x83, 0xC0, 0x5D, 0xE7, 0xEF, 0x7C, 0x2A, 0x14,
+  0xE9, 0x5B, 0xFA, 0xD2, 0xA0, 0xA8, 0x6C, 0x0D, 0xAE, 0xA0, 0x46, 0x2B, 0x55, 0xDB, 0x69, 0x78,
+  0x74, 0x1D, 0xEE, 0xAE, 0xC0, 0x60, 0x05, 0x28, 0xB6, 0xFB, 0x26, 0xE5, 0x58, 0xBF, 0xF4, 0x9C,
+  0x92, 0xA6, 0xA8, 0x95, 0x9B, 0x4A, 0xB9, 0x95, 0x6E, 0x2A, 0xFF, 0x00, 0x25, 0xF3, 0x29, 0x6E,
+  0xCB, 0x12, 0x00, 0x00,
+};
+
+// plot.js: 1653 bytes, 748 bytes compressed
+static const uint8_t web_plot_js[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xBD, 0x54, 0x3B, 0x6F, 0xDB, 0x30,
+  0x10, 0xDE, 0xFD, 0x2B, 0x2E, 0xCE, 0x20, 0xAA, 0x96, 0x65, 0xC9, 0x53, 0x51, 0x37, 0x29, 0xFA,
+  0x48, 0x81, 0x0C, 0x05, 0x8A, 0x36, 0x5B, 0x90, 0x81, 0x95, 0x28, 0x89, 0x29, 0x4D, 0x1A, 0x12,
+  0xED, 0x50, 0x28, 0xFC, 0xDF, 0x73, 0x47, 0x4A, 0x72, 0x90, 0xA4, 0xE8, 0x56, 0xC0, 0x32, 0xA9,
+  0xBB, 0xEF, 0xBE, 0x7B, 0x6B, 0xB5, 0x82, 0x2F, 0x2D, 0x7F, 0xE8, 0xC0, 0x36, 0x02, 0x94, 0xD4,
+  0xA2, 0x03, 0xA9, 0xFD, 0x4B, 0xC1, 0xF5, 0x81, 0x77, 0xF0, 0x20, 0x6D, 0xE3, 0xDF, 0x6B, 0x79,
+  0x10, 0x1A, 0x64, 0x99, 0xC2, 0xDC, 0xCD, 0xA1, 0x31, 0xAA, 0x0C, 0x46, 0x6E, 0x79, 0xE0, 0x6A,
+  0x2F, 0xC0, 0x54, 0x20, 0x0E, 0xA2, 0xED, 0x61, 0x67, 0xA4, 0xB6, 0x60, 0x5A, 0x90, 0x1D, 0xE8,
+  0xBD, 0x52, 0x20, 0x2B, 0x0F, 0xF4, 0xF2, 0x0E, 0x78, 0x2B, 0x66, 0xAB, 0x15, 0x61, 0xB5, 0xEA,
+  0xA1, 0xDB, 0xF1, 0x42, 0x94, 0x60, 0xD0, 0x12, 0xE6, 0x7A, 0x3E, 0x80, 0x52, 0xB8, 0xF2, 0x54,
+  0x85, 0x51, 0xFB, 0xAD, 0x26, 0xEA, 0x9D, 0x74, 0x42, 0x75, 0x44, 0x59, 0x62, 0xB8, 0x1A, 0x78,
+  0x70, 0xBE, 0x95, 0x5A, 0x6E, 0xF7, 0x5B, 0xE0, 0xBA, 0x84, 0x2D, 0x77, 0xFE, 0x8E, 0xF1, 0x4B,
+  0x9B, 0x40, 0x67, 0x40, 0x19, 0x5D, 0xE3, 0x5F, 0x1D, 0x8C, 0xA0, 0xE2, 0x9D, 0x9D, 0x1D, 0x78,
+  0x4B, 0xB4, 0xA6, 0xED, 0xE0, 0x02, 0x6E, 0xA3, 0xF3, 0x32, 0xCB, 0xA2, 0x04, 0xA2, 0xF3, 0xEC,
+  0xED, 0x70, 0x66, 0x65, 0x74, 0xB7, 0x99, 0x55, 0x7B, 0x5D, 0x58, 0x69, 0x34, 0xEC, 0x94, 0xB1,
+  0x4C, 0x96, 0x49, 0x28, 0x4E, 0x02, 0x2E, 0x01, 0x1D, 0xC3, 0x9F, 0x19, 0x80, 0x67, 0x42, 0x92,
+  0xD2, 0x14, 0xFB, 0xAD, 0xD0, 0x36, 0xAD, 0x85, 0xBD, 0x52, 0x82, 0xAE, 0x9F, 0xFA, 0xEB, 0x12,
+  0x8D, 0xE2, 0x04, 0x0A, 0xEB, 0x10, 0x52, 0x90, 0xEE, 0xB3, 0xD1, 0x56, 0x38, 0xCB, 0xA2, 0x75,
+  0x19, 0xC5, 0x9B, 0x81, 0x00, 0x13, 0x40, 0xFD, 0xB5, 0xAE, 0x30, 0x11, 0xDB, 0x27, 0x94, 0x04,
+  0xBE, 0x2F, 0x47, 0x01, 0xC1, 0xBC, 0xE3, 0xB4, 0x32, 0xED, 0x15, 0x2F, 0x1A, 0x36, 0x06, 0xC6,
+  0x48, 0x8C, 0x81, 0x78, 0xF5, 0x4B, 0x6D, 0x4F, 0xAA, 0x40, 0xFE, 0x8D, 0xDB, 0x26, 0xC5, 0x2B,
+  0xC3, 0x27, 0x81, 0x3E, 0xDE, 0x0C, 0x4E, 0x82, 0x9C, 0x3B, 0x86, 0x4F, 0x90, 0x1F, 0xC3, 0x83,
+  0x3E, 0xB1, 0x65, 0xEC, 0x8C, 0x14, 0x70, 0x49, 0x2C, 0xF1, 0xC8, 0xB6, 0xBC, 0x80, 0x3C, 0xD8,
+  0x2F, 0xFC, 0xED, 0x38, 0xA4, 0xE1, 0x32, 0x24, 0x74, 0xF0, 0x01, 0xDC, 0x6D, 0x76, 0x07, 0xEF,
+  0x20, 0xC3, 0x42, 0xE5, 0x93, 0xC8, 0xA5, 0x4A, 0xE8, 0x1A, 0xE7, 0x68, 0x09, 0x39, 0x69, 0x35,
+  0x5D, 0x4E, 0x6E, 0x10, 0x79, 0x89, 0x0C, 0xE8, 0x24, 0xD8, 0x64, 0xB0, 0x08, 0x6A, 0x2C, 0x5E,
+  0x5A, 0x28, 0xC1, 0xDB, 0x1F, 0xA2, 0xB0, 0x0C, 0x39, 0xF1, 0x57, 0xA4, 0x0F, 0xB2, 0xB4, 0x0D,
+  0x5D, 0x1A, 0x21, 0xEB, 0xC6, 0xC6, 0x23, 0xB2, 0x92, 0x4A, 0xFD, 0xB4, 0xBD, 0x12, 0xC8, 0x41,
+  0x7D, 0xCC, 0xA2, 0xA7, 0x9A, 0x1B, 0x2A, 0x3D, 0x06, 0x9E, 0x5A, 0xF3, 0x15, 0x67, 0xA9, 0x64,
+  0x6B, 0xEC, 0xCE, 0x3A, 0x81, 0x3C, 0x8B, 0x5F, 0xC2, 0xA4, 0x7E, 0x0E, 0x1B, 0xBD, 0x61, 0xE4,
+  0xEB, 0xA9, 0x42, 0x2E, 0x0C, 0x42, 0xB0, 0xA6, 0xDE, 0x7E, 0x54, 0xB2, 0xA6, 0x92, 0x47, 0x2D,
+  0x61, 0xBD, 0xFF, 0x67, 0xD4, 0x2E, 0x9B, 0x98, 0xF3, 0x18, 0xF3, 0x8C, 0x90, 0x30, 0xC2, 0xD3,
+  0xE5, 0xCF, 0xE5, 0x5D, 0x34, 0x25, 0x4B, 0x4E, 0x5F, 0x09, 0xE1, 0x15, 0xBF, 0x4A, 0x54, 0xC1,
+  0xED, 0xD8, 0x98, 0x8E, 0x3A, 0xCD, 0x4E, 0x3C, 0x48, 0xBE, 0x02, 0xAA, 0xF8, 0x92, 0x2A, 0x8E,
+  0x5B, 0xD2, 0x07, 0xFD, 0x44, 0x1D, 0x00, 0xD4, 0xE1, 0xA5, 0xEF, 0xFC, 0x3F, 0x26, 0x30, 0x81,
+  0xFB, 0xA7, 0x45, 0xE8, 0x6C, 0x6B, 0x7E, 0x8B, 0xB1, 0x0B, 0x61, 0xCF, 0x6E, 0xEF, 0xEF, 0x4E,
+  0xD1, 0xFE, 0x12, 0xB5, 0xD4, 0xDF, 0x71, 0xF2, 0xD8, 0x90, 0xC2, 0xB0, 0x8F, 0xB4, 0xE6, 0x38,
+  0xF7, 0x39, 0xEE, 0x99, 0xC1, 0x0B, 0x36, 0xBA, 0x91, 0x74, 0x06, 0x10, 0xBA, 0x06, 0x46, 0xC8,
+  0x20, 0xC3, 0xE3, 0x7D, 0x98, 0xFB, 0x30, 0x57, 0x28, 0x58, 0x2C, 0xC6, 0x30, 0x02, 0xE5, 0x6E,
+  0x9A, 0xF0, 0xD6, 0xEC, 0x75, 0xC9, 0x18, 0x0B, 0xA3, 0x28, 0x69, 0xFE, 0x64, 0x1C, 0xD2, 0x87,
+  0x37, 0x58, 0x1F, 0x2C, 0x02, 0xD5, 0x80, 0xE8, 0x50, 0xBB, 0x19, 0x38, 0xA8, 0xBD, 0xC8, 0x71,
+  0x76, 0x31, 0x04, 0x77, 0x62, 0x0F, 0xBA, 0x21, 0xE4, 0x4B, 0x0C, 0x87, 0x76, 0x83, 0x52, 0x23,
+  0x86, 0x1B, 0x33, 0x68, 0x92, 0xB1, 0x86, 0xCA, 0x78, 0x37, 0xB4, 0x5E, 0x7F, 0x07, 0x35, 0x72,
+  0x02, 0x1D, 0x27, 0x37, 0x53, 0x55, 0x76, 0x6E, 0x13, 0xAA, 0xE2, 0x4B, 0xD2, 0x8F, 0x21, 0x1E,
+  0x01, 0xBF, 0x88, 0x82, 0xBE, 0x00, 0xE6, 0xE9, 0x96, 0x2B, 0x13, 0x96, 0xD9, 0x83, 0xA7, 0x1D,
+  0x6F, 0xE4, 0xB0, 0xE2, 0xDE, 0x38, 0xFC, 0xFF, 0x87, 0x3C, 0x4E, 0x33, 0x11, 0xFA, 0x4D, 0x5F,
+  0x97, 0xE3, 0xEC, 0x11, 0xE8, 0x71, 0x53, 0x17, 0x75, 0x06, 0x00, 0x00,
+};
+
+// style.css: 202 bytes, 175 bytes compressed
+static const uint8_t web_style_css[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x4D, 0x8E, 0x4B, 0x0A, 0xC2, 0x30,
+  0x14, 0x00, 0xF7, 0x3D, 0x45, 0x41, 0xBA, 0x33, 0xD2, 0x8A, 0x8A, 0x26, 0x78, 0x12, 0xE9, 0x22,
+  0x49, 0x93, 0xF6, 0x41, 0xF3, 0x21, 0x79, 0xD1, 0x96, 0x92, 0xBB, 0xDB, 0xA2, 0x82, 0xCB, 0x19,
+  0x66, 0x31, 0xC2, 0x75, 0xF3, 0x62, 0x78, 0xE8, 0xC1, 0xD2, 0x63, 0xED, 0xA7, 0x92, 0x27, 0x74,
+  0x0C, 0xD5, 0x84, 0x84, 0x8F, 0xD0, 0x5B, 0x2A, 0x95, 0x45, 0x15, 0x98, 0x76, 0x16, 0x89, 0xE6,
+  0x06, 0xC6, 0x99, 0x46, 0x6E, 0x23, 0x89, 0x2A, 0x80, 0xCE, 0x05, 0x58, 0x9F, 0xF0, 0x81, 0xB3,
+  0x57, 0x77, 0x9B, 0x8C, 0x50, 0xA1, 0xDD, 0xFF, 0xA9, 0x98, 0x84, 0x01, 0x6C, 0x97, 0x17, 0x74,
+  0x38, 0xD0, 0x73, 0x5D, 0xE5, 0x42, 0x72, 0xFB, 0xE4, 0xF1, 0x6B, 0x6E, 0xE7, 0x8A, 0x19, 0x3E,
+  0x91, 0x0F, 0x5D, 0xEB, 0x75, 0x80, 0x0D, 0x0A, 0xFA, 0x01, 0x69, 0x73, 0xD9, 0x40, 0xB8, 0xD0,
+  0xA9, 0x40, 0x9B, 0x75, 0x2C, 0xBA, 0x11, 0xBA, 0x72, 0x27, 0xA5, 0xCC, 0xC5, 0x41, 0x8F, 0x5B,
+  0xF4, 0x1B, 0x3F, 0xF9, 0x29, 0x17, 0x6F, 0xFC, 0x56, 0x35, 0x74, 0xCA, 0x00, 0x00, 0x00,
+};
+
+// view.html: 2453 bytes, 1156 bytes compressed
+static const uint8_t web_view_html[] PROGMEM = {
+  0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8D, 0x56, 0x6D, 0x6F, 0xDB, 0x36,
+  0x10, 0xFE, 0x9E, 0x5F, 0x71, 0xF1, 0x17, 0xC9, 0x8B, 0x2D, 0xD9, 0xE9, 0x30, 0x0C, 0x8D, 0xEC,
+  0x60, 0x49, 0xD3, 0x6E, 0x40, 0x8A, 0x16, 0x59, 0x06, 0x6C, 0xC8, 0xF2, 0x81, 0xA6, 0xCE, 0x12,
+  0x1B, 0x99, 0x54, 0x49, 0xDA, 0x8E, 0xB1, 0xF6, 0xBF, 0xEF, 0x8E, 0x94, 0x1D, 0xC7, 0x48, 0xBB,
+  0x05, 0x88, 0x4D, 0xDE, 0xFB, 0x3D, 0xBC, 0x17, 0x17, 0xC7, 0x6F, 0x3E, 0x5C, 0xDE, 0xFE, 0xF5,
+  0xF1, 0x0A, 0x6A, 0xBF, 0x68, 0xA6, 0x47, 0xC5, 0xF1, 0x70, 0x08, 0x1F, 0x1B, 0xE3, 0x1D, 0x08,
+  0x98, 0x37, 0xAA, 0xAA, 0x7D, 0x06, 0xB7, 0x35, 0xC2, 0x4C, 0x69, 0x61, 0x37, 0xD0, 0x98, 0x0A,
+  0x94, 0x83, 0xD2, 0xAC, 0x75, 0x63, 0x44, 0x89, 0x25, 0xCC, 0xAD, 0x59, 0x40, 0x4E, 0xF4, 0x8C,
+  0x44, 0x40, 0xE8, 0x12, 0x4A, 0x94, 0x86, 0x39, 0x74, 0xF5, 0xAC, 0x69, 0xCD, 0xDA, 0xA1, 0x1D,
+  0x80, 0x43, 0x64, 0xFD, 0xEC, 0x93, 0xCB, 0x8E, 0x80, 0xFF, 0xD8, 0x6E, 0xF4, 0xC1, 0x36, 0x2B,
+  0xB5, 0xC2, 0xA8, 0xE1, 0xC4, 0x02, 0x61, 0x2D, 0x36, 0x20, 0x1C, 0xCC, 0x8D, 0x7D, 0xB2, 0x8E,
+  0x59, 0x95, 0x41, 0xBE, 0x52, 0xB8, 0x3E, 0x57, 0xE5, 0xE4, 0x15, 0x0C, 0x87, 0x14, 0x71, 0x08,
+  0xBC, 0xA8, 0x51, 0x94, 0xD3, 0x62, 0x81, 0x5E, 0x80, 0x26, 0xF5, 0x49, 0x8F, 0xA5, 0x5A, 0x63,
+  0x7D, 0x0F, 0xA4, 0xD1, 0x1E, 0xB5, 0x9F, 0xF4, 0xD6, 0xAA, 0xF4, 0xF5, 0xA4, 0xC4, 0x95, 0x92,
+  0x38, 0x0C, 0x97, 0x81, 0xD2, 0xCA, 0x2B, 0xD1, 0x0C, 0x9D, 0x14, 0x0D, 0x4E, 0xC6, 0xD9, 0xA8,
+  0x37, 0x2D, 0xBC, 0xF2, 0x0D, 0x4E, 0x6F, 0x8C, 0x7C, 0x40, 0x7F, 0x6D, 0xAA, 0x0A, 0x6D, 0x91,
+  0x47, 0xDA, 0x51, 0xD1, 0x28, 0xFD, 0x00, 0x16, 0x9B, 0x49, 0xCF, 0xF9, 0x4D, 0x83, 0xAE, 0x46,
+  0x24, 0x0F, 0xB5, 0xC5, 0xF9, 0xA4, 0x97, 0x07, 0x52, 0x26, 0x9D, 0x23, 0x23, 0x4E, 0x5A, 0xD5,
+  0x7A, 0x70, 0x56, 0x12, 0xA3, 0x25, 0x40, 0x29, 0x6D, 0x22, 0xE7, 0x91, 0x7E, 0xC0, 0x8F, 0xA8,
+  0xEC, 0xB3, 0xF3, 0x90, 0xCF, 0x51, 0x31, 0x33, 0xE5, 0x66, 0x5A, 0x88, 0xAD, 0x87, 0xDE, 0xF4,
+  0x42, 0xC8, 0x87, 0x22, 0x17, 0x53, 0x20, 0x22, 0x61, 0xD0, 0x73, 0x62, 0x85, 0x14, 0x80, 0x2A,
+  0x4B, 0xD4, 0xD3, 0xDF, 0xE9, 0xC2, 0xCC, 0xA3, 0xA2, 0x54, 0xAB, 0xC0, 0x56, 0x7A, 0x6E, 0x7A,
+  0xD3, 0x37, 0xDD, 0x73, 0x29, 0x5D, 0x15, 0x39, 0xB1, 0xA2, 0xC0, 0xF4, 0x97, 0x86, 0xD2, 0x5A,
+  0x96, 0x08, 0xE9, 0xA2, 0x1F, 0xE9, 0x85, 0x14, 0x7A, 0x45, 0xA8, 0xB3, 0xAA, 0x68, 0x28, 0xB3,
+  0x08, 0x59, 0xEF, 0xE7, 0xD1, 0x88, 0x9C, 0x20, 0x3F, 0xD5, 0xA4, 0x37, 0xFE, 0x89, 0x51, 0xCA,
+  0xA3, 0xE8, 0xD6, 0x94, 0x94, 0xD8, 0xA0, 0x15, 0x5E, 0x19, 0x0D, 0x69, 0xF5, 0x92, 0x39, 0x29,
+  0xFF, 0xB7, 0xB9, 0xA0, 0x80, 0x54, 0x0E, 0x3E, 0x80, 0x12, 0x23, 0xEE, 0xA0, 0x39, 0x5A, 0x09,
+  0x0B, 0x9C, 0x16, 0x4C, 0xA8, 0x0C, 0xE5, 0x72, 0x41, 0x52, 0x59, 0x85, 0xFE, 0xAA, 0x41, 0x3E,
+  0x5E, 0x6C, 0x7E, 0x2B, 0xD3, 0x84, 0xF9, 0x49, 0xFF, 0x2C, 0xC8, 0x3E, 0xD6, 0x96, 0x44, 0x35,
+  0xAE, 0xE1, 0xCF, 0xF7, 0xD7, 0xBF, 0x7A, 0xDF, 0xDE, 0xE0, 0xE7, 0x25, 0x3A, 0x9F, 0x12, 0x9F,
+  0x78, 0x99, 0x45, 0xD7, 0x1A, 0xED, 0xF0, 0x76, 0xD3, 0x22, 0x09, 0x26, 0xC2, 0x5A, 0xB1, 0x99,
+  0x2D, 0xE7, 0x73, 0xB4, 0x49, 0x94, 0x30, 0xBA, 0xB5, 0xA6, 0x22, 0x39, 0x47, 0xFC, 0xF9, 0x52,
+  0x4B, 0xCE, 0x32, 0xC5, 0x3E, 0xFC, 0x13, 0x02, 0xC9, 0x3C, 0x3E, 0xFA, 0xCB, 0x58, 0x64, 0x6C,
+  0x60, 0x0F, 0xED, 0xD7, 0x90, 0xC0, 0x09, 0xBC, 0x17, 0xBE, 0xCE, 0xAC, 0x59, 0xEA, 0x32, 0xC5,
+  0xAC, 0x6B, 0x9B, 0x1C, 0xC6, 0xA3, 0xD3, 0x1F, 0xFB, 0xC4, 0x4D, 0xE0, 0xE1, 0x22, 0x39, 0x83,
+  0xAF, 0x5B, 0x5F, 0x68, 0xAD, 0xB1, 0xFB, 0x8E, 0xFE, 0xCB, 0x0F, 0xCC, 0x85, 0x6A, 0xB0, 0xDC,
+  0xB7, 0x11, 0xC8, 0xCF, 0x4D, 0x50, 0xCB, 0xA9, 0x39, 0xA4, 0xCC, 0x77, 0x5E, 0xF8, 0xA5, 0x83,
+  0xE3, 0x09, 0x9C, 0x8E, 0x46, 0x91, 0x05, 0x2F, 0x7A, 0x78, 0x1B, 0x9B, 0x53, 0x1B, 0x4F, 0x7D,
+  0x48, 0xE1, 0x13, 0x1E, 0x2C, 0x6A, 0xD1, 0x2F, 0xAD, 0xE6, 0xF3, 0x57, 0xFA, 0x67, 0x8C, 0xA9,
+  0x80, 0xF9, 0xEA, 0x69, 0x42, 0x44, 0x6B, 0x3C, 0x27, 0x26, 0xDD, 0x24, 0xA0, 0x1E, 0x4A, 0xF7,
+  0x81, 0xEE, 0x07, 0x4D, 0x90, 0xC2, 0xCB, 0x1A, 0x02, 0x8C, 0xDF, 0x0A, 0x00, 0xBF, 0xE5, 0x4F,
+  0x13, 0x93, 0x9B, 0xC6, 0xAB, 0x05, 0x21, 0x8A, 0xBA, 0xA2, 0x56, 0x86, 0x72, 0xD9, 0xD5, 0x1F,
+  0xBD, 0x36, 0x9C, 0xEF, 0xF8, 0x77, 0x1A, 0x86, 0x30, 0xBE, 0xA7, 0x8F, 0x1D, 0x65, 0x74, 0x0F,
+  0xAF, 0x61, 0x74, 0xD6, 0x19, 0x5B, 0x88, 0x47, 0xEA, 0x04, 0xD2, 0x1A, 0x0D, 0xC2, 0x59, 0x4A,
+  0x3E, 0x33, 0x97, 0x87, 0x4F, 0x1A, 0xEA, 0x2D, 0x50, 0xE8, 0xAB, 0x00, 0x4D, 0x5F, 0x27, 0x27,
+  0xDB, 0xA0, 0x77, 0xBA, 0xE1, 0x8D, 0xE9, 0x96, 0x46, 0xCA, 0x20, 0x38, 0xA3, 0x16, 0xBA, 0x53,
+  0xF7, 0xFD, 0xB3, 0x9D, 0x68, 0x30, 0xFD, 0x4C, 0x54, 0xCA, 0x41, 0x24, 0xB8, 0xCF, 0xD6, 0xA7,
+  0x41, 0x49, 0x4A, 0x0A, 0x90, 0xF4, 0xE0, 0x07, 0x78, 0x7E, 0x3F, 0xD9, 0xDD, 0xC7, 0x07, 0xFC,
+  0xF1, 0x01, 0xFF, 0xF4, 0x80, 0x1F, 0xEE, 0xFD, 0xFE, 0x16, 0xC2, 0x17, 0xA0, 0xD6, 0xA1, 0x12,
+  0x69, 0xF2, 0xB6, 0x34, 0xD5, 0xC0, 0xAC, 0xD0, 0x86, 0xD2, 0xDD, 0x62, 0x9A, 0x79, 0xF3, 0x56,
+  0x3D, 0x62, 0x99, 0x8E, 0x63, 0xC9, 0xBA, 0x00, 0x15, 0x88, 0x6E, 0x82, 0xC4, 0x3A, 0x8F, 0xA9,
+  0x1F, 0x8A, 0x2E, 0x3A, 0xD1, 0xBD, 0x09, 0x11, 0xC4, 0xF7, 0x40, 0x39, 0x54, 0xA9, 0xD8, 0x5A,
+  0x00, 0x43, 0x1A, 0x6B, 0x97, 0xAD, 0xA7, 0x86, 0x39, 0x27, 0x7A, 0xDA, 0x0A, 0x4B, 0x9B, 0xC9,
+  0xCC, 0xC3, 0x9A, 0xE0, 0x1A, 0x13, 0x16, 0x61, 0x27, 0xD3, 0x4F, 0xE8, 0x59, 0x93, 0x24, 0xA4,
+  0xC9, 0xB5, 0xAE, 0x61, 0x0A, 0xBB, 0xFA, 0xE6, 0x19, 0x9C, 0x26, 0x14, 0x70, 0x32, 0x80, 0xBB,
+  0xEE, 0x71, 0xEE, 0x07, 0xBB, 0x9A, 0xE8, 0x1E, 0xA9, 0x93, 0x92, 0x32, 0x19, 0x6C, 0xC1, 0x3B,
+  0x90, 0xD9, 0x96, 0x60, 0x1C, 0x4F, 0xDF, 0x1B, 0x42, 0x51, 0x22, 0x86, 0xC3, 0x26, 0xE2, 0x3D,
+  0xA3, 0xA2, 0xBA, 0x12, 0xB2, 0x4E, 0x9F, 0x0D, 0x92, 0xE0, 0x9C, 0xCD, 0xF2, 0xF4, 0xDB, 0xB3,
+  0x29, 0x2D, 0x0A, 0x8F, 0x9D, 0xD9, 0x34, 0x21, 0x6E, 0xD2, 0x45, 0x4A, 0xC7, 0xC3, 0x6E, 0xA1,
+  0x32, 0xD9, 0x21, 0xF9, 0xAA, 0x7B, 0xA7, 0xF8, 0x32, 0x48, 0x15, 0x12, 0xD5, 0xBA, 0x20, 0x44,
+  0xDB, 0xA2, 0x2E, 0x2F, 0x6B, 0xD5, 0x94, 0x29, 0x59, 0x8A, 0x99, 0x85, 0xCF, 0x3C, 0x0F, 0x7B,
+  0x99, 0xC1, 0xAD, 0x69, 0x74, 0x8B, 0x86, 0x22, 0x28, 0x37, 0x30, 0x43, 0x5A, 0xCE, 0x4F, 0x6B,
+  0x9F, 0xB6, 0xB9, 0x01, 0x15, 0xF6, 0x36, 0x6F, 0xA0, 0x92, 0x26, 0xBB, 0xAF, 0xCD, 0xD2, 0xEF,
+  0x44, 0x68, 0xF8, 0x31, 0x5F, 0x54, 0x42, 0xE9, 0x0E, 0x31, 0x16, 0xFC, 0x1E, 0x5E, 0xCC, 0x8F,
+  0xD9, 0xF1, 0x29, 0xE3, 0x95, 0x47, 0xE2, 0x7F, 0xDC, 0x5C, 0x77, 0x28, 0x7C, 0x98, 0x7D, 0x42,
+  0xE9, 0xE9, 0x9E, 0xF2, 0x30, 0xBF, 0x68, 0xCC, 0x2C, 0xBD, 0xDB, 0x9F, 0x2B, 0x5D, 0x81, 0x07,
+  0xE5, 0x6D, 0x18, 0x3C, 0xC5, 0x28, 0x95, 0xAE, 0x9E, 0x64, 0xAC, 0x65, 0x87, 0xC2, 0x4A, 0x6E,
+  0x41, 0x1A, 0x40, 0x69, 0x4E, 0xBB, 0x26, 0xFD, 0xBB, 0x3C, 0xE9, 0xE7, 0x7D, 0xF8, 0xF2, 0x05,
+  0xEE, 0x12, 0x7A, 0xF9, 0x24, 0xB9, 0xEF, 0x13, 0x62, 0x8C, 0x20, 0xFF, 0xEE, 0x48, 0x9E, 0x62,
+  0x0A, 0x7B, 0x96, 0x27, 0xAB, 0x68, 0x1C, 0x4D, 0xA7, 0xED, 0xC0, 0x25, 0x30, 0xD3, 0xE4, 0xDD,
+  0xD5, 0x2D, 0xEB, 0x6E, 0x7F, 0xAD, 0x24, 0xA1, 0x1F, 0x9F, 0xB9, 0xEC, 0x36, 0x8E, 0x23, 0xE8,
+  0x79, 0xFB, 0xEC, 0xAD, 0xFB, 0xB8, 0xE7, 0xF3, 0xF8, 0x23, 0xEC, 0x5F, 0xD6, 0x31, 0xA6, 0x20,
+  0x95, 0x09, 0x00, 0x00,
+};
+
+static const web_asset_t web_assets[] = {
+  { "/", "text/html", web_index_html, sizeof(web_index_html), "\"ba6eb93d4acb6ca7\"" },
+  { "/live", "text/html", web_live_html, sizeof(web_live_html), "\"5d2996089a382cf2\"" },
+  { "/log.js", "application/javascript", web_log_js, sizeof(web_log_js), "\"b86bb485c61fc252\"" },
+  { "/plot.js", "application/javascript", web_plot_js, sizeof(web_plot_js), "\"55f719b1994113d6\"" },
+  { "/style.css", "text/css", web_style_css, sizeof(web_style_css), "\"84dce52d82d8ea9d\"" },
+  { "/view", "text/html", web_view_html, sizeof(web_view_html), "\"e54e510eec7b1666\"" },
+};
+
+#endif // __web_assets_h__
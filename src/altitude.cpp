@@ -0,0 +1,101 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifdef ARDUINO
+#include <pgmspace.h>
+#else
+#define PROGMEM
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#endif
+
+#include "altitude.h"
+
+#define ALTITUDE_TABLE_SEGMENTS_LOG2    (5U) // Every octave of pressure is split into 32 segments
+#define ALTITUDE_TABLE_FIRST_OCTAVE     (9U) // 2^9 = ALTITUDE_MIN_PRESSURE
+#define ALTITUDE_TABLE_OCTAVE_SIZE      ((1U << ALTITUDE_TABLE_SEGMENTS_LOG2) + 2U) // Two extra points, so the last segment can be interpolated
+
+// Altitude in mm at the start of every segment. Generated from 44330 * (1 - (p / 101325)^(1 / 5.255)) rounded to the nearest mm.
+// The table can be regenerated using: ./bench_altitude --table
+static const int32_t altitude_table[] PROGMEM = {
+  // 512 - 1024 Pa
+  28123266, 28028086, 27935213, 27844526, 27755914, 27669273, 27584508, 27501530, 27420257,
+  27340613, 27262527, 27185932, 27110766, 27036971, 26964492, 26893278, 26823280, 26754453,
+  26686754, 26620143, 26554581, 26490032, 26426462, 26363838, 26302130, 26241307, 26181342,
+  26122209, 26063881, 26006336, 25949549, 25893499, 25838165, 25783527,
+  // 1024 - 2048 Pa
+  25838165, 25729565, 25623598, 25520125, 25419018, 25320161, 25223444, 25128767, 25036035,
+  24945161, 24856065, 24768671, 24682907, 24598706, 24516008, 24434753, 24354885, 24276354,
+  24199110, 24123107, 24048301, 23974651, 23902118, 23830664, 23760254, 23690856, 23622436,
+  23554965, 23488414, 23422755, 23357961, 23294009, 23230873, 23168530,
+  // 2048 - 4096 Pa
+  23230873, 23106960, 22986052, 22867989, 22752627, 22639832, 22529478, 22421451, 22315644,
+  22211958, 22110300, 22010583, 21912726, 21816654, 21722295, 21629583, 21538455, 21448851,
+  21360715, 21273996, 21188643, 21104608, 21021848, 20940320, 20859983, 20780799, 20702733,
+  20625748, 20549813, 20474896, 20400967, 20327998, 20255960, 20184827,
+  // 4096 - 8192 Pa
+  20255960, 20114576, 19976620, 19841911, 19710283, 19581584, 19455670, 19332412, 19211687,
+  19093381, 18977389, 18863612, 18751958, 18642340, 18534677, 18428893, 18324916, 18222678,
+  18122116, 18023169, 17925782, 17829899, 17735469, 17642446, 17550781, 17460433, 17371359,
+  17283521, 17196879, 17111399, 17027046, 16943788, 16861593, 16780431,
+  // 8192 - 16384 Pa
+  16861593, 16700275, 16542867, 16389165, 16238978, 16092132, 15948465, 15807828, 15670081,
+  15535094, 15402748, 15272929, 15145532, 15020458, 14897615, 14776916, 14658278, 14541625,
+  14426884, 14313986, 14202867, 14093465, 13985721, 13879581, 13774993, 13671906, 13570273,
+  13470049, 13371191, 13273659, 13177413, 13082415, 12988631, 12896026,
+  // 16384 - 32768 Pa
+  12988631, 12804567, 12624966, 12449592, 12278229, 12110678, 11946755, 11786288, 11629119,
+  11475100, 11324093, 11175970, 11030611, 10887902, 10747738, 10610020, 10474655, 10341554,
+  10210635, 10081819, 9955032, 9830205, 9707270, 9586165, 9466830, 9349207, 9233245,
+  9118890, 9006093, 8894809, 8784992, 8676600, 8569593, 8463931,
+  // 32768 - 65536 Pa
+  8569593, 8359577, 8154652, 7954551, 7759026, 7567852, 7380816, 7197724, 7018394,
+  6842659, 6670360, 6501353, 6335498, 6172667, 6012741, 5855605, 5701154, 5549287,
+  5399908, 5252930, 5108266, 4965838, 4825570, 4687389, 4551228, 4417022, 4284709,
+  4154230, 4025529, 3898554, 3773254, 3649579, 3527484, 3406924,
+  // 65536 - 131072 Pa
+  3527484, 3287856, 3054037, 2825723, 2602630, 2384500, 2171093, 1962185, 1757571,
+  1557057, 1360466, 1167628, 978388, 792599, 610124, 430832, 254604, 81324,
+  -89117, -256819, -421879, -584389, -744435, -902099, -1057458, -1210587, -1361556,
+  -1510432, -1657279, -1802157, -1945124, -2086237, -2225547, -2363106,
+};
+static_assert(sizeof(altitude_table) == 8 * ALTITUDE_TABLE_OCTAVE_SIZE * sizeof(int32_t), "The table must cover 512 to 131071 Pa");
+
+// Returns the altitude in mm relative to the standard pressure at sea level (101325 Pa)
+int32_t Altitude_FromPressure(int32_t pressure) {
+  if (pressure < ALTITUDE_MIN_PRESSURE)
+    pressure = ALTITUDE_MIN_PRESSURE;
+  else if (pressure > ALTITUDE_MAX_PRESSURE)
+    pressure = ALTITUDE_MAX_PRESSURE;
+
+  // Find the octave and the segment within it. The segments are wider at higher pressure, where the curve is flatter
+  uint8_t octave = 31 - __builtin_clz(pressure);
+  uint8_t shift = octave - ALTITUDE_TABLE_SEGMENTS_LOG2; // The width of a segment is 2^shift Pa
+  uint32_t offset = pressure - (1UL << octave);
+  const int32_t *p = &altitude_table[(octave - ALTITUDE_TABLE_FIRST_OCTAVE) * ALTITUDE_TABLE_OCTAVE_SIZE + (offset >> shift)];
+  int32_t y0 = pgm_read_dword(p), y1 = pgm_read_dword(p + 1), y2 = pgm_read_dword(p + 2);
+  int32_t x = offset & ((1UL << shift) - 1);
+
+  // Newton forward interpolation: y0 + x * (y1 - y0) / w + x * (x - w) * (y2 - 2 * y1 + y0) / (2 * w^2)
+  int32_t linear = ((y1 - y0) * x + (1L << (shift - 1))) >> shift;
+  int64_t quadratic = (int64_t)(y2 - 2 * y1 + y0) * x * (x - (1L << shift));
+  return y0 + linear + (int32_t)((quadratic + (1LL << (2 * shift))) >> (2 * shift + 1));
+}
+
+// Returns the altitude in mm above the ground reference pressure
+int32_t Altitude_AboveGround(int32_t pressure, int32_t ground_pressure) {
+  return Altitude_FromPressure(pressure) - Altitude_FromPressure(ground_pressure);
+}
@@ -0,0 +1,68 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include "auto_range.h"
+
+void AutoRange_Init(auto_range_t *auto_range, const mpu6500_range_t *range, uint32_t timestamp) {
+  auto_range->range = *range;
+  auto_range->gyro_timestamp = auto_range->acc_timestamp = timestamp;
+}
+
+// Returns the largest magnitude of the three axes
+static uint16_t AutoRange_Peak(const sensorRaw_t *raw) {
+  uint16_t peak = 0;
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    uint16_t magnitude = raw->data[axis] < 0 ? (uint16_t)(-(int32_t)raw->data[axis]) : (uint16_t)raw->data[axis];
+    if (magnitude > peak)
+      peak = magnitude;
+  }
+  return peak;
+}
+
+// Updates the range of a single sensor. Returns true if it changed
+static bool AutoRange_UpdateSensor(uint8_t *range, uint8_t min, uint8_t max, uint32_t *timestamp, uint32_t now, uint16_t peak) {
+  if (peak >= AUTO_RANGE_UP_THRESHOLD) {
+    *timestamp = now;
+    if (*range == max)
+      return false;
+    *range = max;
+    return true;
+  }
+  if (peak >= AUTO_RANGE_DOWN_THRESHOLD || *range <= min) {
+    *timestamp = now;
+    return false;
+  }
+  if ((uint32_t)(now - *timestamp) < AUTO_RANGE_HOLD_MICROS)
+    return false;
+  (*range)--;
+  *timestamp = now;
+  return true;
+}
+
+// Should be called for every IMU sample with the range the readings were taken with. Readings taken before the last
+// change are ignored. Returns true if the range should be changed to "auto_range->range"
+bool AutoRange_Update(auto_range_t *auto_range, uint32_t timestamp, const mpu6500_range_t *range, const sensorRaw_t *gyro, const sensorRaw_t *acc) {
+  if (!MPU6500_RangeEquals(range, &auto_range->range)) {
+    auto_range->gyro_timestamp = auto_range->acc_timestamp = timestamp; // The hold time starts when the new range is used
+    return false;
+  }
+  bool changed = AutoRange_UpdateSensor(&auto_range->range.gyro, AUTO_RANGE_MIN_GYRO, MPU6500_GYRO_RANGE_2000,
+    &auto_range->gyro_timestamp, timestamp, AutoRange_Peak(gyro));
+  changed |= AutoRange_UpdateSensor(&auto_range->range.acc, AUTO_RANGE_MIN_ACC, MPU6500_ACC_RANGE_16,
+    &auto_range->acc_timestamp, timestamp, AutoRange_Peak(acc));
+  return changed;
+}
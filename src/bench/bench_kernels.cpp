@@ -0,0 +1,58 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Measures the kernels of the data path on the device in CPU cycles, see bench_kernels.h. The result is printed
+// as CSV in the same format as tools/bench_kernels.cpp with the number of cycles added, so the two can be compared.
+// The WiFi is turned off, so it does not interrupt the measurements.
+// Build and run using: pio run -e bench_kernels -t upload && pio device monitor -e bench_kernels
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+
+#include "bench_kernels.h"
+
+#define BENCH_OPS                   (1024U) // Operations in every run. The slowest kernel takes a few ms, so the watchdog is fed in between
+#define BENCH_RUNS                  (5U) // The fastest run is used
+
+static volatile uint32_t bench_sink; // Keeps the checksums, so the kernels are not optimised away
+
+void setup() {
+  Serial.begin(74880);
+  WiFi.mode(WIFI_OFF);
+  Serial.printf("\nKernel benchmark at %u MHz\n", ESP.getCpuFreqMHz());
+
+  BenchKernels_Init();
+  Serial.println(F("kernel,ops,ns_per_op,cycles_per_op"));
+  for (const bench_kernel_t &kernel : bench_kernels) {
+    kernel.run(BENCH_OPS); // Load the code into the instruction cache
+    uint32_t best = UINT32_MAX;
+    for (uint8_t run = 0; run < BENCH_RUNS; run++) {
+      yield(); // Feed the watchdog
+      uint32_t start = ESP.getCycleCount();
+      bench_sink = bench_sink + kernel.run(BENCH_OPS);
+      uint32_t cycles = ESP.getCycleCount() - start;
+      if (cycles < best)
+        best = cycles;
+    }
+    const float cycles = (float)best / BENCH_OPS;
+    Serial.printf("%s,%u,%.1f,%.1f\n", kernel.name, BENCH_OPS, cycles * 1000.0f / ESP.getCpuFreqMHz(), cycles);
+  }
+  Serial.println(F("Done"));
+}
+
+void loop() {
+}
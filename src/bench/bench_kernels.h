@@ -0,0 +1,223 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// The kernels of the data path with fixed synthetic inputs. They are shared by the benchmark on the computer,
+// see tools/bench_kernels.cpp, and on the device, see bench_kernels.cpp, so the same work is measured on both
+
+#ifndef __bench_kernels_h__
+#define __bench_kernels_h__
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "altitude.h"
+#include "csv_encoder.h"
+#include "estimator.h"
+#include "log_codec.h"
+#include "log_format.h"
+#include "mpu6500.h"
+#include "ms5611.h"
+
+#define BENCH_KERNELS_INPUTS        (64U) // Every kernel cycles through this many inputs. This must be a power of two
+#define BENCH_KERNELS_BARO_INTERVAL (8U) // The pressure changes every 8th sample, as the barometer is sampled slower than the IMU
+
+typedef struct {
+  const char *name;
+  uint32_t (*run)(uint32_t ops); /*!< Runs the kernel "ops" times and returns a checksum, so the work is not optimised away */
+} bench_kernel_t;
+
+static log_header_t bench_header;
+static log_record_t bench_records[BENCH_KERNELS_INPUTS]; // Samples of a slowly changing flight, so they compress like a real log
+static uint32_t bench_d1[BENCH_KERNELS_INPUTS], bench_d2[BENCH_KERNELS_INPUTS]; // Raw readings of the MS5611, some of them below 20 C
+static uint8_t bench_encoded[BENCH_KERNELS_INPUTS * LOG_CODEC_MAX_RECORD_SIZE];
+static size_t bench_encoded_size;
+
+static mpu6500_t bench_mpu6500;
+static ms5611_t bench_ms5611;
+static csv_encoder_t bench_csv_encoder;
+static estimator_t bench_estimator;
+static uint32_t bench_timestamp; // Time of the last sample given to the estimator in us
+
+static uint32_t BenchKernels_Random(uint32_t *seed) {
+  *seed ^= *seed << 13;
+  *seed ^= *seed >> 17;
+  *seed ^= *seed << 5;
+  return *seed;
+}
+
+// Generates the inputs. This must be called before any kernel is run
+static void BenchKernels_Init() {
+  memset(&bench_header, 0, sizeof(bench_header));
+  bench_header.magic = LOG_MAGIC;
+  bench_header.version = LOG_VERSION;
+  bench_header.header_size = sizeof(log_header_t);
+  bench_header.record_size = sizeof(log_record_t);
+  bench_header.sample_rate = 1000;
+  bench_header.gyroScaleFactor = MPU6500_GetGyroScaleFactor(MPU6500_GYRO_RANGE);
+  bench_header.accScaleFactor = MPU6500_GetAccScaleFactor(MPU6500_ACC_RANGE);
+  bench_header.ground_pressure = 101325;
+
+  uint32_t seed = 0x12345678;
+  int32_t pressure = 101325;
+  for (uint32_t i = 0; i < BENCH_KERNELS_INPUTS; i++) {
+    log_record_t *record = &bench_records[i];
+    memset(record, 0, sizeof(log_record_t));
+    record->timestamp = 1000 * i;
+    record->type = LOG_RECORD_SAMPLE;
+    if (i % BENCH_KERNELS_BARO_INTERVAL == 0)
+      pressure -= 10 + BenchKernels_Random(&seed) % 8;
+    LogFormat_SetPressure(record, pressure);
+    for (uint8_t axis = 0; axis < 3; axis++) {
+      record->sample.gyro.data[axis] = (int16_t)(100 * axis + (int32_t)(BenchKernels_Random(&seed) % 64) - 32);
+      record->sample.acc.data[axis] = (int16_t)((axis == 2 ? 6 * 2048 : 0) + (int32_t)(BenchKernels_Random(&seed) % 64) - 32);
+    }
+    bench_d1[i] = 8500000UL + BenchKernels_Random(&seed) % 600000UL;
+    bench_d2[i] = 8200000UL + BenchKernels_Random(&seed) % 400000UL;
+  }
+
+  log_codec_state_t state;
+  LogCodec_Reset(&state);
+  bench_encoded_size = 0;
+  for (uint32_t i = 0; i < BENCH_KERNELS_INPUTS; i++)
+    bench_encoded_size += LogCodec_Encode(&state, &bench_records[i], &bench_encoded[bench_encoded_size]);
+
+  // Typical calibration values from the datasheet
+  static const uint16_t prom_c[6] = { 40127, 36924, 23317, 23282, 33464, 28312 };
+  memcpy(bench_ms5611.prom_c, prom_c, sizeof(prom_c));
+  MS5611_CalculateTemperature(&bench_ms5611, bench_d2[0]);
+
+  bench_mpu6500.gyroResolution = MPU6500_GetGyroResolution(MPU6500_GYRO_RANGE);
+  bench_mpu6500.accResolution = MPU6500_GetAccResolution(MPU6500_ACC_RANGE);
+  CsvEncoder_Init(&bench_csv_encoder, &bench_header);
+  Estimator_Init(&bench_estimator, bench_header.gyroScaleFactor, bench_header.accScaleFactor, bench_header.ground_pressure);
+}
+
+// Converts the raw IMU readings into SI units, see MPU6500_ConvertData()
+static uint32_t BenchKernels_ImuConvert(uint32_t ops) {
+  float sum = 0;
+  for (uint32_t i = 0; i < ops; i++) {
+    const log_record_t *record = &bench_records[i & (BENCH_KERNELS_INPUTS - 1)];
+    memcpy(&bench_mpu6500.gyroRaw, &record->sample.gyro, sizeof(sensorRaw_t));
+    memcpy(&bench_mpu6500.accRaw, &record->sample.acc, sizeof(sensorRaw_t));
+    MPU6500_ConvertData(&bench_mpu6500);
+    sum += bench_mpu6500.accSi.data[2] + bench_mpu6500.gyroRate.data[0];
+  }
+  return (uint32_t)(int32_t)sum;
+}
+
+// The temperature compensation of the MS5611 using 64-bit math
+static uint32_t BenchKernels_Ms5611Temperature(uint32_t ops) {
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < ops; i++) {
+    MS5611_CalculateTemperature(&bench_ms5611, bench_d2[i & (BENCH_KERNELS_INPUTS - 1)]);
+    sum += (uint32_t)bench_ms5611.TEMP;
+  }
+  return sum;
+}
+
+// The pressure compensation of the MS5611 using 64-bit math
+static uint32_t BenchKernels_Ms5611Pressure(uint32_t ops) {
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < ops; i++) {
+    MS5611_CalculatePressure(&bench_ms5611, bench_d1[i & (BENCH_KERNELS_INPUTS - 1)]);
+    sum += (uint32_t)bench_ms5611.pressure;
+  }
+  return sum;
+}
+
+// The fixed point altitude conversion, see altitude.h
+static uint32_t BenchKernels_Altitude(uint32_t ops) {
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < ops; i++)
+    sum += (uint32_t)Altitude_FromPressure(LogFormat_GetPressure(&bench_records[i & (BENCH_KERNELS_INPUTS - 1)]));
+  return sum;
+}
+
+// The altitude conversion previously used by the MS5611 driver, as a reference for the fixed point version
+static uint32_t BenchKernels_AltitudePowf(uint32_t ops) {
+  float sum = 0;
+  for (uint32_t i = 0; i < ops; i++) {
+    float pressure = (float)LogFormat_GetPressure(&bench_records[i & (BENCH_KERNELS_INPUTS - 1)]);
+    sum += 44330.0f * (1.0f - powf(pressure / 101325.0f, 1.0f / 5.255f));
+  }
+  return (uint32_t)(int32_t)sum;
+}
+
+// Formats a sample as a row of the CSV file sent by the web server
+static uint32_t BenchKernels_CsvRow(uint32_t ops) {
+  char row[CSV_ENCODER_MAX_ROW_SIZE];
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < ops; i++)
+    sum += CsvEncoder_Format(&bench_csv_encoder, &bench_records[i & (BENCH_KERNELS_INPUTS - 1)], row);
+  return sum;
+}
+
+// Compresses a record as the log writer does
+static uint32_t BenchKernels_CodecEncode(uint32_t ops) {
+  uint8_t out[LOG_CODEC_MAX_RECORD_SIZE];
+  log_codec_state_t state;
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < ops; i++) {
+    if ((i & (BENCH_KERNELS_INPUTS - 1)) == 0)
+      LogCodec_Reset(&state); // Start a new block
+    sum += LogCodec_Encode(&state, &bench_records[i & (BENCH_KERNELS_INPUTS - 1)], out);
+  }
+  return sum;
+}
+
+// Decompresses a record as the log reader does
+static uint32_t BenchKernels_CodecDecode(uint32_t ops) {
+  log_record_t record;
+  log_codec_state_t state;
+  size_t pos = 0;
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < ops; i++) {
+    if ((i & (BENCH_KERNELS_INPUTS - 1)) == 0) {
+      LogCodec_Reset(&state); // Start a new block
+      pos = 0;
+    }
+    pos += LogCodec_Decode(&state, &bench_encoded[pos], bench_encoded_size - pos, &record);
+    sum += record.timestamp;
+  }
+  return sum;
+}
+
+// Updates the attitude, altitude and velocity estimate with an IMU sample
+static uint32_t BenchKernels_EstimatorImu(uint32_t ops) {
+  for (uint32_t i = 0; i < ops; i++) {
+    const log_record_t *record = &bench_records[i & (BENCH_KERNELS_INPUTS - 1)];
+    sensorRaw_t gyro = record->sample.gyro, acc = record->sample.acc;
+    bench_timestamp += 1000;
+    Estimator_UpdateImu(&bench_estimator, bench_timestamp, &gyro, &acc);
+  }
+  return (uint32_t)Estimator_GetAltitude(&bench_estimator);
+}
+
+static const bench_kernel_t bench_kernels[] = {
+  { "imu_convert", BenchKernels_ImuConvert },
+  { "ms5611_temperature", BenchKernels_Ms5611Temperature },
+  { "ms5611_pressure", BenchKernels_Ms5611Pressure },
+  { "altitude", BenchKernels_Altitude },
+  { "altitude_powf", BenchKernels_AltitudePowf },
+  { "csv_row", BenchKernels_CsvRow },
+  { "codec_encode", BenchKernels_CodecEncode },
+  { "codec_decode", BenchKernels_CodecDecode },
+  { "estimator_imu", BenchKernels_EstimatorImu },
+};
+
+#endif // __bench_kernels_h__
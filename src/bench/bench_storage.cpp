@@ -0,0 +1,119 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Measures the write latency and usable capacity of SPIFFS and LittleFS on the device. The file system is filled
+// with buffers of the same size as the log writer uses, and the time of every write is compared with the time it
+// takes to fill a buffer at 1 kHz, as a slower write means that samples are dropped.
+// Note that the file system is formatted for every backend, so the log file is lost.
+// Build and run using: pio run -e bench_storage -t upload && pio device monitor -e bench_storage
+
+#include <Arduino.h>
+#include <FS.h>
+#include <LittleFS.h>
+
+#include "log_format.h"
+#include "log_writer.h"
+
+#define BENCH_SAMPLE_RATE           (1000U) // Hz
+#define BENCH_COMPRESSED_SIZE       (10U) // Average bytes per sample when the log is compressed
+
+static constexpr const char *bench_filename = "/bench.bin";
+static uint8_t buffer[LOG_WRITER_BUFFER_SIZE];
+
+static int compareLatency(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+  return x < y ? -1 : x > y;
+}
+
+// Fills the buffer with pseudo random data, which is similar to a compressed log
+static void fillBuffer(uint32_t *seed) {
+  for (size_t i = 0; i < sizeof(buffer); i++) {
+    *seed ^= *seed << 13;
+    *seed ^= *seed >> 17;
+    *seed ^= *seed << 5;
+    buffer[i] = (uint8_t)*seed;
+  }
+}
+
+static void benchBackend(const char *name, fs::FS &fs) {
+  Serial.printf("\n%s\n", name);
+  if (!fs.begin() || !fs.format()) {
+    Serial.println(F("Failed to format the file system"));
+    return;
+  }
+  FSInfo fs_info;
+  fs.info(fs_info);
+  Serial.printf("Total: %u bytes, block size: %u bytes, page size: %u bytes\n", fs_info.totalBytes, fs_info.blockSize, fs_info.pageSize);
+
+  const size_t max_writes = fs_info.totalBytes / sizeof(buffer) + 1;
+  uint32_t *latency = new uint32_t[max_writes];
+  File file = fs.open(bench_filename, "w");
+  if (!latency || !file) {
+    Serial.println(F("Failed to open the file"));
+    delete[] latency;
+    return;
+  }
+
+  // Write until the file system is full
+  const uint32_t raw_deadline = (uint64_t)sizeof(buffer) * 1000000UL / (sizeof(log_record_t) * BENCH_SAMPLE_RATE);
+  const uint32_t compressed_deadline = (uint64_t)sizeof(buffer) * 1000000UL / (BENCH_COMPRESSED_SIZE * BENCH_SAMPLE_RATE);
+  uint32_t seed = 0x12345678, writes = 0, raw_misses = 0, compressed_misses = 0;
+  uint64_t total_micros = 0;
+  while (writes < max_writes) {
+    fillBuffer(&seed);
+    uint32_t start = micros();
+    size_t written = file.write(buffer, sizeof(buffer));
+    uint32_t duration = micros() - start;
+    if (written != sizeof(buffer))
+      break;
+    latency[writes++] = duration;
+    total_micros += duration;
+    raw_misses += duration > raw_deadline;
+    compressed_misses += duration > compressed_deadline;
+    yield(); // Feed the watchdog
+  }
+  file.close();
+
+  // Report the throughput and the tail latency
+  const uint32_t bytes = writes * sizeof(buffer);
+  qsort(latency, writes, sizeof(uint32_t), compareLatency);
+  Serial.printf("Usable: %u bytes (%u %% of total) in %u writes\n", bytes, (uint32_t)((uint64_t)bytes * 100 / fs_info.totalBytes), writes);
+  Serial.printf("Throughput: %u bytes/s\n", total_micros ? (uint32_t)((uint64_t)bytes * 1000000UL / total_micros) : 0);
+  if (writes > 0) {
+    Serial.printf("Latency (us): p50 %u, p90 %u, p99 %u, p99.9 %u, max %u\n", latency[writes / 2], latency[writes * 9 / 10],
+      latency[writes * 99 / 100], latency[writes * 999 / 1000], latency[writes - 1]);
+  }
+  Serial.printf("Writes slower than a buffer at %u Hz: %u raw (%u us), %u compressed (%u us)\n", BENCH_SAMPLE_RATE,
+    raw_misses, raw_deadline, compressed_misses, compressed_deadline);
+  Serial.printf("Flight time at %u Hz: %u s raw, %u s compressed\n", BENCH_SAMPLE_RATE,
+    bytes / (sizeof(log_record_t) * BENCH_SAMPLE_RATE), bytes / (BENCH_COMPRESSED_SIZE * BENCH_SAMPLE_RATE));
+
+  delete[] latency;
+  fs.remove(bench_filename);
+  fs.end(); // Unmount, so the next backend can use the flash
+}
+
+void setup() {
+  Serial.begin(74880);
+  Serial.println(F("\nStorage benchmark"));
+  benchBackend("SPIFFS", SPIFFS);
+  benchBackend("LittleFS", LittleFS);
+  Serial.println(F("\nDone"));
+}
+
+void loop() {
+}
@@ -0,0 +1,251 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <math.h>
+#include <string.h>
+
+#include "altitude.h"
+#include "csv_encoder.h"
+
+static const char csv_header[] = "Timestamp,pressure,altitude,gyroX,gyroY,gyroZ,accX,accY,accZ\n";
+
+// Two ASCII digits for every value from 0 to 99, so only every second digit needs a division
+static const char digit_pairs[201] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+static char *CsvEncoder_FormatUint(char *out, uint32_t value) {
+  char tmp[10];
+  char *p = &tmp[sizeof(tmp)];
+  while (value >= 100) {
+    uint32_t q = value / 100;
+    p -= 2;
+    memcpy(p, &digit_pairs[(value - q * 100) * 2], 2);
+    value = q;
+  }
+  if (value >= 10) {
+    p -= 2;
+    memcpy(p, &digit_pairs[value * 2], 2);
+  } else
+    *--p = '0' + value;
+  size_t n = &tmp[sizeof(tmp)] - p;
+  memcpy(out, p, n);
+  return out + n;
+}
+
+static char *CsvEncoder_FormatInt(char *out, int32_t value) {
+  if (value < 0) {
+    *out++ = '-';
+    return CsvEncoder_FormatUint(out, 0U - (uint32_t)value);
+  }
+  return CsvEncoder_FormatUint(out, value);
+}
+
+// Formats a value in 1e-4 units with four decimals i.e. the same as "%.4f"
+static char *CsvEncoder_FormatFixed(char *out, int32_t value) {
+  uint32_t u = value;
+  if (value < 0) {
+    *out++ = '-';
+    u = 0U - u;
+  }
+  out = CsvEncoder_FormatUint(out, u / 10000);
+  uint32_t fraction = u % 10000;
+  *out++ = '.';
+  memcpy(out, &digit_pairs[(fraction / 100) * 2], 2);
+  memcpy(out + 2, &digit_pairs[(fraction % 100) * 2], 2);
+  return out + 4;
+}
+
+// Formats a value in 1e-3 units with three decimals i.e. the same as "%.3f"
+static char *CsvEncoder_FormatMilli(char *out, int32_t value) {
+  uint32_t u = value;
+  if (value < 0) {
+    *out++ = '-';
+    u = 0U - u;
+  }
+  out = CsvEncoder_FormatUint(out, u / 1000);
+  uint32_t fraction = u % 1000;
+  *out++ = '.';
+  *out++ = '0' + fraction / 100;
+  memcpy(out, &digit_pairs[(fraction % 100) * 2], 2);
+  return out + 2;
+}
+
+// Returns the scale factor from raw counts to 1e-4 units in fixed-point
+static int64_t CsvEncoder_Scale(double scale) {
+  return llround(scale * 10000.0 * (1LL << CSV_ENCODER_FRACTION_BITS));
+}
+
+// Scales a raw value and rounds it to the nearest 1e-4 unit
+static int32_t CsvEncoder_Convert(int64_t scale, int16_t raw) {
+  const int64_t half = 1LL << (CSV_ENCODER_FRACTION_BITS - 1);
+  int64_t value = raw * scale;
+  value = (value >= 0 ? value + half : value - half) / (1LL << CSV_ENCODER_FRACTION_BITS);
+  return value > INT32_MAX ? INT32_MAX : value < INT32_MIN ? INT32_MIN : (int32_t)value;
+}
+
+// Converts the readings using the scale factors of the ranges in a LOG_RECORD_RANGE record from now on
+static void CsvEncoder_SetRange(csv_encoder_t *csv_encoder, const mpu6500_range_t *range) {
+  csv_encoder->range = *range;
+  csv_encoder->gyro_scale = CsvEncoder_Scale(1.0 / MPU6500_GetGyroScaleFactor(range->gyro));
+  csv_encoder->acc_scale = CsvEncoder_Scale(GRAVITATIONAL_ACCELERATION / MPU6500_GetAccScaleFactor(range->acc));
+}
+
+// Converts the readings using the scale factors from the header and queues the column names as the first row
+void CsvEncoder_Init(csv_encoder_t *csv_encoder, const log_header_t *header) {
+  csv_encoder->gyro_scale = header->gyroScaleFactor > 0 ? CsvEncoder_Scale(1.0 / header->gyroScaleFactor) : 0;
+  csv_encoder->acc_scale = header->accScaleFactor > 0 ? CsvEncoder_Scale(GRAVITATIONAL_ACCELERATION / header->accScaleFactor) : 0;
+  csv_encoder->range.gyro = csv_encoder->range.acc = CSV_ENCODER_RANGE_HEADER;
+  csv_encoder->ground_altitude = header->ground_pressure > 0 ? Altitude_FromPressure(header->ground_pressure) : 0; // Older logs use the absolute altitude
+  csv_encoder->pressure = 0;
+  csv_encoder->altitude = Altitude_FromPressure(0) - csv_encoder->ground_altitude;
+  memcpy(csv_encoder->row, csv_header, sizeof(csv_header) - 1);
+  csv_encoder->row_length = sizeof(csv_header) - 1;
+  csv_encoder->row_position = 0;
+}
+
+// Continues the encoding from the middle of a log, where "pressure" is the pressure of the previous row and "range" the
+// range of the encoder at that point. The pending row is discarded
+void CsvEncoder_Restore(csv_encoder_t *csv_encoder, int32_t pressure, const mpu6500_range_t *range) {
+  if (range->gyro != CSV_ENCODER_RANGE_HEADER)
+    CsvEncoder_SetRange(csv_encoder, range);
+  csv_encoder->pressure = pressure;
+  csv_encoder->altitude = Altitude_FromPressure(pressure) - csv_encoder->ground_altitude;
+  csv_encoder->row_length = csv_encoder->row_position = 0;
+}
+
+// Formats a record into "out", which must have room for CSV_ENCODER_MAX_ROW_SIZE bytes. Returns the length of the row
+size_t CsvEncoder_Format(csv_encoder_t *csv_encoder, const log_record_t *record, char *out) {
+  char *p = out;
+  if (record->type == LOG_RECORD_DROPPED) {
+    static const char dropped[] = "# Dropped ", before[] = " samples before ";
+    memcpy(p, dropped, sizeof(dropped) - 1);
+    p = CsvEncoder_FormatUint(p + sizeof(dropped) - 1, record->event.arg[0]);
+    memcpy(p, before, sizeof(before) - 1);
+    p = CsvEncoder_FormatUint(p + sizeof(before) - 1, record->timestamp);
+  } else if (record->type == LOG_RECORD_CORRUPTED) {
+    static const char corrupted[] = "# Skipped a corrupted block at byte ";
+    memcpy(p, corrupted, sizeof(corrupted) - 1);
+    p = CsvEncoder_FormatUint(p + sizeof(corrupted) - 1, record->event.arg[0]);
+  } else if (record->type == LOG_RECORD_LAUNCH) {
+    static const char launch[] = "# Launch detected at ";
+    memcpy(p, launch, sizeof(launch) - 1);
+    p = CsvEncoder_FormatUint(p + sizeof(launch) - 1, record->timestamp);
+  } else if (record->type == LOG_RECORD_PHASE) {
+    static const char phase[] = "# Phase ", at[] = " at ", rate[] = ": ", osr[] = " Hz, OSR ";
+    const char *name = LogFormat_GetPhaseName(record->event.arg[0]);
+    size_t length = strlen(name);
+    memcpy(p, phase, sizeof(phase) - 1);
+    p += sizeof(phase) - 1;
+    memcpy(p, name, length);
+    p += length;
+    memcpy(p, at, sizeof(at) - 1);
+    p = CsvEncoder_FormatUint(p + sizeof(at) - 1, record->timestamp);
+    memcpy(p, rate, sizeof(rate) - 1);
+    p = CsvEncoder_FormatUint(p + sizeof(rate) - 1, record->event.arg[1]);
+    memcpy(p, osr, sizeof(osr) - 1);
+    p = CsvEncoder_FormatUint(p + sizeof(osr) - 1, record->event.arg[2]);
+  } else if (record->type == LOG_RECORD_ESTIMATE) {
+    static const char estimate[] = "# Estimate at ", altitude[] = ": altitude ", velocity[] = " m, velocity ", tilt[] = " m/s, tilt ", deg[] = " deg";
+    memcpy(p, estimate, sizeof(estimate) - 1);
+    p = CsvEncoder_FormatUint(p + sizeof(estimate) - 1, record->timestamp);
+    memcpy(p, altitude, sizeof(altitude) - 1);
+    p = CsvEncoder_FormatMilli(p + sizeof(altitude) - 1, (int32_t)record->event.arg[0]);
+    memcpy(p, velocity, sizeof(velocity) - 1);
+    p = CsvEncoder_FormatMilli(p + sizeof(velocity) - 1, (int32_t)record->event.arg[1]);
+    memcpy(p, tilt, sizeof(tilt) - 1);
+    p = CsvEncoder_FormatMilli(p + sizeof(tilt) - 1, (int32_t)(LogFormat_GetTilt(record) * 1000.0f));
+    memcpy(p, deg, sizeof(deg) - 1);
+    p += sizeof(deg) - 1;
+  } else if (record->type == LOG_RECORD_RANGE) {
+    static const char range[] = "# Range at ", gyro[] = ": gyro ", acc[] = " deg/s, acc ", g[] = " g";
+    mpu6500_range_t new_range = LogFormat_GetRange(record);
+    CsvEncoder_SetRange(csv_encoder, &new_range);
+    memcpy(p, range, sizeof(range) - 1);
+    p = CsvEncoder_FormatUint(p + sizeof(range) - 1, record->timestamp);
+    memcpy(p, gyro, sizeof(gyro) - 1);
+    p = CsvEncoder_FormatUint(p + sizeof(gyro) - 1, MPU6500_GetGyroFullScale(new_range.gyro));
+    memcpy(p, acc, sizeof(acc) - 1);
+    p = CsvEncoder_FormatUint(p + sizeof(acc) - 1, MPU6500_GetAccFullScale(new_range.acc));
+    memcpy(p, g, sizeof(g) - 1);
+    p += sizeof(g) - 1;
+  } else if (record->type == LOG_RECORD_STATS) {
+    const char *name = LogFormat_GetStatsName(record->event.arg[0]);
+    size_t length = strlen(name);
+    *p++ = '#';
+    *p++ = ' ';
+    memcpy(p, name, length);
+    p += length;
+    *p++ = ':';
+    *p++ = ' ';
+    p = CsvEncoder_FormatUint(p, record->event.arg[1]);
+    *p++ = ' ';
+    p = CsvEncoder_FormatUint(p, record->event.arg[2]);
+  } else if (record->type == LOG_RECORD_SAMPLE) {
+    int32_t pressure = LogFormat_GetPressure(record);
+    if (pressure != csv_encoder->pressure) {
+      csv_encoder->pressure = pressure;
+      csv_encoder->altitude = Altitude_FromPressure(pressure) - csv_encoder->ground_altitude;
+    }
+    p = CsvEncoder_FormatUint(p, record->timestamp);
+    *p++ = ',';
+    p = CsvEncoder_FormatInt(p, pressure);
+    *p++ = ',';
+    p = CsvEncoder_FormatMilli(p, csv_encoder->altitude);
+    for (uint8_t axis = 0; axis < 3; axis++) {
+      *p++ = ',';
+      p = CsvEncoder_FormatFixed(p, CsvEncoder_Convert(csv_encoder->gyro_scale, record->sample.gyro.data[axis]));
+    }
+    for (uint8_t axis = 0; axis < 3; axis++) {
+      *p++ = ',';
+      p = CsvEncoder_FormatFixed(p, CsvEncoder_Convert(csv_encoder->acc_scale, record->sample.acc.data[axis]));
+    }
+  } else
+    return 0; // Other records are not part of the CSV file
+  *p++ = '\n';
+  return p - out;
+}
+
+// Copies as much of the pending row as possible into the buffer. Returns the number of bytes copied
+size_t CsvEncoder_Flush(csv_encoder_t *csv_encoder, uint8_t *buffer, size_t size) {
+  size_t n = csv_encoder->row_length - csv_encoder->row_position;
+  if (n > size)
+    n = size;
+  memcpy(buffer, &csv_encoder->row[csv_encoder->row_position], n);
+  csv_encoder->row_position += n;
+  if (csv_encoder->row_position == csv_encoder->row_length)
+    csv_encoder->row_length = csv_encoder->row_position = 0;
+  return n;
+}
+
+// Formats a record directly into the buffer if there is room, otherwise the rest of the row is sent by the next flush.
+// The pending row must have been flushed first. Returns the number of bytes written
+size_t CsvEncoder_Write(csv_encoder_t *csv_encoder, const log_record_t *record, uint8_t *buffer, size_t size) {
+  if (size >= CSV_ENCODER_MAX_ROW_SIZE)
+    return CsvEncoder_Format(csv_encoder, record, (char*)buffer);
+  csv_encoder->row_length = CsvEncoder_Format(csv_encoder, record, csv_encoder->row);
+  csv_encoder->row_position = 0;
+  return CsvEncoder_Flush(csv_encoder, buffer, size);
+}
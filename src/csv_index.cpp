@@ -0,0 +1,116 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <string.h>
+
+#include "csv_index.h"
+
+void CsvIndex_Reset(csv_index_t *csv_index) {
+  csv_index->id = csv_index->length = 0;
+  csv_index->complete = false;
+  csv_index->boundaries = csv_index->count = 0;
+  csv_index->stride = 1;
+}
+
+// Starts building the index for a log. The reader must have just been opened
+void CsvIndex_Init(csv_index_t *csv_index, uint32_t id, const log_header_t *header) {
+  CsvIndex_Reset(csv_index);
+  csv_index->id = id;
+  CsvEncoder_Init(&csv_index->encoder, header);
+  csv_index->length = csv_index->encoder.row_length; // The column names are the first row
+  csv_index->encoder.row_length = 0;
+}
+
+// Stores a checkpoint at the current position in the log
+static void CsvIndex_Add(csv_index_t *csv_index, uint32_t log_offset) {
+  if (csv_index->boundaries++ % csv_index->stride != 0)
+    return;
+  if (csv_index->count == CSV_INDEX_SIZE) {
+    // Keep every second checkpoint, so the checkpoints are always evenly spaced
+    for (uint8_t i = 0; i < CSV_INDEX_SIZE / 2; i++)
+      csv_index->entries[i] = csv_index->entries[2 * i];
+    csv_index->count = CSV_INDEX_SIZE / 2;
+    csv_index->stride *= 2;
+    if ((csv_index->boundaries - 1) % csv_index->stride != 0)
+      return;
+  }
+  csv_index_entry_t *entry = &csv_index->entries[csv_index->count++];
+  entry->csv_offset = csv_index->length;
+  entry->log_offset = log_offset;
+  entry->pressure = csv_index->encoder.pressure;
+  entry->range = csv_index->encoder.range;
+}
+
+// Converts up to CSV_INDEX_UPDATE_RECORDS records, so the time spent is bounded.
+// Returns true when the whole log has been converted
+bool CsvIndex_Update(csv_index_t *csv_index, log_reader_t *log_reader) {
+  if (csv_index->complete)
+    return true;
+
+  for (uint16_t i = 0; i < CSV_INDEX_UPDATE_RECORDS; i++) {
+    uint32_t log_offset;
+    if (LogReader_Tell(log_reader, &log_offset))
+      CsvIndex_Add(csv_index, log_offset);
+
+    log_record_t record;
+    if (!LogReader_Next(log_reader, &record)) {
+      if (log_reader->error)
+        csv_index->length += sizeof(CSV_ENCODER_CORRUPTED) - 1;
+      csv_index->complete = true;
+      return true;
+    }
+    char row[CSV_ENCODER_MAX_ROW_SIZE];
+    csv_index->length += CsvEncoder_Format(&csv_index->encoder, &record, row);
+  }
+  return false;
+}
+
+// Moves the reader to the row containing "offset" and queues the rest of that row in the encoder,
+// so the CSV file continues from the offset. The reader must be opened on the indexed log.
+// Returns false if the offset is not part of a row
+bool CsvIndex_Seek(const csv_index_t *csv_index, log_reader_t *log_reader, csv_encoder_t *csv_encoder, uint32_t offset) {
+  CsvEncoder_Init(csv_encoder, &log_reader->header);
+  if (offset < csv_encoder->row_length) {
+    csv_encoder->row_position = offset; // The offset is within the column names
+    return LogReader_Seek(log_reader, log_reader->header.header_size);
+  }
+
+  // Start from the last checkpoint before the offset
+  uint8_t i = csv_index->count;
+  while (i > 0 && csv_index->entries[i - 1].csv_offset > offset)
+    i--;
+  if (i == 0)
+    return false;
+  const csv_index_entry_t *entry = &csv_index->entries[i - 1];
+  if (!LogReader_Seek(log_reader, entry->log_offset))
+    return false;
+  CsvEncoder_Restore(csv_encoder, entry->pressure, &entry->range);
+
+  // Skip the rows before the offset
+  uint32_t position = entry->csv_offset;
+  log_record_t record;
+  while (LogReader_Next(log_reader, &record)) {
+    size_t length = CsvEncoder_Format(csv_encoder, &record, csv_encoder->row);
+    if (position + length > offset) {
+      csv_encoder->row_length = length;
+      csv_encoder->row_position = offset - position;
+      return true;
+    }
+    position += length;
+  }
+  return false;
+}
@@ -0,0 +1,162 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include "altitude.h"
+#include "estimator.h"
+#include "log_format.h"
+
+#define ESTIMATOR_ONE               (1L << 30) // 1.0 in Q30
+#define ESTIMATOR_GAIN(x)           ((int64_t)((x) * 256.0f + 0.5f)) // The gains are used in Q8
+#define ESTIMATOR_GRAVITY           ((int64_t)(GRAVITATIONAL_ACCELERATION * 1000.0f * 256.0f + 0.5f)) // mm/s^2 in Q8
+
+// Returns the time since the last reading in units of 2^-20 s, so no division is needed when integrating
+static uint32_t Estimator_TimeStep(uint32_t *last, uint32_t timestamp) {
+  uint32_t dt = timestamp - *last;
+  *last = timestamp;
+  if (dt > ESTIMATOR_MAX_DT)
+    dt = ESTIMATOR_MAX_DT;
+  return (uint32_t)(((uint64_t)dt * 68719U) >> 16); // 2^20 / 10^6 in Q16
+}
+
+void Estimator_Init(estimator_t *estimator, float gyro_scale_factor, float acc_scale_factor, int32_t ground_pressure) {
+  estimator->q[0] = ESTIMATOR_ONE; // The z-axis is assumed to point up until the accelerometer has corrected it
+  estimator->q[1] = estimator->q[2] = estimator->q[3] = 0;
+  for (uint8_t axis = 0; axis < 3; axis++)
+    estimator->gyro_bias[axis] = 0;
+  estimator->altitude = estimator->velocity = 0;
+  estimator->vertical_acc = 0;
+  estimator->ground_pressure = ground_pressure;
+  Estimator_SetScale(estimator, gyro_scale_factor, acc_scale_factor);
+  estimator->imu_valid = estimator->baro_valid = false;
+}
+
+// Should be called when the range of the IMU changes. The state is kept, as it is in SI units
+void Estimator_SetScale(estimator_t *estimator, float gyro_scale_factor, float acc_scale_factor) {
+  estimator->gyro_k = (int32_t)(DEG_TO_RADf / gyro_scale_factor * 16777216.0f + 0.5f);
+  estimator->acc_k = (int32_t)(1048576.0f / acc_scale_factor + 0.5f);
+  uint32_t acc_min = (uint32_t)(ESTIMATOR_ACC_MIN * acc_scale_factor), acc_max = (uint32_t)(ESTIMATOR_ACC_MAX * acc_scale_factor);
+  estimator->acc_min_squared = acc_min * acc_min;
+  estimator->acc_max_squared = acc_max * acc_max;
+}
+
+// Should be called for every IMU sample
+void Estimator_UpdateImu(estimator_t *estimator, uint32_t timestamp, const sensorRaw_t *gyro, const sensorRaw_t *acc) {
+  if (!estimator->imu_valid) {
+    estimator->imu_timestamp = timestamp;
+    estimator->imu_valid = true;
+    return;
+  }
+  const uint32_t dt = Estimator_TimeStep(&estimator->imu_timestamp, timestamp);
+  int32_t *q = estimator->q;
+
+  // The direction of up in the body frame in Q30
+  const int32_t vx = (int32_t)(((int64_t)q[1] * q[3] - (int64_t)q[0] * q[2]) >> 29);
+  const int32_t vy = (int32_t)(((int64_t)q[0] * q[1] + (int64_t)q[2] * q[3]) >> 29);
+  const int32_t vz = (int32_t)(((int64_t)q[0] * q[0] - (int64_t)q[1] * q[1] - (int64_t)q[2] * q[2] + (int64_t)q[3] * q[3]) >> 30);
+
+  // The accelerometer readings in g in Q20
+  const int32_t ax = acc->X * estimator->acc_k, ay = acc->Y * estimator->acc_k, az = acc->Z * estimator->acc_k;
+
+  // The vertical acceleration is the acceleration along the up direction minus the gravity
+  const int32_t up = (int32_t)(((int64_t)ax * vx + (int64_t)ay * vy + (int64_t)az * vz) >> 30);
+  estimator->vertical_acc = (int32_t)(((int64_t)(up - (1L << 20)) * ESTIMATOR_GRAVITY) >> 28);
+
+  // The angular rate in rad/s in Q24
+  int32_t rate[3];
+  for (uint8_t axis = 0; axis < 3; axis++)
+    rate[axis] = gyro->data[axis] * estimator->gyro_k - (estimator->gyro_bias[axis] >> 6);
+
+  // The accelerometer only measures the gravity when the magnitude is close to 1 g. The error is then the rotation
+  // between the measured and the estimated up direction, which is used to correct the angular rate and the bias
+  uint32_t acc_squared = (uint32_t)((int32_t)acc->X * acc->X) + (uint32_t)((int32_t)acc->Y * acc->Y) + (uint32_t)((int32_t)acc->Z * acc->Z);
+  if (acc_squared >= estimator->acc_min_squared && acc_squared <= estimator->acc_max_squared) {
+    const int32_t error[3] = { // Q20
+      (int32_t)(((int64_t)ay * vz - (int64_t)az * vy) >> 30),
+      (int32_t)(((int64_t)az * vx - (int64_t)ax * vz) >> 30),
+      (int32_t)(((int64_t)ax * vy - (int64_t)ay * vx) >> 30),
+    };
+    for (uint8_t axis = 0; axis < 3; axis++) {
+      estimator->gyro_bias[axis] -= (int32_t)((error[axis] * ESTIMATOR_GAIN(ESTIMATOR_ATTITUDE_KI) * dt) >> 18);
+      rate[axis] += (int32_t)((error[axis] * ESTIMATOR_GAIN(ESTIMATOR_ATTITUDE_KP)) >> 4);
+    }
+  }
+
+  // Integrate the rotation given by half of the angles in Q30
+  const int32_t hx = (int32_t)(((int64_t)rate[0] * dt) >> 15), hy = (int32_t)(((int64_t)rate[1] * dt) >> 15), hz = (int32_t)(((int64_t)rate[2] * dt) >> 15);
+  const int32_t w = q[0], x = q[1], y = q[2], z = q[3];
+  q[0] += (int32_t)((-(int64_t)x * hx - (int64_t)y * hy - (int64_t)z * hz) >> 30);
+  q[1] += (int32_t)(((int64_t)w * hx + (int64_t)y * hz - (int64_t)z * hy) >> 30);
+  q[2] += (int32_t)(((int64_t)w * hy - (int64_t)x * hz + (int64_t)z * hx) >> 30);
+  q[3] += (int32_t)(((int64_t)w * hz + (int64_t)x * hy - (int64_t)y * hx) >> 30);
+
+  // The length is kept close to one, so it can be normalized using the first order approximation of 1 / sqrt(n)
+  const int32_t n = (int32_t)(((int64_t)q[0] * q[0] + (int64_t)q[1] * q[1] + (int64_t)q[2] * q[2] + (int64_t)q[3] * q[3]) >> 30);
+  const int32_t f = ESTIMATOR_ONE + ((ESTIMATOR_ONE - n) >> 1);
+  for (uint8_t i = 0; i < 4; i++)
+    q[i] = (int32_t)(((int64_t)q[i] * f) >> 30);
+
+  // Integrate the vertical acceleration once the altitude is known
+  if (estimator->baro_valid) {
+    estimator->velocity += ((int64_t)estimator->vertical_acc * dt) >> 4;
+    estimator->altitude += (estimator->velocity * dt) >> 20;
+  }
+}
+
+// Should be called for every new pressure reading
+void Estimator_UpdatePressure(estimator_t *estimator, uint32_t timestamp, int32_t pressure) {
+  int32_t altitude = Altitude_AboveGround(pressure, estimator->ground_pressure);
+  if (!estimator->baro_valid) {
+    estimator->altitude = (int64_t)altitude << 16;
+    estimator->velocity = 0;
+    estimator->baro_timestamp = estimator->settle_timestamp = timestamp;
+    estimator->baro_valid = true;
+    return;
+  }
+  const uint32_t dt = Estimator_TimeStep(&estimator->baro_timestamp, timestamp);
+
+  // Correct the integrated acceleration towards the barometer
+  const int64_t error = (int64_t)altitude - (estimator->altitude >> 16);
+  estimator->altitude += (error * ESTIMATOR_GAIN(ESTIMATOR_ALTITUDE_GAIN) * dt) >> 12;
+  estimator->velocity += (error * ESTIMATOR_GAIN(ESTIMATOR_VELOCITY_GAIN) * dt) >> 12;
+}
+
+// Returns the altitude above the ground in mm
+int32_t Estimator_GetAltitude(const estimator_t *estimator) {
+  return (int32_t)(estimator->altitude >> 16);
+}
+
+// Returns the vertical velocity in mm/s
+int32_t Estimator_GetVelocity(const estimator_t *estimator) {
+  return (int32_t)(estimator->velocity >> 16);
+}
+
+// Returns true when the velocity no longer depends on the initial value, which is zero
+bool Estimator_IsSettled(const estimator_t *estimator) {
+  return estimator->baro_valid && estimator->baro_timestamp - estimator->settle_timestamp >= ESTIMATOR_SETTLE_TIME;
+}
+
+// Returns the attitude packed as stored in a LOG_RECORD_ESTIMATE record. As q and -q is the same rotation,
+// w is made non-negative, so only the vector part has to be stored
+uint32_t Estimator_GetAttitude(const estimator_t *estimator) {
+  const int64_t scale = estimator->q[0] < 0 ? -LOG_ATTITUDE_SCALE : LOG_ATTITUDE_SCALE;
+  uint32_t packed = 0;
+  for (uint8_t i = 0; i < 3; i++) {
+    int32_t value = (int32_t)((estimator->q[i + 1] * scale + (1L << 29)) >> 30);
+    packed |= ((uint32_t)value & 0x3FFU) << (10 * i);
+  }
+  return packed;
+}
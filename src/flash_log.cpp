@@ -0,0 +1,177 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <Arduino.h>
+
+#include "flash_log.h"
+#include "rocket_assert.h"
+
+#define FLASH_LOG_READ_CHUNK        (32U) // Number of words read at a time
+
+static bool FlashLog_ReadInfo(const flash_log_t *flash_log, flash_log_info_t *info) {
+  return ESP.flashRead(flash_log->start - FLASH_LOG_SECTOR_SIZE, (uint32_t*)info, sizeof(flash_log_info_t));
+}
+
+// Finds the end of a log which was not closed e.g. if the power was lost. At least one sector is erased ahead of the data,
+// so the first sector starting with an erased word ends the log. The length is then found from the last programmed word
+static uint32_t FlashLog_Recover(const flash_log_t *flash_log) {
+  uint32_t sector = flash_log->start, word;
+  while (sector < flash_log->end && ESP.flashRead(sector, &word, sizeof(word)) && word != FLASH_LOG_ERASED)
+    sector += FLASH_LOG_SECTOR_SIZE;
+  if (sector == flash_log->start)
+    return 0;
+
+  uint32_t address = sector;
+  while (address > sector - FLASH_LOG_SECTOR_SIZE && ESP.flashRead(address - sizeof(word), &word, sizeof(word)) && word == FLASH_LOG_ERASED)
+    address -= sizeof(word);
+  return address - flash_log->start;
+}
+
+// The region must be sector aligned. The first sector is used for the length of the log
+bool FlashLog_Init(flash_log_t *flash_log, uint32_t address, uint32_t size) {
+  ROCKET_ASSERT(address % FLASH_LOG_SECTOR_SIZE == 0 && size >= 2 * FLASH_LOG_SECTOR_SIZE);
+  flash_log->start = flash_log->write_address = flash_log->erase_address = address + FLASH_LOG_SECTOR_SIZE;
+  flash_log->end = address + size - size % FLASH_LOG_SECTOR_SIZE;
+  flash_log->open = false;
+
+  // Find the length of the log from the last time
+  flash_log_info_t info;
+  if (!FlashLog_ReadInfo(flash_log, &info) || info.magic != FLASH_LOG_MAGIC)
+    flash_log->length = 0;
+  else if (info.length == FLASH_LOG_ERASED)
+    flash_log->length = FlashLog_Recover(flash_log);
+  else
+    flash_log->length = info.length < flash_log->end - flash_log->start ? info.length : flash_log->end - flash_log->start;
+  return flash_log->length > 0;
+}
+
+// Erases the next sector. Returns false if the rest of the region is already erased or the erase failed
+bool FlashLog_EraseAhead(flash_log_t *flash_log) {
+  if (!flash_log->open || flash_log->erase_address >= flash_log->end)
+    return false;
+  if (!ESP.flashEraseSector(flash_log->erase_address / FLASH_LOG_SECTOR_SIZE))
+    return false;
+  flash_log->erase_address += FLASH_LOG_SECTOR_SIZE;
+  return true;
+}
+
+// Returns true if the given number of bytes at the start of the region are erased, or the whole region if it is smaller
+bool FlashLog_IsErased(const flash_log_t *flash_log, uint32_t size) {
+  return flash_log->erase_address >= flash_log->end || flash_log->erase_address - flash_log->start >= size;
+}
+
+// Returns the end of the part which can be written. A whole erased sector is kept after the data, so the end of the log
+// is found if it is never closed, see FlashLog_Recover(). The old log is still stored after that
+static uint32_t FlashLog_GetWriteEnd(const flash_log_t *flash_log) {
+  if (flash_log->erase_address >= flash_log->end)
+    return flash_log->end;
+  return flash_log->erase_address - flash_log->start > FLASH_LOG_SECTOR_SIZE ? flash_log->erase_address - FLASH_LOG_SECTOR_SIZE : flash_log->start;
+}
+
+// Starts a new log. Only the first sector is erased here, the data sectors must be erased using FlashLog_EraseAhead() before they are written
+bool FlashLog_Open(flash_log_t *flash_log) {
+  flash_log->open = false;
+  flash_log->length = 0;
+  flash_log->write_address = flash_log->erase_address = flash_log->start;
+  if (!ESP.flashEraseSector((flash_log->start - FLASH_LOG_SECTOR_SIZE) / FLASH_LOG_SECTOR_SIZE))
+    return false;
+  flash_log_info_t info = { FLASH_LOG_MAGIC, FLASH_LOG_ERASED };
+  if (!ESP.flashWrite(flash_log->start - FLASH_LOG_SECTOR_SIZE, (uint32_t*)&info, sizeof(info)))
+    return false;
+  flash_log->open = true;
+  return true;
+}
+
+bool FlashLog_IsOpen(const flash_log_t *flash_log) {
+  return flash_log->open;
+}
+
+// Appends the data to the log. The data must be word aligned and only the last write may have a size which is not
+// a multiple of four bytes. Returns the number of bytes written, which is less than the size if the erased part is full.
+// This never erases, as that blocks for longer than the FIFO of the IMU can buffer
+size_t FlashLog_Write(flash_log_t *flash_log, const uint8_t *data, size_t size) {
+  if (!flash_log->open)
+    return 0;
+  ROCKET_ASSERT(flash_log->write_address % 4 == 0 && (uintptr_t)data % 4 == 0);
+
+  const uint32_t end = FlashLog_GetWriteEnd(flash_log);
+  size_t written = 0;
+  while (written < size && flash_log->write_address < end) {
+    size_t n = size - written;
+    if (n > end - flash_log->write_address)
+      n = end - flash_log->write_address;
+    bool success;
+    if (n >= 4) {
+      n &= ~3U;
+      success = ESP.flashWrite(flash_log->write_address, (uint32_t*)&data[written], n);
+      flash_log->write_address += n;
+    } else {
+      uint32_t word = FLASH_LOG_ERASED; // The unused bytes are left erased
+      memcpy(&word, &data[written], n);
+      success = ESP.flashWrite(flash_log->write_address, &word, sizeof(word));
+      flash_log->write_address += sizeof(word);
+    }
+    if (!success)
+      break;
+    written += n;
+    flash_log->length += n;
+  }
+  return written;
+}
+
+// Stores the length of the log, so it does not have to be recovered
+void FlashLog_Close(flash_log_t *flash_log) {
+  if (!flash_log->open)
+    return;
+  flash_log->open = false;
+  uint32_t length = flash_log->length;
+  ESP.flashWrite(flash_log->start - FLASH_LOG_SECTOR_SIZE + offsetof(flash_log_info_t, length), &length, sizeof(length));
+}
+
+uint32_t FlashLog_GetLength(const flash_log_t *flash_log) {
+  return flash_log->length;
+}
+
+// Returns the exact number of bytes which can still be written without erasing
+uint32_t FlashLog_GetFree(const flash_log_t *flash_log) {
+  return flash_log->open ? FlashLog_GetWriteEnd(flash_log) - flash_log->write_address : 0;
+}
+
+// Reads from the log at the given offset. Returns the number of bytes read
+size_t FlashLog_Read(const flash_log_t *flash_log, uint32_t offset, uint8_t *data, size_t size) {
+  if (offset >= flash_log->length)
+    return 0;
+  if (size > flash_log->length - offset)
+    size = flash_log->length - offset;
+
+  // The flash can only be read in whole words
+  uint32_t buffer[FLASH_LOG_READ_CHUNK];
+  uint32_t address = flash_log->start + offset;
+  size_t done = 0;
+  while (done < size) {
+    uint32_t skip = address % 4;
+    size_t n = sizeof(buffer) - skip;
+    if (n > size - done)
+      n = size - done;
+    if (!ESP.flashRead(address - skip, buffer, (skip + n + 3) & ~3U))
+      break;
+    memcpy(&data[done], (uint8_t*)buffer + skip, n);
+    done += n;
+    address += n;
+  }
+  return done;
+}
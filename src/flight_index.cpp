@@ -0,0 +1,343 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <Arduino.h>
+#include <stdarg.h>
+
+#include "flight_index.h"
+#include "log_reader.h"
+#include "rocket_assert.h"
+#include "storage.h"
+
+#define FLIGHT_INDEX_LEGACY_FILENAME "/log.bin" // Used before every flight got its own log file
+
+void FlightIndex_GetPath(uint32_t id, char *path) {
+  snprintf(path, FLIGHT_INDEX_PATH_SIZE, "/flight%u.bin", id);
+}
+
+static int FlightIndex_IndexOf(const flight_index_t *flight_index, uint32_t id) {
+  for (uint8_t i = 0; i < flight_index->count; i++) {
+    if (flight_index->flights[i].id == id)
+      return i;
+  }
+  return -1;
+}
+
+const flight_entry_t *FlightIndex_Find(const flight_index_t *flight_index, uint32_t id) {
+  int i = FlightIndex_IndexOf(flight_index, id);
+  return i >= 0 ? &flight_index->flights[i] : nullptr;
+}
+
+// Returns the newest flight which has been closed or nullptr if there is none
+const flight_entry_t *FlightIndex_GetLatest(const flight_index_t *flight_index) {
+  for (uint8_t i = flight_index->count; i > 0; i--) {
+    if (flight_index->flights[i - 1].flags & FLIGHT_FLAG_CLOSED)
+      return &flight_index->flights[i - 1];
+  }
+  return nullptr;
+}
+
+// Adds or replaces an entry in RAM, so the flights stay sorted by id
+static void FlightIndex_Apply(flight_index_t *flight_index, const flight_entry_t *entry) {
+  int i = FlightIndex_IndexOf(flight_index, entry->id);
+  if (entry->flags & FLIGHT_FLAG_DELETED) {
+    if (i >= 0) {
+      memmove(&flight_index->flights[i], &flight_index->flights[i + 1], (flight_index->count - i - 1) * sizeof(flight_entry_t));
+      flight_index->count--;
+    }
+    return;
+  }
+  if (i < 0) {
+    if (flight_index->count >= FLIGHT_INDEX_MAX_FLIGHTS)
+      return;
+    i = flight_index->count;
+    while (i > 0 && flight_index->flights[i - 1].id > entry->id)
+      i--;
+    memmove(&flight_index->flights[i + 1], &flight_index->flights[i], (flight_index->count - i) * sizeof(flight_entry_t));
+    flight_index->count++;
+  }
+  flight_index->flights[i] = *entry;
+}
+
+// Writes all the flights to a new index file, so the replaced entries are removed
+static void FlightIndex_Rewrite(flight_index_t *flight_index) {
+  File file = Storage_Open(FLIGHT_INDEX_TMP_FILENAME, "w");
+  if (!file)
+    return;
+  flight_index_header_t header = {
+    .magic = FLIGHT_INDEX_MAGIC,
+    .version = FLIGHT_INDEX_VERSION,
+    .entry_size = sizeof(flight_entry_t),
+    .next_id = flight_index->next_id,
+  };
+  size_t size = sizeof(header) + flight_index->count * sizeof(flight_entry_t);
+  size_t written = file.write((const uint8_t*)&header, sizeof(header));
+  written += file.write((const uint8_t*)flight_index->flights, flight_index->count * sizeof(flight_entry_t));
+  file.close();
+  if (written != size)
+    return;
+
+  // The old index is only replaced when the new one has been written. A power loss in between is handled by FlightIndex_Load
+  Storage_Remove(FLIGHT_INDEX_FILENAME);
+  Storage_Rename(FLIGHT_INDEX_TMP_FILENAME, FLIGHT_INDEX_FILENAME);
+  flight_index->file_entries = flight_index->count;
+}
+
+// Updates the entry in RAM and appends it to the index file
+static void FlightIndex_Save(flight_index_t *flight_index, const flight_entry_t *entry) {
+  FlightIndex_Apply(flight_index, entry);
+  if (flight_index->file_entries >= 2 * FLIGHT_INDEX_MAX_FLIGHTS) {
+    FlightIndex_Rewrite(flight_index); // Most of the entries have been replaced
+    return;
+  }
+  File file = Storage_Open(FLIGHT_INDEX_FILENAME, "a");
+  if (!file || file.write((const uint8_t*)entry, sizeof(flight_entry_t)) != sizeof(flight_entry_t))
+    Serial.println(F("Failed writing the flight index"));
+  file.close();
+  flight_index->file_entries++;
+}
+
+// Reads the index file. Returns false if it does not exist or is not valid
+static bool FlightIndex_Load(flight_index_t *flight_index) {
+  if (!Storage_Exists(FLIGHT_INDEX_FILENAME) && Storage_Exists(FLIGHT_INDEX_TMP_FILENAME))
+    Storage_Rename(FLIGHT_INDEX_TMP_FILENAME, FLIGHT_INDEX_FILENAME); // The power was lost while it was rewritten
+  File file = Storage_Open(FLIGHT_INDEX_FILENAME, "r");
+  if (!file)
+    return false;
+  flight_index_header_t header;
+  if (file.read((uint8_t*)&header, sizeof(header)) != sizeof(header) || header.magic != FLIGHT_INDEX_MAGIC ||
+      header.version != FLIGHT_INDEX_VERSION || header.entry_size != sizeof(flight_entry_t)) {
+    file.close();
+    return false;
+  }
+  if (header.next_id > flight_index->next_id)
+    flight_index->next_id = header.next_id;
+
+  flight_entry_t entry;
+  while (file.read((uint8_t*)&entry, sizeof(entry)) == sizeof(entry)) {
+    FlightIndex_Apply(flight_index, &entry);
+    if (entry.id >= flight_index->next_id)
+      flight_index->next_id = entry.id + 1;
+    flight_index->file_entries++;
+  }
+  file.close();
+  return true;
+}
+
+// Deletes a flight and its log file
+bool FlightIndex_Delete(flight_index_t *flight_index, uint32_t id) {
+  if (FlightIndex_IndexOf(flight_index, id) < 0)
+    return false;
+  char path[FLIGHT_INDEX_PATH_SIZE];
+  FlightIndex_GetPath(id, path);
+  Storage_Remove(path);
+  flight_entry_t entry;
+  memset(&entry, 0, sizeof(entry));
+  entry.id = id;
+  entry.flags = FLIGHT_FLAG_DELETED;
+  FlightIndex_Save(flight_index, &entry);
+  Serial.printf("Deleted flight %u\n", id);
+  return true;
+}
+
+// Closes a flight, which was never closed because the power was lost while logging.
+// The log has to be read to the end to count the records, but this is only done once.
+// A file which is not a valid log, such as a log from before the header was added, is kept, so it can still be downloaded
+static void FlightIndex_Recover(flight_index_t *flight_index, uint32_t id) {
+  char path[FLIGHT_INDEX_PATH_SIZE];
+  FlightIndex_GetPath(id, path);
+  flight_entry_t entry = *FlightIndex_Find(flight_index, id);
+  log_reader_t *log_reader = new log_reader_t;
+  ROCKET_ASSERT(log_reader);
+  if (!LogReader_Open(log_reader, Storage_Open(path, "r"))) {
+    entry.size = log_reader->file ? log_reader->file.size() : 0;
+    LogReader_Close(log_reader);
+    delete log_reader;
+    if (entry.size == 0) {
+      FlightIndex_Delete(flight_index, id); // There is nothing to recover
+      return;
+    }
+    entry.records = 0;
+    entry.flags |= FLIGHT_FLAG_CLOSED;
+    FlightIndex_Save(flight_index, &entry);
+    Serial.printf("Flight %u is not a valid log and can only be downloaded in binary\n", id);
+    return;
+  }
+  entry.sample_rate = log_reader->header.sample_rate;
+  entry.size = log_reader->file.size();
+  entry.records = 0;
+  log_record_t record;
+  while (LogReader_Next(log_reader, &record)) {
+    if (record.type != LOG_RECORD_CORRUPTED)
+      entry.records++; // Only the records stored in the log are counted
+  }
+  entry.flags |= FLIGHT_FLAG_CLOSED;
+  LogReader_Close(log_reader);
+  delete log_reader;
+  FlightIndex_Save(flight_index, &entry);
+  Serial.printf("Recovered flight %u with %u records\n", id, entry.records);
+}
+
+// Loads the index from the file system. Flights which were not closed are recovered and a log from before
+// the flights were numbered is added as a new flight
+void FlightIndex_Init(flight_index_t *flight_index, flight_evict_e policy) {
+  flight_index->count = 0;
+  flight_index->next_id = 1;
+  flight_index->file_entries = 0;
+  flight_index->policy = policy;
+  memset(flight_index->open, 0, sizeof(flight_index->open));
+  if (!FlightIndex_Load(flight_index))
+    FlightIndex_Rewrite(flight_index); // Start a new index
+
+  if (Storage_Exists(FLIGHT_INDEX_LEGACY_FILENAME) && flight_index->count < FLIGHT_INDEX_MAX_FLIGHTS) {
+    char path[FLIGHT_INDEX_PATH_SIZE];
+    flight_entry_t entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.id = flight_index->next_id++;
+    FlightIndex_GetPath(entry.id, path);
+    if (Storage_Rename(FLIGHT_INDEX_LEGACY_FILENAME, path))
+      FlightIndex_Save(flight_index, &entry);
+  }
+
+  uint8_t i = 0;
+  while (i < flight_index->count) {
+    uint32_t id = flight_index->flights[i].id;
+    if (!(flight_index->flights[i].flags & FLIGHT_FLAG_CLOSED)) {
+      FlightIndex_Recover(flight_index, id);
+      if (FlightIndex_IndexOf(flight_index, id) < 0)
+        continue; // The flight was deleted
+    }
+    i++;
+  }
+}
+
+// Marks the log of a flight as being read, so it is not deleted to make room for a new flight.
+// Returns false if too many logs are being read already
+bool FlightIndex_Open(flight_index_t *flight_index, uint32_t id) {
+  for (uint8_t i = 0; i < FLIGHT_INDEX_MAX_OPEN; i++) {
+    if (flight_index->open[i] == 0) {
+      flight_index->open[i] = id;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Must be called once for every call to FlightIndex_Open when the log is no longer being read
+void FlightIndex_Release(flight_index_t *flight_index, uint32_t id) {
+  for (uint8_t i = 0; i < FLIGHT_INDEX_MAX_OPEN; i++) {
+    if (flight_index->open[i] == id) {
+      flight_index->open[i] = 0;
+      return;
+    }
+  }
+}
+
+static bool FlightIndex_IsOpen(const flight_index_t *flight_index, uint32_t id) {
+  for (uint8_t i = 0; i < FLIGHT_INDEX_MAX_OPEN; i++) {
+    if (flight_index->open[i] == id)
+      return true;
+  }
+  return false;
+}
+
+// Deletes flights according to the policy until there is room for a new flight. A flight which is being downloaded is skipped
+static void FlightIndex_Evict(flight_index_t *flight_index) {
+  const size_t min_free = Storage_GetSize() / 100 * FLIGHT_INDEX_MIN_FREE;
+  while (flight_index->count > 0 && (flight_index->count >= FLIGHT_INDEX_MAX_FLIGHTS || Storage_GetFree() < min_free)) {
+    const flight_entry_t *oldest = nullptr;
+    for (uint8_t i = 0; i < flight_index->count && oldest == nullptr; i++) {
+      const flight_entry_t *entry = &flight_index->flights[i];
+      if (FlightIndex_IsOpen(flight_index, entry->id))
+        continue;
+      if (flight_index->policy == FLIGHT_EVICT_OLDEST && (entry->flags & FLIGHT_FLAG_CLOSED))
+        oldest = entry;
+      else if (flight_index->policy == FLIGHT_EVICT_DOWNLOADED && (entry->flags & FLIGHT_FLAG_DOWNLOADED))
+        oldest = entry;
+    }
+    if (oldest == nullptr)
+      return; // Nothing can be deleted
+    FlightIndex_Delete(flight_index, oldest->id);
+  }
+}
+
+// Adds a new flight. Returns the id of the flight or zero if there is no room for more flights
+uint32_t FlightIndex_Start(flight_index_t *flight_index, uint32_t start_time, uint16_t sample_rate) {
+  FlightIndex_Evict(flight_index);
+  if (flight_index->count >= FLIGHT_INDEX_MAX_FLIGHTS)
+    return 0;
+  flight_entry_t entry;
+  memset(&entry, 0, sizeof(entry));
+  entry.id = flight_index->next_id++;
+  entry.start_time = start_time;
+  entry.sample_rate = sample_rate;
+  FlightIndex_Save(flight_index, &entry); // The flight is recovered if the log is never closed
+  return entry.id;
+}
+
+// Stores the size of the log file and the number of records once it has been closed
+void FlightIndex_Close(flight_index_t *flight_index, uint32_t id, uint32_t records) {
+  const flight_entry_t *flight = FlightIndex_Find(flight_index, id);
+  if (flight == nullptr)
+    return;
+  char path[FLIGHT_INDEX_PATH_SIZE];
+  FlightIndex_GetPath(id, path);
+  File file = Storage_Open(path, "r");
+  flight_entry_t entry = *flight;
+  entry.size = file ? file.size() : 0;
+  entry.records = records;
+  entry.flags |= FLIGHT_FLAG_CLOSED;
+  file.close();
+  FlightIndex_Save(flight_index, &entry);
+}
+
+// Marks a flight as downloaded, which is used by FLIGHT_EVICT_DOWNLOADED
+void FlightIndex_SetDownloaded(flight_index_t *flight_index, uint32_t id) {
+  const flight_entry_t *flight = FlightIndex_Find(flight_index, id);
+  if (flight == nullptr || (flight->flags & FLIGHT_FLAG_DOWNLOADED))
+    return;
+  flight_entry_t entry = *flight;
+  entry.flags |= FLIGHT_FLAG_DOWNLOADED;
+  FlightIndex_Save(flight_index, &entry);
+}
+
+// Appends to the buffer and keeps track of the length. The output is truncated if the buffer is too small
+static void FlightIndex_Append(char *buffer, size_t size, size_t *length, const char *format, ...) __attribute__((format(printf, 4, 5)));
+static void FlightIndex_Append(char *buffer, size_t size, size_t *length, const char *format, ...) {
+  if (*length >= size)
+    return;
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(&buffer[*length], size - *length, format, args);
+  va_end(args);
+  if (n > 0)
+    *length = *length + n < size ? *length + n : size - 1;
+}
+
+// Formats the flights as a JSON object. Returns the length of the string
+size_t FlightIndex_FormatJson(const flight_index_t *flight_index, char *buffer, size_t size) {
+  size_t length = 0;
+  FlightIndex_Append(buffer, size, &length, "{\"flights\":[");
+  for (uint8_t i = 0; i < flight_index->count; i++) {
+    const flight_entry_t *entry = &flight_index->flights[i];
+    FlightIndex_Append(buffer, size, &length, "%s{\"id\":%u,\"start_time\":%u,\"sample_rate\":%u,\"records\":%u,\"size\":%u,"
+      "\"closed\":%s,\"downloaded\":%s}", i ? "," : "", entry->id, entry->start_time, entry->sample_rate, entry->records, entry->size,
+      entry->flags & FLIGHT_FLAG_CLOSED ? "true" : "false", entry->flags & FLIGHT_FLAG_DOWNLOADED ? "true" : "false");
+  }
+  FlightIndex_Append(buffer, size, &length, "],\"free\":%u}", (uint32_t)Storage_GetFree());
+  return length;
+}
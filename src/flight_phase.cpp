@@ -0,0 +1,135 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <Arduino.h>
+
+#include "altitude.h"
+#include "flight_phase.h"
+
+// Full rate during the boost and around the apogee, where the most happens, and a low rate on the pad and under the parachute.
+// A high oversampling ratio gives less noise, but a longer conversion time
+static const flight_phase_config_t flight_phase_config[FLIGHT_PHASE_COUNT] = {
+  { 100, MS5611_OSR_4096 }, // Pad
+  { 1000, MS5611_OSR_256 }, // Boost
+  { 500, MS5611_OSR_1024 }, // Coast
+  { 1000, MS5611_OSR_1024 }, // Apogee
+  { 50, MS5611_OSR_4096 }, // Descent
+  { 10, MS5611_OSR_4096 }, // Landed
+};
+
+static void FlightPhase_Set(flight_phase_t *flight_phase, flight_phase_e phase, uint32_t timestamp) {
+  flight_phase->phase = phase;
+  flight_phase->phase_timestamp = timestamp;
+}
+
+void FlightPhase_Init(flight_phase_t *flight_phase, float acc_scale_factor, int32_t ground_pressure) {
+  LaunchDetector_Init(&flight_phase->launch_detector, acc_scale_factor, ground_pressure);
+  FlightPhase_SetScale(flight_phase, acc_scale_factor);
+  flight_phase->burnout_below = false;
+  flight_phase->ground_pressure = ground_pressure;
+  flight_phase->max_altitude = 0;
+  flight_phase->apogee_count = 0;
+  flight_phase->landed_altitude = 0;
+  flight_phase->landed_timestamp = 0;
+  FlightPhase_Set(flight_phase, FLIGHT_PHASE_PAD, 0);
+}
+
+// Should be called when the range of the accelerometer changes
+void FlightPhase_SetScale(flight_phase_t *flight_phase, float acc_scale_factor) {
+  LaunchDetector_SetScale(&flight_phase->launch_detector, acc_scale_factor);
+  uint32_t threshold = (uint32_t)(FLIGHT_PHASE_BURNOUT_THRESHOLD * acc_scale_factor);
+  flight_phase->burnout_threshold_squared = threshold * threshold;
+}
+
+// Should be called for every IMU sample. Returns true if the phase changed
+bool FlightPhase_UpdateImu(flight_phase_t *flight_phase, uint32_t timestamp, const sensorRaw_t *acc) {
+  if (flight_phase->phase == FLIGHT_PHASE_PAD) {
+    if (!LaunchDetector_UpdateImu(&flight_phase->launch_detector, timestamp, acc))
+      return false;
+    FlightPhase_Set(flight_phase, FLIGHT_PHASE_BOOST, timestamp);
+    return true;
+  }
+  if (flight_phase->phase != FLIGHT_PHASE_BOOST)
+    return false;
+
+  // The motor has burned out when only the drag is measured
+  uint32_t magnitude_squared = (uint32_t)((int32_t)acc->X * acc->X) + (uint32_t)((int32_t)acc->Y * acc->Y) + (uint32_t)((int32_t)acc->Z * acc->Z);
+  if (magnitude_squared >= flight_phase->burnout_threshold_squared) {
+    flight_phase->burnout_below = false;
+    return false;
+  }
+  if (!flight_phase->burnout_below) {
+    flight_phase->burnout_below = true;
+    flight_phase->burnout_timestamp = timestamp;
+  } else if ((uint32_t)(timestamp - flight_phase->burnout_timestamp) >= FLIGHT_PHASE_BURNOUT_DURATION) {
+    FlightPhase_Set(flight_phase, FLIGHT_PHASE_COAST, timestamp);
+    return true;
+  }
+  return false;
+}
+
+// Should be called for every new pressure reading with the vertical velocity in mm/s from the estimator. Returns true if the phase changed
+bool FlightPhase_UpdatePressure(flight_phase_t *flight_phase, uint32_t timestamp, int32_t pressure, int32_t velocity) {
+  if (flight_phase->phase == FLIGHT_PHASE_PAD) {
+    if (!LaunchDetector_UpdatePressure(&flight_phase->launch_detector, pressure))
+      return false;
+    FlightPhase_Set(flight_phase, FLIGHT_PHASE_BOOST, timestamp);
+    return true;
+  }
+
+  int32_t altitude = Altitude_AboveGround(pressure, flight_phase->ground_pressure);
+  switch (flight_phase->phase) {
+    case FLIGHT_PHASE_BOOST:
+    case FLIGHT_PHASE_COAST:
+      // The burnout might not be detected, so the apogee is detected during the boost as well.
+      // The estimated velocity is only trusted when the altitude is not increasing, as the estimator might not have converged
+      if (altitude >= flight_phase->max_altitude) {
+        flight_phase->max_altitude = altitude;
+        flight_phase->apogee_count = 0;
+      } else if (velocity < 0 || altitude < flight_phase->max_altitude - FLIGHT_PHASE_APOGEE_DROP) {
+        if (++flight_phase->apogee_count >= FLIGHT_PHASE_APOGEE_COUNT) {
+          FlightPhase_Set(flight_phase, FLIGHT_PHASE_APOGEE, timestamp);
+          return true;
+        }
+      } else
+        flight_phase->apogee_count = 0;
+      return false;
+    case FLIGHT_PHASE_APOGEE:
+      if ((uint32_t)(timestamp - flight_phase->phase_timestamp) < FLIGHT_PHASE_APOGEE_DURATION)
+        return false;
+      FlightPhase_Set(flight_phase, FLIGHT_PHASE_DESCENT, timestamp);
+      flight_phase->landed_altitude = altitude;
+      flight_phase->landed_timestamp = timestamp;
+      return true;
+    case FLIGHT_PHASE_DESCENT:
+      // Landed when the altitude stops changing
+      if (abs(altitude - flight_phase->landed_altitude) > FLIGHT_PHASE_LANDED_WINDOW) {
+        flight_phase->landed_altitude = altitude;
+        flight_phase->landed_timestamp = timestamp;
+      } else if ((uint32_t)(timestamp - flight_phase->landed_timestamp) >= FLIGHT_PHASE_LANDED_DURATION) {
+        FlightPhase_Set(flight_phase, FLIGHT_PHASE_LANDED, timestamp);
+        return true;
+      }
+      return false;
+    default:
+      return false;
+  }
+}
+
+const flight_phase_config_t *FlightPhase_GetConfig(flight_phase_e phase) {
+  return &flight_phase_config[phase < FLIGHT_PHASE_COUNT ? phase : FLIGHT_PHASE_PAD];
+}
@@ -0,0 +1,78 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <string.h>
+
+#include "http_range.h"
+
+// Parses a decimal number. Returns nullptr if there are no digits or the value does not fit
+static const char *HttpRange_ParseNumber(const char *p, uint32_t *value) {
+  const char *start = p;
+  uint64_t n = 0;
+  while (*p >= '0' && *p <= '9') {
+    n = n * 10 + (*p++ - '0');
+    if (n > UINT32_MAX)
+      return nullptr;
+  }
+  *value = n;
+  return p != start ? p : nullptr;
+}
+
+static const char *HttpRange_SkipSpaces(const char *p) {
+  while (*p == ' ' || *p == '\t')
+    p++;
+  return p;
+}
+
+// Parses "bytes=first-last", "bytes=first-" or "bytes=-suffix" for a file of "size" bytes.
+// The range is returned as the first and last byte included
+http_range_e HttpRange_Parse(const char *value, uint32_t size, uint32_t *first, uint32_t *last) {
+  static const char unit[] = "bytes=";
+  const char *p = HttpRange_SkipSpaces(value);
+  if (strncmp(p, unit, sizeof(unit) - 1) != 0)
+    return HTTP_RANGE_NONE;
+  p = HttpRange_SkipSpaces(p + sizeof(unit) - 1);
+
+  uint32_t start = 0, end = UINT32_MAX;
+  bool suffix = *p == '-';
+  if (!suffix && (p = HttpRange_ParseNumber(p, &start)) == nullptr)
+    return HTTP_RANGE_NONE;
+  if (*p++ != '-')
+    return HTTP_RANGE_NONE;
+  if (*p >= '0' && *p <= '9' && (p = HttpRange_ParseNumber(p, &end)) == nullptr)
+    return HTTP_RANGE_NONE;
+  if (*HttpRange_SkipSpaces(p) != '\0')
+    return HTTP_RANGE_NONE; // Multiple ranges or garbage
+  if (suffix) {
+    if (end == UINT32_MAX)
+      return HTTP_RANGE_NONE; // Neither the first nor the last byte is given
+    if (end == 0 || size == 0)
+      return HTTP_RANGE_UNSATISFIABLE;
+    start = end < size ? size - end : 0; // The last "end" bytes
+    end = size - 1;
+  } else {
+    if (end < start)
+      return HTTP_RANGE_NONE; // Invalid, so it is ignored
+    if (start >= size)
+      return HTTP_RANGE_UNSATISFIABLE;
+    if (end >= size)
+      end = size - 1;
+  }
+  *first = start;
+  *last = end;
+  return HTTP_RANGE_PARTIAL;
+}
@@ -16,18 +16,49 @@
 */
 
 #include <Wire.h>
+#include <twi.h>
 
 #include "i2c.h"
+#include "rocket_assert.h"
+#include "stats.h"
 
-void I2C_Init(int sda, int scl) {
-  Wire.begin(sda, scl);
-  Wire.setClock(400000UL); // Set I2C frequency to 400kHz
+// The fast driver calls the bit-banged driver of the core directly. This skips the buffering done by Wire,
+// so there is no limit on the length of a read and the MPU-6500 FIFO is emptied in a single transaction
+static bool i2c_fast;
+
+void I2C_Init(int sda, int scl, bool fast /*= false*/) {
+  i2c_fast = fast;
+  if (fast) {
+    twi_init(sda, scl);
+    twi_setClock(I2C_CLOCK);
+  } else {
+    Wire.begin(sda, scl);
+    Wire.setClock(I2C_CLOCK);
+  }
+}
+
+// Returns the most bytes which can be read in a single transaction
+size_t I2C_GetMaxReadSize() {
+  return i2c_fast ? SIZE_MAX : I2C_WIRE_BUFFER_SIZE;
+}
+
+// Returns the same error codes as Wire: 2 if the address is not acknowledged, 3 if the data is not and 4 if the bus is busy
+static uint8_t I2C_FastWrite(uint8_t addr, uint8_t regAddr, const uint8_t *data, size_t size, bool sendStop) {
+  uint8_t buf[I2C_WRITE_BUFFER_SIZE];
+  ROCKET_ASSERT(size < sizeof(buf));
+  buf[0] = regAddr;
+  if (size > 0)
+    memcpy(&buf[1], data, size);
+  return twi_writeTo(addr, buf, 1 + size, sendStop);
 }
 
 uint8_t I2C_Write(uint8_t addr, uint8_t regAddr, bool sendStop /*= true*/) {
+  uint32_t start = Stats_Timestamp();
+  if (i2c_fast)
+    return Stats_I2C(I2C_FastWrite(addr, regAddr, nullptr, 0, sendStop), start);
   Wire.beginTransmission(addr);
   Wire.write(regAddr);
-  return Wire.endTransmission(sendStop); // See: http://arduino.cc/en/Reference/WireEndTransmission
+  return Stats_I2C(Wire.endTransmission(sendStop), start); // See: http://arduino.cc/en/Reference/WireEndTransmission
 }
 
 uint8_t I2C_WriteData(uint8_t addr, uint8_t regAddr, uint8_t data, bool sendStop /*= true*/) {
@@ -35,22 +66,32 @@ uint8_t I2C_WriteData(uint8_t addr, uint8_t regAddr, uint8_t data, bool sendStop
 }
 
 uint8_t I2C_WriteData(uint8_t addr, uint8_t regAddr, uint8_t *data, size_t size, bool sendStop /*= true*/) {
+  uint32_t start = Stats_Timestamp();
+  if (i2c_fast)
+    return Stats_I2C(I2C_FastWrite(addr, regAddr, data, size, sendStop), start);
   Wire.beginTransmission(addr);
   Wire.write(regAddr);
   Wire.write(data, size);
-  return Wire.endTransmission(sendStop); // See: http://arduino.cc/en/Reference/WireEndTransmission
+  return Stats_I2C(Wire.endTransmission(sendStop), start); // See: http://arduino.cc/en/Reference/WireEndTransmission
 }
 
 uint8_t I2C_ReadData(uint8_t addr, uint8_t regAddr, uint8_t *data, size_t size, bool sendStop /*= false*/) {
+  uint32_t start = Stats_Timestamp();
+  if (i2c_fast) {
+    uint8_t rcode = I2C_FastWrite(addr, regAddr, nullptr, 0, sendStop);
+    if (rcode == 0)
+      rcode = twi_readFrom(addr, data, size, true); // Send a repeated start and then release the bus after reading
+    return Stats_I2C(rcode, start);
+  }
   Wire.beginTransmission(addr);
   Wire.write(regAddr);
   uint8_t rcode = Wire.endTransmission(sendStop); // Don't release the bus
   if (rcode)
-    return rcode; // See: http://arduino.cc/en/Reference/WireEndTransmission
+    return Stats_I2C(rcode, start); // See: http://arduino.cc/en/Reference/WireEndTransmission
   size_t read = Wire.requestFrom(addr, size, true); // Send a repeated start and then release the bus after reading
   if (read != size)
-    return 5; // This error value is not already taken by endTransmission
+    return Stats_I2C(5, start); // This error value is not already taken by endTransmission
   for (uint8_t i = 0; i < size; i++)
     data[i] = Wire.read();
-  return 0; // Success
+  return Stats_I2C(0, start); // Success
 }
@@ -0,0 +1,131 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <Arduino.h>
+
+#include "i2c.h"
+#include "i2c_scheduler.h"
+#include "rocket_assert.h"
+#include "stats.h"
+
+static i2c_job_t *jobs[I2C_SCHEDULER_SIZE]; // Pending transactions in the order they were submitted
+static uint8_t job_count;
+
+void I2CScheduler_Init() {
+  job_count = 0;
+}
+
+// Queues a transaction. The fields describing the transfer must be set before it is submitted
+void I2CScheduler_Submit(i2c_job_t *job, uint32_t release_timestamp, uint32_t deadline) {
+  ROCKET_ASSERT(job->state != I2C_JOB_PENDING && job_count < I2C_SCHEDULER_SIZE);
+  job->release_timestamp = release_timestamp;
+  job->deadline = deadline;
+  job->deferred = false;
+  job->state = I2C_JOB_PENDING;
+  jobs[job_count++] = job;
+}
+
+static void I2CScheduler_Remove(uint8_t index) {
+  job_count--;
+  for (uint8_t i = index; i < job_count; i++)
+    jobs[i] = jobs[i + 1];
+}
+
+// Removes the transaction if it has not been done yet
+void I2CScheduler_Cancel(i2c_job_t *job) {
+  for (uint8_t i = 0; i < job_count; i++) {
+    if (jobs[i] == job) {
+      I2CScheduler_Remove(i);
+      break;
+    }
+  }
+  job->state = I2C_JOB_IDLE;
+}
+
+// Returns the time in us the transaction is expected to occupy the bus. Every byte is followed by an acknowledge bit
+static uint32_t I2CScheduler_GetDuration(const i2c_job_t *job) {
+  uint32_t bytes = 2 + job->size + (job->read ? 1 : 0); // The address and register plus the address again for a read
+  return (bytes * 9 + 2) * 1000000UL / I2C_CLOCK + I2C_SCHEDULER_MARGIN_MICROS;
+}
+
+// Returns true if "a" should be done before "b"
+static bool I2CScheduler_IsMoreUrgent(const i2c_job_t *a, const i2c_job_t *b) {
+  if (a->priority != b->priority)
+    return a->priority > b->priority;
+  return (int32_t)(a->deadline - b->deadline) < 0;
+}
+
+// Returns the index of the most urgent transaction, which is released and does not delay a high priority one,
+// or -1 if there is none
+static int8_t I2CScheduler_Next(uint32_t now) {
+  int8_t next = -1;
+  for (uint8_t i = 0; i < job_count; i++) {
+    if ((int32_t)(now - jobs[i]->release_timestamp) >= 0 && (next < 0 || I2CScheduler_IsMoreUrgent(jobs[i], jobs[next])))
+      next = i;
+  }
+  if (next < 0 || jobs[next]->priority == I2C_PRIORITY_HIGH)
+    return next;
+
+  // Hold back a low priority transaction if a high priority one is released before it is done
+  const uint32_t done = now + I2CScheduler_GetDuration(jobs[next]);
+  for (uint8_t i = 0; i < job_count; i++) {
+    if (jobs[i]->priority == I2C_PRIORITY_HIGH && (int32_t)(done - jobs[i]->release_timestamp) > 0) {
+      if (!jobs[next]->deferred) {
+        jobs[next]->deferred = true;
+        stats.i2c_deferred++;
+      }
+      return -1;
+    }
+  }
+  return next;
+}
+
+// The devices do not acknowledge their address if they are busy, in which case no data has been transferred,
+// so the transaction can simply be done again
+static uint8_t I2CScheduler_Transfer(const i2c_job_t *job) {
+  uint8_t rcode = 0;
+  for (uint8_t attempt = 0; attempt <= I2C_SCHEDULER_RETRIES; attempt++) {
+    if (attempt > 0)
+      stats.i2c_retries++;
+    if (job->read)
+      rcode = I2C_ReadData(job->addr, job->reg, job->data, job->size, job->send_stop);
+    else if (job->size == 0)
+      rcode = I2C_Write(job->addr, job->reg);
+    else
+      rcode = I2C_WriteData(job->addr, job->reg, job->data, job->size);
+    if (rcode == 0)
+      break;
+  }
+  return rcode;
+}
+
+// Does the transactions which are due, the most urgent first. Returns the number of transactions done
+uint8_t I2CScheduler_Run() {
+  uint8_t done = 0;
+  int8_t index;
+  while ((index = I2CScheduler_Next(micros())) >= 0) {
+    i2c_job_t *job = jobs[index];
+    I2CScheduler_Remove(index);
+    job->timestamp = micros();
+    job->rcode = I2CScheduler_Transfer(job);
+    if (job->priority == I2C_PRIORITY_HIGH && (int32_t)(micros() - job->deadline) > 0)
+      stats.i2c_missed_deadlines++; // A low priority transaction is expected to wait for the high priority ones
+    job->state = I2C_JOB_DONE;
+    done++;
+  }
+  return done;
+}
@@ -0,0 +1,67 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <Arduino.h>
+
+#include "altitude.h"
+#include "launch_detector.h"
+
+void LaunchDetector_Init(launch_detector_t *launch_detector, float acc_scale_factor, int32_t ground_pressure) {
+  LaunchDetector_SetScale(launch_detector, acc_scale_factor);
+  launch_detector->acc_above = false;
+  launch_detector->ground_pressure = ground_pressure;
+  launch_detector->altitude_count = 0;
+  launch_detector->cause = LAUNCH_DETECTOR_NONE;
+}
+
+// Should be called when the range of the accelerometer changes
+void LaunchDetector_SetScale(launch_detector_t *launch_detector, float acc_scale_factor) {
+  // Compare the squared magnitude, so no square root is needed
+  uint32_t threshold = (uint32_t)(LAUNCH_DETECTOR_ACC_THRESHOLD * acc_scale_factor);
+  launch_detector->acc_threshold_squared = threshold * threshold;
+}
+
+// Returns true once the launch is detected
+bool LaunchDetector_UpdateImu(launch_detector_t *launch_detector, uint32_t timestamp, const sensorRaw_t *acc) {
+  if (launch_detector->cause != LAUNCH_DETECTOR_NONE)
+    return true;
+
+  // The squared magnitude of three 16-bit values fits in 32 bits
+  uint32_t magnitude_squared = (uint32_t)((int32_t)acc->X * acc->X) + (uint32_t)((int32_t)acc->Y * acc->Y) + (uint32_t)((int32_t)acc->Z * acc->Z);
+  if (magnitude_squared < launch_detector->acc_threshold_squared) {
+    launch_detector->acc_above = false;
+    return false;
+  }
+  if (!launch_detector->acc_above) {
+    launch_detector->acc_above = true;
+    launch_detector->acc_timestamp = timestamp;
+  } else if ((uint32_t)(timestamp - launch_detector->acc_timestamp) >= LAUNCH_DETECTOR_ACC_DURATION)
+    launch_detector->cause = LAUNCH_DETECTOR_ACC;
+  return launch_detector->cause != LAUNCH_DETECTOR_NONE;
+}
+
+// Should be called for every new pressure reading. Returns true once the launch is detected
+bool LaunchDetector_UpdatePressure(launch_detector_t *launch_detector, int32_t pressure) {
+  if (launch_detector->cause != LAUNCH_DETECTOR_NONE)
+    return true;
+
+  if (Altitude_AboveGround(pressure, launch_detector->ground_pressure) < LAUNCH_DETECTOR_ALTITUDE_THRESHOLD)
+    launch_detector->altitude_count = 0;
+  else if (++launch_detector->altitude_count >= LAUNCH_DETECTOR_ALTITUDE_COUNT)
+    launch_detector->cause = LAUNCH_DETECTOR_ALTITUDE;
+  return launch_detector->cause != LAUNCH_DETECTOR_NONE;
+}
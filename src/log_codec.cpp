@@ -0,0 +1,134 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <string.h>
+
+#include "log_codec.h"
+
+static inline uint32_t LogCodec_ZigZag(int32_t value) {
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static inline int32_t LogCodec_UnZigZag(uint32_t value) {
+  return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static inline uint8_t *LogCodec_PutVarint(uint8_t *out, uint32_t value) {
+  while (value >= 0x80) {
+    *out++ = (uint8_t)value | 0x80;
+    value >>= 7;
+  }
+  *out++ = (uint8_t)value;
+  return out;
+}
+
+// Returns NULL if the varint is truncated or longer than five bytes
+static inline const uint8_t *LogCodec_GetVarint(const uint8_t *in, const uint8_t *end, uint32_t *value) {
+  uint32_t result = 0;
+  for (uint8_t shift = 0; shift < 35 && in < end; shift += 7) {
+    uint8_t byte = *in++;
+    result |= (uint32_t)(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      *value = result;
+      return in;
+    }
+  }
+  return NULL;
+}
+
+void LogCodec_Reset(log_codec_state_t *state) {
+  memset(state, 0, sizeof(log_codec_state_t));
+}
+
+// Encodes a record into "out", which must have room for at least LOG_CODEC_MAX_RECORD_SIZE bytes.
+// Returns the number of bytes written
+size_t LogCodec_Encode(log_codec_state_t *state, const log_record_t *record, uint8_t *out) {
+  uint8_t *p = out;
+
+  // The timestamp is stored as the change in the time difference
+  uint32_t dt = record->timestamp - state->timestamp;
+  p = LogCodec_PutVarint(p, LogCodec_ZigZag((int32_t)(dt - state->dt)));
+  state->timestamp = record->timestamp;
+  state->dt = dt;
+
+  if (record->type != LOG_RECORD_SAMPLE) {
+    // Events are rare, so the arguments are simply stored as varints. The lowest bit marks the record as an event
+    p = LogCodec_PutVarint(p, ((uint32_t)record->type << 1) | 1U);
+    for (uint8_t i = 0; i < 3; i++)
+      p = LogCodec_PutVarint(p, record->event.arg[i]);
+    return p - out;
+  }
+
+  int32_t pressure = LogFormat_GetPressure(record);
+  p = LogCodec_PutVarint(p, LogCodec_ZigZag(pressure - state->pressure) << 1); // The pressure is at most 24 bits, so there is room for the event bit
+  state->pressure = pressure;
+
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    p = LogCodec_PutVarint(p, LogCodec_ZigZag((int32_t)record->sample.gyro.data[axis] - state->gyro.data[axis]));
+    state->gyro.data[axis] = record->sample.gyro.data[axis];
+  }
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    p = LogCodec_PutVarint(p, LogCodec_ZigZag((int32_t)record->sample.acc.data[axis] - state->acc.data[axis]));
+    state->acc.data[axis] = record->sample.acc.data[axis];
+  }
+
+  return p - out;
+}
+
+// Decodes a single record. Returns the number of bytes consumed or 0 if the data is corrupted
+size_t LogCodec_Decode(log_codec_state_t *state, const uint8_t *in, size_t len, log_record_t *record) {
+  const uint8_t *p = in, *end = in + len;
+  uint32_t value;
+
+  if (!(p = LogCodec_GetVarint(p, end, &value)))
+    return 0;
+  state->dt += (uint32_t)LogCodec_UnZigZag(value);
+  state->timestamp += state->dt;
+  record->timestamp = state->timestamp;
+
+  if (!(p = LogCodec_GetVarint(p, end, &value)))
+    return 0;
+  if (value & 1U) {
+    record->type = (uint8_t)(value >> 1);
+    memset(record->event.reserved, 0, sizeof(record->event.reserved));
+    for (uint8_t i = 0; i < 3; i++) {
+      if (!(p = LogCodec_GetVarint(p, end, &value)))
+        return 0;
+      record->event.arg[i] = value;
+    }
+    return p - in;
+  }
+
+  record->type = LOG_RECORD_SAMPLE;
+  state->pressure += LogCodec_UnZigZag(value >> 1);
+  LogFormat_SetPressure(record, state->pressure);
+
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    if (!(p = LogCodec_GetVarint(p, end, &value)))
+      return 0;
+    state->gyro.data[axis] = (int16_t)(state->gyro.data[axis] + LogCodec_UnZigZag(value));
+    record->sample.gyro.data[axis] = state->gyro.data[axis];
+  }
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    if (!(p = LogCodec_GetVarint(p, end, &value)))
+      return 0;
+    state->acc.data[axis] = (int16_t)(state->acc.data[axis] + LogCodec_UnZigZag(value));
+    record->sample.acc.data[axis] = state->acc.data[axis];
+  }
+
+  return p - in;
+}
@@ -0,0 +1,177 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <Arduino.h>
+
+#include "log_reader.h"
+
+// Reads from either the file or the raw flash region
+static size_t LogReader_Read(log_reader_t *log_reader, uint8_t *data, size_t size) {
+  if (log_reader->flash_log) {
+    size_t n = FlashLog_Read(log_reader->flash_log, log_reader->flash_offset, data, size);
+    log_reader->flash_offset += n;
+    return n;
+  }
+  int n = log_reader->file.read(data, size);
+  return n > 0 ? n : 0;
+}
+
+// Reads and validates the header. Returns false if the file is not a log file
+static bool LogReader_ReadHeader(log_reader_t *log_reader) {
+  log_reader->length = log_reader->position = log_reader->block_remaining = 0;
+  log_reader->corrupted_blocks = 0;
+  log_reader->error = false;
+  if (!log_reader->flash_log && !log_reader->file)
+    return false;
+
+  // Read the fixed part of the header first, as the size of the header depends on the version
+  log_header_t *header = &log_reader->header;
+  memset(header, 0, sizeof(log_header_t));
+  const size_t fixed_size = offsetof(log_header_t, record_size);
+  if (LogReader_Read(log_reader, (uint8_t*)header, fixed_size) != fixed_size)
+    return false;
+  if (header->magic != LOG_MAGIC || header->version > LOG_VERSION || header->header_size < fixed_size)
+    return false;
+
+  // Fields added in later versions are skipped
+  size_t size = header->header_size < sizeof(log_header_t) ? header->header_size : sizeof(log_header_t);
+  if (LogReader_Read(log_reader, (uint8_t*)header + fixed_size, size - fixed_size) != size - fixed_size)
+    return false;
+  if (header->record_size != sizeof(log_record_t))
+    return false;
+  if (log_reader->flash_log) {
+    log_reader->flash_offset = header->header_size;
+    return true;
+  }
+  return log_reader->file.seek(header->header_size, SeekSet);
+}
+
+bool LogReader_Open(log_reader_t *log_reader, File file) {
+  log_reader->file = file;
+  log_reader->flash_log = nullptr;
+  return LogReader_ReadHeader(log_reader);
+}
+
+// Reads the log stored in a raw flash region
+bool LogReader_OpenFlash(log_reader_t *log_reader, const flash_log_t *flash_log) {
+  log_reader->file = File();
+  log_reader->flash_log = flash_log;
+  log_reader->flash_offset = 0;
+  return LogReader_ReadHeader(log_reader);
+}
+
+static bool LogReader_NextRaw(log_reader_t *log_reader, log_record_t *record) {
+  if ((size_t)(log_reader->length - log_reader->position) < sizeof(log_record_t)) {
+    // Move the remaining bytes to the front and refill the buffer using a single read
+    log_reader->length -= log_reader->position;
+    memmove(log_reader->buffer, &log_reader->buffer[log_reader->position], log_reader->length);
+    log_reader->position = 0;
+    log_reader->length += LogReader_Read(log_reader, &log_reader->buffer[log_reader->length], sizeof(log_reader->buffer) - log_reader->length);
+    if (log_reader->length < sizeof(log_record_t)) {
+      log_reader->error = log_reader->length > 0; // The file ends with an incomplete record
+      return false;
+    }
+  }
+  memcpy(record, &log_reader->buffer[log_reader->position], sizeof(log_record_t));
+  log_reader->position += sizeof(log_record_t);
+  return true;
+}
+
+// Returns the offset in the log of the next byte to be read
+static uint32_t LogReader_Offset(const log_reader_t *log_reader) {
+  return log_reader->flash_log ? log_reader->flash_offset : log_reader->file.position();
+}
+
+// Skips the rest of a compressed block, which could not be decoded, and returns a LOG_RECORD_CORRUPTED record in its
+// place. The records decoded before it are kept and the reading continues from the next block, see LogCodec_NextBlock()
+static bool LogReader_SkipBlock(log_reader_t *log_reader, log_record_t *record) {
+  LogFormat_SetCorrupted(record, log_reader->block_offset);
+  log_reader->corrupted_blocks++;
+  log_reader->block_remaining = 0;
+  uint32_t next = LogCodec_NextBlock(log_reader->block_offset);
+  if (log_reader->flash_log)
+    log_reader->flash_offset = next; // Nothing is read past the end of the log
+  else if (!log_reader->file.seek(next < log_reader->file.size() ? next : log_reader->file.size(), SeekSet))
+    log_reader->error = true;
+  return true;
+}
+
+static bool LogReader_NextCompressed(log_reader_t *log_reader, log_record_t *record) {
+  while (log_reader->block_remaining == 0) {
+    // Read the next block
+    log_block_header_t block_header;
+    log_reader->block_offset = LogReader_Offset(log_reader);
+    size_t n = LogReader_Read(log_reader, (uint8_t*)&block_header, sizeof(block_header));
+    if (n == 0)
+      return false; // End of file
+    if (n != sizeof(block_header) || !LogCodec_IsValidBlock(log_reader->block_offset, &block_header))
+      return LogReader_SkipBlock(log_reader, record);
+    log_reader->length = block_header.length - sizeof(block_header);
+    if (LogReader_Read(log_reader, log_reader->buffer, log_reader->length) != log_reader->length)
+      return LogReader_SkipBlock(log_reader, record); // The file ends within the block
+    log_reader->position = 0;
+    log_reader->block_remaining = block_header.count;
+    LogCodec_Reset(&log_reader->codec);
+  }
+
+  size_t n = LogCodec_Decode(&log_reader->codec, &log_reader->buffer[log_reader->position],
+                             log_reader->length - log_reader->position, record);
+  if (n == 0)
+    return LogReader_SkipBlock(log_reader, record);
+  log_reader->position += n;
+  log_reader->block_remaining--;
+  return true;
+}
+
+// Returns false when there are no more records or the rest of the file can not be read. A compressed block which can
+// not be decoded is returned as a single LOG_RECORD_CORRUPTED record instead
+bool LogReader_Next(log_reader_t *log_reader, log_record_t *record) {
+  if (log_reader->error)
+    return false;
+  if (log_reader->header.flags & LOG_FLAG_COMPRESSED)
+    return LogReader_NextCompressed(log_reader, record);
+  return LogReader_NextRaw(log_reader, record);
+}
+
+// Returns the offset in the log of the next record, so the reading can be continued from there using LogReader_Seek.
+// Compressed records can only be found from the start of a block, so false is returned in the middle of a block
+bool LogReader_Tell(const log_reader_t *log_reader, uint32_t *offset) {
+  if (log_reader->header.flags & LOG_FLAG_COMPRESSED) {
+    if (log_reader->block_remaining > 0)
+      return false;
+    *offset = LogReader_Offset(log_reader); // The whole block has been read
+    return true;
+  }
+  *offset = LogReader_Offset(log_reader) - (log_reader->length - log_reader->position); // Skip the records which are still in the buffer
+  return true;
+}
+
+// Continues reading from an offset returned by LogReader_Tell
+bool LogReader_Seek(log_reader_t *log_reader, uint32_t offset) {
+  log_reader->length = log_reader->position = log_reader->block_remaining = 0;
+  log_reader->error = false;
+  if (log_reader->flash_log) {
+    log_reader->flash_offset = offset;
+    return true;
+  }
+  return log_reader->file.seek(offset, SeekSet);
+}
+
+void LogReader_Close(log_reader_t *log_reader) {
+  if (!log_reader->flash_log)
+    log_reader->file.close();
+}
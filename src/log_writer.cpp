@@ -0,0 +1,256 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <Arduino.h>
+
+#include "rocket_assert.h"
+#include "log_writer.h"
+#include "stats.h"
+
+// Copy the data into the active buffer. The data is split across both buffers if it does not fit,
+// so the buffers are always completely filled before they are written.
+// Returns the index of the buffer where the data ends
+static uint8_t LogWriter_Append(log_writer_t *log_writer, const void *data, size_t size) {
+  const uint8_t *src = (const uint8_t*)data;
+  uint8_t last = log_writer->active;
+  while (size > 0) {
+    last = log_writer->active;
+    uint16_t *length = &log_writer->length[last];
+    size_t n = LOG_WRITER_BUFFER_SIZE - *length;
+    if (n > size)
+      n = size;
+    memcpy(&log_writer->buffer[last][*length], src, n);
+    *length += n;
+    src += n;
+    size -= n;
+    if (*length == LOG_WRITER_BUFFER_SIZE) {
+      log_writer->full[last] = true;
+      log_writer->active = !last; // Continue in the other buffer
+    }
+  }
+  return last;
+}
+
+static void LogWriter_Init(log_writer_t *log_writer, const log_header_t *header) {
+  for (uint8_t i = 0; i < 2; i++) {
+    log_writer->length[i] = log_writer->records[i] = 0;
+    log_writer->full[i] = false;
+  }
+  log_writer->active = 0;
+  log_writer->write_error = false;
+  log_writer->written = log_writer->dropped = log_writer->total_dropped = 0;
+  log_writer->flush_count = log_writer->max_flush_micros = 0;
+  log_writer->compressed = header->flags & LOG_FLAG_COMPRESSED;
+  log_writer->block_open = false;
+
+  // The header goes through the buffers as well, so all writes stay aligned to the buffer size
+  LogWriter_Append(log_writer, header, sizeof(log_header_t));
+}
+
+void LogWriter_Open(log_writer_t *log_writer, File file, const log_header_t *header) {
+  ROCKET_ASSERT(file);
+  log_writer->file = file;
+  log_writer->flash_log = nullptr;
+  LogWriter_Init(log_writer, header);
+}
+
+// Writes the log directly to a raw flash region, which must already be opened
+void LogWriter_OpenFlash(log_writer_t *log_writer, flash_log_t *flash_log, const log_header_t *header) {
+  ROCKET_ASSERT(FlashLog_IsOpen(flash_log));
+  log_writer->file = File();
+  log_writer->flash_log = flash_log;
+  LogWriter_Init(log_writer, header);
+}
+
+bool LogWriter_IsOpen(const log_writer_t *log_writer) {
+  return log_writer->file || log_writer->flash_log;
+}
+
+// Returns the number of bytes that can be appended without touching a buffer waiting to be written
+static size_t LogWriter_Free(const log_writer_t *log_writer) {
+  size_t free = 0;
+  for (uint8_t i = 0; i < 2; i++) {
+    if (!log_writer->full[i])
+      free += LOG_WRITER_BUFFER_SIZE - log_writer->length[i];
+  }
+  return free;
+}
+
+static bool LogWriter_PutRaw(log_writer_t *log_writer, const log_record_t *record) {
+  if (LogWriter_Free(log_writer) < sizeof(log_record_t))
+    return false;
+  log_writer->records[LogWriter_Append(log_writer, record, sizeof(log_record_t))]++; // The record is counted in the buffer where it ends
+  return true;
+}
+
+// Fills in the block header and pads the rest of the buffer, so the block ends at the buffer boundary
+static void LogWriter_CloseBlock(log_writer_t *log_writer, bool pad) {
+  uint8_t i = log_writer->active;
+  if (pad) {
+    memset(&log_writer->buffer[i][log_writer->length[i]], 0, LOG_WRITER_BUFFER_SIZE - log_writer->length[i]);
+    log_writer->length[i] = LOG_WRITER_BUFFER_SIZE;
+  }
+  log_block_header_t block_header = {
+    .length = (uint16_t)(log_writer->length[i] - log_writer->block_start),
+    .count = log_writer->block_count,
+  };
+  memcpy(&log_writer->buffer[i][log_writer->block_start], &block_header, sizeof(block_header));
+  log_writer->block_open = false;
+  if (pad) {
+    log_writer->full[i] = true;
+    log_writer->active = !i; // Continue in the other buffer
+  }
+}
+
+static bool LogWriter_PutCompressed(log_writer_t *log_writer, const log_record_t *record) {
+  uint8_t encoded[LOG_CODEC_MAX_RECORD_SIZE];
+  if (log_writer->block_open) {
+    // Encode using a copy of the state, as the block has to be restarted if the record does not fit
+    log_codec_state_t state = log_writer->codec;
+    size_t n = LogCodec_Encode(&state, record, encoded);
+    uint8_t i = log_writer->active;
+    if (log_writer->length[i] + n <= LOG_WRITER_BUFFER_SIZE) {
+      memcpy(&log_writer->buffer[i][log_writer->length[i]], encoded, n);
+      log_writer->length[i] += n;
+      log_writer->codec = state;
+      log_writer->block_count++;
+      log_writer->records[i]++;
+      return true;
+    }
+    LogWriter_CloseBlock(log_writer, true);
+  }
+
+  // Start a new block in the active buffer
+  uint8_t i = log_writer->active;
+  if (log_writer->full[i])
+    return false; // Both buffers are waiting to be written
+  log_writer->block_open = true;
+  log_writer->block_start = log_writer->length[i];
+  log_writer->block_count = 1;
+  log_writer->length[i] += sizeof(log_block_header_t); // The header is filled in when the block is closed
+  LogCodec_Reset(&log_writer->codec);
+  size_t n = LogCodec_Encode(&log_writer->codec, record, encoded); // There is always room for a record in a new block
+  memcpy(&log_writer->buffer[i][log_writer->length[i]], encoded, n);
+  log_writer->length[i] += n;
+  log_writer->records[i]++;
+  return true;
+}
+
+static bool LogWriter_Put(log_writer_t *log_writer, const log_record_t *record) {
+  if (log_writer->compressed)
+    return LogWriter_PutCompressed(log_writer, record);
+  return LogWriter_PutRaw(log_writer, record);
+}
+
+// Writes a buffer to the file and measures how long it took
+static void LogWriter_WriteBuffer(log_writer_t *log_writer, uint8_t i) {
+  uint32_t start = micros(), start_cycles = Stats_Timestamp();
+  size_t written = log_writer->flash_log ? FlashLog_Write(log_writer->flash_log, log_writer->buffer[i], log_writer->length[i]) :
+                                          log_writer->file.write(log_writer->buffer[i], log_writer->length[i]);
+  Stats_Record(&stats.flash, start_cycles);
+  uint32_t duration = micros() - start;
+  if (duration > log_writer->max_flush_micros)
+    log_writer->max_flush_micros = duration;
+  log_writer->flush_count++;
+
+  if (written != log_writer->length[i]) {
+    log_writer->write_error = true;
+    log_writer->dropped += log_writer->records[i];
+    log_writer->total_dropped += log_writer->records[i];
+  } else
+    log_writer->written += log_writer->records[i];
+
+  log_writer->length[i] = log_writer->records[i] = 0;
+  log_writer->full[i] = false;
+}
+
+// Returns true if a record and a dropped marker can be written without dropping anything
+bool LogWriter_HasRoom(const log_writer_t *log_writer) {
+  if (!LogWriter_IsOpen(log_writer) || log_writer->full[log_writer->active])
+    return false; // Both buffers are waiting to be written
+  const size_t needed = 2 * (log_writer->compressed ? sizeof(log_block_header_t) + LOG_CODEC_MAX_RECORD_SIZE : sizeof(log_record_t));
+  return LOG_WRITER_BUFFER_SIZE - log_writer->length[log_writer->active] >= needed || !log_writer->full[!log_writer->active];
+}
+
+// Appends a record to the buffer. The record is dropped if both buffers are waiting to be written.
+// The number of dropped records is written to the file before the next record that is written
+bool LogWriter_Write(log_writer_t *log_writer, const log_record_t *record) {
+  if (!LogWriter_IsOpen(log_writer))
+    return false;
+
+  if (log_writer->dropped > 0) {
+    log_record_t marker;
+    memset(&marker, 0, sizeof(marker));
+    marker.timestamp = record->timestamp;
+    marker.type = LOG_RECORD_DROPPED;
+    marker.event.arg[0] = log_writer->dropped;
+    if (!LogWriter_Put(log_writer, &marker)) {
+      log_writer->dropped++;
+      log_writer->total_dropped++;
+      return false;
+    }
+    log_writer->dropped = 0;
+  }
+
+  if (!LogWriter_Put(log_writer, record)) {
+    log_writer->dropped++;
+    log_writer->total_dropped++;
+    return false;
+  }
+  return true;
+}
+
+// Writes at most one full buffer to the file, so the time spent is bounded by a single flash write
+void LogWriter_Service(log_writer_t *log_writer) {
+  if (!LogWriter_IsOpen(log_writer))
+    return;
+
+  // If both buffers are full, then the active one is the oldest, as we always continue in the other buffer
+  uint8_t i = log_writer->full[log_writer->active] ? log_writer->active : !log_writer->active;
+  if (log_writer->full[i])
+    LogWriter_WriteBuffer(log_writer, i);
+}
+
+// Returns true if less than the given number of bytes of the raw flash region are erased and no buffer is waiting to be written
+bool LogWriter_NeedsErase(const log_writer_t *log_writer, uint32_t size) {
+  return log_writer->flash_log && !log_writer->full[0] && !log_writer->full[1] && !FlashLog_IsErased(log_writer->flash_log, size);
+}
+
+// Erases the next sector of the raw flash region. This blocks for the time it takes to erase a sector
+void LogWriter_EraseAhead(log_writer_t *log_writer) {
+  if (log_writer->flash_log && !FlashLog_EraseAhead(log_writer->flash_log))
+    log_writer->write_error = true;
+}
+
+// Writes all buffered records and closes the file
+void LogWriter_Close(log_writer_t *log_writer) {
+  if (!LogWriter_IsOpen(log_writer))
+    return;
+
+  if (log_writer->block_open)
+    LogWriter_CloseBlock(log_writer, false); // The last block does not need to be padded
+  while (log_writer->full[0] || log_writer->full[1])
+    LogWriter_Service(log_writer);
+  if (log_writer->length[log_writer->active] > 0)
+    LogWriter_WriteBuffer(log_writer, log_writer->active); // Write the partially filled buffer
+  if (log_writer->flash_log) {
+    FlashLog_Close(log_writer->flash_log);
+    log_writer->flash_log = nullptr;
+  } else
+    log_writer->file.close();
+  log_writer->write_error = false; // The error has been handled by closing the log
+}
@@ -0,0 +1,554 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <Arduino.h>
+
+#include "altitude.h"
+#include "i2c_scheduler.h"
+#include "log_format.h"
+#include "logger.h"
+#include "rocket_assert.h"
+#include "storage.h"
+
+#define LOGGER_FS_CHECK_INTERVAL    (10U) // The file system is checked for free space every n samples
+#define LOGGER_ESTIMATE_INTERVAL    (20000UL) // Time in us between the estimates written to the log
+#define LOGGER_MS5611_OSR           (MS5611_OSR_256) // Sample as fast as possible when the rate does not follow the flight phase
+#define LOGGER_FLASH_RESERVE        (2U * LOG_WRITER_BUFFER_SIZE + LOGGER_PRETRIGGER_SIZE * sizeof(log_record_t)) // Room for the queued and buffered records when logging to a raw flash region
+
+void Logger_Init(logger_t *logger, uint16_t sample_rate, bool use_fifo) {
+  logger->sample_rate = sample_rate;
+  logger->start_timestamp = logger->stop_timestamp = 0;
+  logger->samples = 0;
+  logger->fs_check_counter = 0;
+  logger->erasing = false;
+  logger->adaptive_rate = logger->phase_pending = false;
+  logger->auto_ranging = logger->range_pending = false;
+  logger->log_estimates = false;
+  logger->telemetry = nullptr;
+
+  I2CScheduler_Init();
+  MPU6500_Init(&logger->mpu6500, sample_rate, use_fifo);
+  Serial.println(F("MPU6500 configured"));
+
+  MS5611_Init(&logger->ms5611, LOGGER_MS5611_OSR, 10); // Only convert the temperature every 10th time
+  Serial.println(F("MS5611 configured"));
+  logger->ground_pressure_filtered = logger->ms5611.pressure << 4;
+}
+
+void Logger_SetSampleRate(logger_t *logger, uint16_t sample_rate) {
+  logger->sample_rate = constrain(sample_rate, MPU6500_MIN_SAMPLE_RATE, MPU6500_MAX_SAMPLE_RATE);
+  Serial.print(F("New sample rate: ")); Serial.println(logger->sample_rate);
+  ROCKET_ASSERT(MPU6500_SetSampleRate(&logger->mpu6500, logger->sample_rate) == 0);
+}
+
+// Let the sample rates follow the flight phase. The configured sample rate is used as the maximum
+void Logger_SetAdaptiveRate(logger_t *logger, bool enabled) {
+  logger->adaptive_rate = enabled;
+}
+
+// Let the full-scale ranges of the IMU follow the readings. The configured ranges are used until the readings call for
+// other ranges. Every change is written to the log
+void Logger_SetAutoRange(logger_t *logger, bool enabled) {
+  logger->auto_ranging = enabled;
+  logger->range_pending = false;
+  AutoRange_Init(&logger->auto_range, &logger->mpu6500.config_range, micros());
+}
+
+// Write the altitude, velocity and attitude found by the estimator to the log
+void Logger_SetLogEstimates(logger_t *logger, bool enabled) {
+  logger->log_estimates = enabled;
+}
+
+void Logger_SetTelemetry(logger_t *logger, telemetry_t *telemetry) {
+  logger->telemetry = telemetry;
+}
+
+int32_t Logger_GetGroundPressure(const logger_t *logger) {
+  return logger->ground_pressure_filtered >> 4;
+}
+
+// Fills in the header and resets the counters for a new log. The header stores everything needed to convert the raw readings
+static void Logger_Prepare(logger_t *logger, log_header_t *header, int32_t ground_pressure, bool compressed) {
+  header->magic = LOG_MAGIC;
+  header->version = LOG_VERSION;
+  header->header_size = sizeof(log_header_t);
+  header->record_size = sizeof(log_record_t);
+  header->sample_rate = logger->sample_rate;
+  header->gyroScaleFactor = logger->mpu6500.gyroScaleFactor;
+  header->accScaleFactor = logger->mpu6500.accScaleFactor;
+  memcpy(header->prom_c, logger->ms5611.prom_c, sizeof(header->prom_c));
+  header->flags = compressed ? LOG_FLAG_COMPRESSED : 0;
+  header->ground_pressure = ground_pressure; // The altitude is shown relative to this
+  Serial.print(F("Ground pressure: ")); Serial.println(header->ground_pressure);
+
+  logger->start_timestamp = micros(); // Reset the start timestamp
+  logger->samples = 0;
+  logger->commit_timestamp = logger->start_timestamp;
+  logger->fs_check_counter = 0;
+  logger->erasing = false;
+  RecordQueue_Init(&logger->queue);
+  logger->queue_dropped = 0;
+  logger->dropped = 0;
+  logger->imu_dropped = logger->mpu6500.fifo_dropped;
+  logger->armed = false;
+  logger->range = logger->mpu6500.range; // The header has the scale factors of the newest readings
+  FlightPhase_Init(&logger->flight_phase, logger->mpu6500.accScaleFactor, ground_pressure);
+  logger->phase_pending = true; // Switch to the rates used on the pad
+  logger->rate_timestamp = logger->start_timestamp;
+  logger->expected_samples = 0;
+  Estimator_Init(&logger->estimator, logger->mpu6500.gyroScaleFactor, logger->mpu6500.accScaleFactor, ground_pressure);
+  logger->estimate_timestamp = 0;
+  Stats_Reset(); // The counters cover a single log
+}
+
+void Logger_Start(logger_t *logger, File file, int32_t ground_pressure, bool compressed) {
+  log_header_t header;
+  Logger_Prepare(logger, &header, ground_pressure, compressed);
+  LogWriter_Open(&logger->log_writer, file, &header);
+}
+
+// Logs directly to a raw flash region. The previous log in the region is lost.
+// The first LOGGER_FLASH_ERASE_SIZE bytes are erased before the samples are logged, see Logger_Erase()
+void Logger_StartFlash(logger_t *logger, flash_log_t *flash_log, int32_t ground_pressure, bool compressed) {
+  if (!FlashLog_Open(flash_log)) {
+    Serial.println(F("Failed to erase the flash"));
+    return;
+  }
+  log_header_t header;
+  Logger_Prepare(logger, &header, ground_pressure, compressed);
+  LogWriter_OpenFlash(&logger->log_writer, flash_log, &header);
+  logger->erasing = true;
+  Serial.println(F("Erasing the flash"));
+}
+
+// Only write the samples to the log once the launch is detected. The latest samples are kept in RAM until then
+void Logger_Arm(logger_t *logger) {
+  logger->armed = true;
+  Serial.println(F("Armed, waiting for launch"));
+}
+
+bool Logger_IsArmed(const logger_t *logger) {
+  return Logger_IsLogging(logger) && logger->armed && !logger->erasing;
+}
+
+// Adds a record to the end of the queue. If the queue is full, then the record is dropped and the number of dropped
+// samples is queued before the next record. This is called by the sampling path
+static void Logger_Queue(logger_t *logger, const log_record_t *record) {
+  record_queue_t *queue = &logger->queue;
+  const uint16_t needed = logger->queue_dropped > 0 ? 2 : 1;
+  if (RecordQueue_GetFree(queue) < needed) {
+    if (record->type == LOG_RECORD_SAMPLE)
+      logger->queue_dropped++;
+    return;
+  }
+
+  if (logger->queue_dropped > 0) {
+    log_record_t marker;
+    memset(&marker, 0, sizeof(log_record_t));
+    marker.timestamp = record->timestamp;
+    marker.type = LOG_RECORD_DROPPED;
+    marker.event.arg[0] = logger->queue_dropped;
+    logger->queue_dropped = 0;
+    RecordQueue_Push(queue, &marker);
+  }
+  RecordQueue_Push(queue, record);
+  Stats_HighWater(&stats.queue_high_water, RecordQueue_GetCount(queue));
+}
+
+// Moves the queued records to the log writer as long as there is room in its buffers.
+// While armed the records older than LOGGER_PRETRIGGER_MS are discarded instead, so only the newest samples are kept
+static void Logger_Commit(logger_t *logger) {
+  record_queue_t *queue = &logger->queue;
+  if (logger->armed) {
+    const log_record_t *newest = RecordQueue_GetNewest(queue), *record;
+    while ((record = RecordQueue_Peek(queue)) != nullptr && (RecordQueue_GetCount(queue) > LOGGER_PRETRIGGER_SIZE ||
+           newest->timestamp - record->timestamp > LOGGER_PRETRIGGER_MS * 1000UL)) {
+      // The samples kept are converted using the range and the phase gives the sample rate, so these are written right away
+      if (record->type == LOG_RECORD_RANGE || record->type == LOG_RECORD_PHASE)
+        LogWriter_Write(&logger->log_writer, record);
+      RecordQueue_Pop(queue);
+    }
+    return;
+  }
+  const log_record_t *record;
+  while ((record = RecordQueue_Peek(queue)) != nullptr && LogWriter_HasRoom(&logger->log_writer)) {
+    if (LogWriter_Write(&logger->log_writer, record)) {
+      if (record->type == LOG_RECORD_SAMPLE)
+        logger->samples++;
+      else if (record->type == LOG_RECORD_DROPPED)
+        logger->dropped += record->event.arg[0]; // Lost by the FIFO or dropped because the queue was full
+    }
+    RecordQueue_Pop(queue);
+  }
+}
+
+static void Logger_Launch(logger_t *logger) {
+  // The marker gets the time of the newest sample
+  const log_record_t *newest = RecordQueue_GetNewest(&logger->queue);
+  log_record_t record;
+  memset(&record, 0, sizeof(record));
+  record.timestamp = newest ? newest->timestamp : micros() - logger->start_timestamp;
+  record.type = LOG_RECORD_LAUNCH;
+  record.event.arg[0] = logger->flight_phase.launch_detector.cause;
+  Logger_Queue(logger, &record);
+  logger->armed = false;
+
+  // The log starts with the oldest sample kept in RAM. The queue is not trimmed anymore, so it stays the oldest
+  const log_record_t *oldest = RecordQueue_Peek(&logger->queue);
+  if (oldest)
+    logger->commit_timestamp = logger->start_timestamp + oldest->timestamp;
+  Serial.println(logger->flight_phase.launch_detector.cause == LAUNCH_DETECTOR_ACC ? F("Launch detected by the acceleration") : F("Launch detected by the altitude"));
+}
+
+// Returns the number of samples the current sample rate should have given since it was set
+static uint32_t Logger_ExpectedSince(const logger_t *logger, uint32_t end) {
+  uint32_t start = (int32_t)(logger->rate_timestamp - logger->commit_timestamp) > 0 ? logger->rate_timestamp : logger->commit_timestamp;
+  return (int32_t)(end - start) > 0 ? (end - start) / logger->mpu6500.sample_period_micros : 0;
+}
+
+// Counts the samples the current sample rate should have given before it is changed
+static void Logger_CountExpected(logger_t *logger, uint32_t now) {
+  if (!logger->armed && !logger->erasing)
+    logger->expected_samples += Logger_ExpectedSince(logger, now);
+  logger->rate_timestamp = now;
+}
+
+flight_phase_e Logger_GetPhase(const logger_t *logger) {
+  return logger->flight_phase.phase;
+}
+
+static void Logger_PhaseChanged(logger_t *logger) {
+  if (logger->armed)
+    Logger_Launch(logger); // The phase changes from the pad when the launch is detected
+  logger->phase_pending = true;
+  Serial.print(F("Flight phase: ")); Serial.println(LogFormat_GetPhaseName(logger->flight_phase.phase));
+}
+
+// Changes the sample rates to the ones used in the current phase and records the change in the log.
+// The IMU samples already read from the FIFO are logged before the change
+static void Logger_ApplyPhase(logger_t *logger, uint32_t timestamp) {
+  logger->phase_pending = false;
+  if (logger->adaptive_rate) {
+    const flight_phase_config_t *config = FlightPhase_GetConfig(logger->flight_phase.phase);
+    Logger_CountExpected(logger, micros());
+    uint8_t rcode = MPU6500_SetSampleRate(&logger->mpu6500, config->sample_rate < logger->sample_rate ? config->sample_rate : logger->sample_rate);
+    if (rcode != 0) {
+      Serial.print(F("Failed setting the sample rate: "));
+      Serial.println(rcode);
+    }
+    MS5611_SetOsr(&logger->ms5611, config->osr_mask);
+  }
+
+  log_record_t record;
+  memset(&record, 0, sizeof(record));
+  record.timestamp = timestamp;
+  record.type = LOG_RECORD_PHASE;
+  record.event.arg[0] = logger->flight_phase.phase;
+  record.event.arg[1] = 1000000UL / logger->mpu6500.sample_period_micros;
+  record.event.arg[2] = 256U << (logger->ms5611.osr_mask >> 1); // The mask is two times log2(OSR / 256)
+  Logger_Queue(logger, &record);
+}
+
+// Changes the full-scale ranges to the ones chosen by the auto-ranging. The IMU samples already read from the FIFO are
+// converted using the old ranges, and the change is written to the log once the first sample using the new ones is returned
+static void Logger_ApplyRange(logger_t *logger) {
+  logger->range_pending = false;
+  uint8_t rcode = MPU6500_SetRange(&logger->mpu6500, &logger->auto_range.range);
+  if (rcode != 0) {
+    Serial.print(F("Failed setting the range: "));
+    Serial.println(rcode);
+    AutoRange_Init(&logger->auto_range, &logger->mpu6500.config_range, micros()); // Start over from the current ranges
+  }
+}
+
+// Lets the auto-ranging check the newest sample and changes the ranges once the buffered samples, which are converted
+// using the old ranges, have been handled
+static void Logger_UpdateRange(logger_t *logger) {
+  const mpu6500_t *mpu6500 = &logger->mpu6500;
+  if (logger->auto_ranging && AutoRange_Update(&logger->auto_range, mpu6500->timestamp, &mpu6500->range, &mpu6500->gyroRaw, &mpu6500->accRaw))
+    logger->range_pending = true;
+  if (logger->range_pending && !MPU6500_HasBufferedData(mpu6500))
+    Logger_ApplyRange(logger);
+}
+
+// Converts the samples using the new ranges from now on and records the change in the log
+static void Logger_RangeChanged(logger_t *logger, uint32_t timestamp) {
+  const mpu6500_t *mpu6500 = &logger->mpu6500;
+  logger->range = mpu6500->range;
+  Estimator_SetScale(&logger->estimator, mpu6500->gyroScaleFactor, mpu6500->accScaleFactor);
+  FlightPhase_SetScale(&logger->flight_phase, mpu6500->accScaleFactor);
+
+  log_record_t record;
+  memset(&record, 0, sizeof(record));
+  record.timestamp = timestamp;
+  record.type = LOG_RECORD_RANGE;
+  record.event.arg[0] = mpu6500->range.gyro;
+  record.event.arg[1] = mpu6500->range.acc;
+  Logger_Queue(logger, &record);
+  Serial.printf("Range: %u deg/s, %u g\n", MPU6500_GetGyroFullScale(mpu6500->range.gyro), MPU6500_GetAccFullScale(mpu6500->range.acc));
+}
+
+static void Logger_QueueEstimate(logger_t *logger, uint32_t timestamp) {
+  log_record_t record;
+  memset(&record, 0, sizeof(record));
+  record.timestamp = timestamp;
+  record.type = LOG_RECORD_ESTIMATE;
+  record.event.arg[0] = Estimator_GetAltitude(&logger->estimator);
+  record.event.arg[1] = Estimator_GetVelocity(&logger->estimator);
+  record.event.arg[2] = Estimator_GetAttitude(&logger->estimator);
+  Logger_Queue(logger, &record);
+}
+
+static void Logger_WriteStats(logger_t *logger, log_stats_e id, uint32_t value1, uint32_t value2) {
+  log_record_t record;
+  memset(&record, 0, sizeof(record));
+  record.timestamp = logger->stop_timestamp - logger->start_timestamp;
+  record.type = LOG_RECORD_STATS;
+  record.event.arg[0] = id;
+  record.event.arg[1] = value1;
+  record.event.arg[2] = value2;
+  LogWriter_Write(&logger->log_writer, &record);
+}
+
+void Logger_Stop(logger_t *logger) {
+  // Write all queued records. If the launch was never detected, then the latest samples are written
+  logger->armed = false;
+  while (Logger_IsLogging(logger) && RecordQueue_GetCount(&logger->queue) > 0 && !logger->log_writer.write_error) {
+    Logger_Commit(logger);
+    LogWriter_Service(&logger->log_writer);
+  }
+
+  // Append a summary of the performance counters to the log
+  logger->stop_timestamp = micros();
+  Logger_CountExpected(logger, logger->stop_timestamp);
+  stats_samples_t samples;
+  Logger_GetSamples(logger, &samples);
+  Logger_WriteStats(logger, LOG_STATS_SAMPLES, samples.expected, samples.logged);
+  Logger_WriteStats(logger, LOG_STATS_LOOP, Stats_GetMeanMicros(&stats.loop), Stats_GetMaxMicros(&stats.loop));
+  Logger_WriteStats(logger, LOG_STATS_I2C, stats.i2c.count, stats.i2c_errors);
+  Logger_WriteStats(logger, LOG_STATS_I2C_LATENCY, Stats_GetMeanMicros(&stats.i2c), Stats_GetMaxMicros(&stats.i2c));
+  Logger_WriteStats(logger, LOG_STATS_FLASH, Stats_GetMeanMicros(&stats.flash), Stats_GetMaxMicros(&stats.flash));
+  Logger_WriteStats(logger, LOG_STATS_HEAP, ESP.getFreeHeap(), stats.min_free_heap);
+  Logger_WriteStats(logger, LOG_STATS_ESTIMATOR, Stats_GetMeanMicros(&stats.estimator), Stats_GetMaxMicros(&stats.estimator));
+  Logger_WriteStats(logger, LOG_STATS_LATENCY, Stats_GetMeanMicros(&stats.latency), Stats_GetMaxMicros(&stats.latency));
+  Logger_WriteStats(logger, LOG_STATS_HIGH_WATER, stats.queue_high_water, stats.fifo_high_water);
+  Logger_WriteStats(logger, LOG_STATS_I2C_BUS, Stats_GetI2CUtilisation(), Stats_GetI2CRate());
+  Logger_WriteStats(logger, LOG_STATS_I2C_SCHEDULER, stats.i2c_retries, stats.i2c_missed_deadlines);
+
+  LogWriter_Close(&logger->log_writer);
+  if (logger->adaptive_rate) {
+    // Go back to the configured rates, so the ground pressure is tracked at the same rate as before the log was started
+    if (MPU6500_SetSampleRate(&logger->mpu6500, logger->sample_rate) != 0)
+      Serial.println(F("Failed setting the sample rate"));
+    MS5611_SetOsr(&logger->ms5611, LOGGER_MS5611_OSR);
+  }
+  Serial.printf("Wrote %u records, dropped %u samples, worst case flush: %u us\n",
+    logger->log_writer.written, logger->dropped + logger->log_writer.total_dropped, logger->log_writer.max_flush_micros);
+}
+
+bool Logger_IsLogging(const logger_t *logger) {
+  return LogWriter_IsOpen(&logger->log_writer);
+}
+
+bool Logger_IsErasing(const logger_t *logger) {
+  return Logger_IsLogging(logger) && logger->erasing;
+}
+
+// Compares the number of logged samples with the number the sample rate should have given
+void Logger_GetSamples(const logger_t *logger, stats_samples_t *samples) {
+  uint32_t end = Logger_IsErasing(logger) || Logger_IsArmed(logger) ? logger->commit_timestamp : Logger_IsLogging(logger) ? micros() : logger->stop_timestamp;
+  samples->expected = logger->expected_samples + Logger_ExpectedSince(logger, end);
+  samples->logged = logger->samples;
+  samples->dropped = logger->dropped + logger->log_writer.total_dropped;
+}
+
+// Poll the barometer. This never blocks, so the IMU is read at its full rate while the barometer is converting
+void Logger_UpdateBarometer(logger_t *logger) {
+  bool ready;
+  uint8_t rcode = MS5611_Update(&logger->ms5611, &ready);
+  if (rcode != 0) {
+    Serial.print(F("Failed reading MS5611: "));
+    Serial.println(rcode);
+    return;
+  }
+
+  // Track the pressure on the ground, so the noise of a single reading does not end up in the reference
+  if (ready && !Logger_IsLogging(logger))
+    logger->ground_pressure_filtered += logger->ms5611.pressure - (logger->ground_pressure_filtered >> 4);
+
+  if (ready && Logger_IsLogging(logger) && !logger->erasing) {
+    uint32_t now = micros();
+    Estimator_UpdatePressure(&logger->estimator, now, logger->ms5611.pressure);
+    int32_t velocity = Estimator_IsSettled(&logger->estimator) ? Estimator_GetVelocity(&logger->estimator) : 0; // Only the altitude is used until then
+    if (FlightPhase_UpdatePressure(&logger->flight_phase, now, logger->ms5611.pressure, velocity))
+      Logger_PhaseChanged(logger);
+  }
+#if 0
+  if (ready) {
+    Serial.print(logger->ms5611.pressure); Serial.print(F(" Pa,"));
+    Serial.print(Altitude_AboveGround(logger->ms5611.pressure, Logger_GetGroundPressure(logger)) / 1000.0f); Serial.print(F(" m, "));
+    Serial.print(logger->ms5611.temperature); Serial.print(F(" C\n"));
+  }
+#endif
+}
+
+static uint8_t Logger_ReadImu(mpu6500_t *mpu6500, bool *ready) {
+  if (mpu6500->fifo_enabled)
+    return MPU6500_FifoGetData(mpu6500, ready);
+  uint8_t rcode = MPU6500_DateReady(ready);
+  if (rcode != 0 || !*ready)
+    return rcode;
+  return MPU6500_GetData(mpu6500);
+}
+
+void Logger_UpdateImu(logger_t *logger) {
+  mpu6500_t *mpu6500 = &logger->mpu6500;
+  bool ready;
+  uint8_t rcode = Logger_ReadImu(mpu6500, &ready);
+  if (rcode != 0) {
+    Serial.print(F("Failed reading MS6500: "));
+    Serial.println(rcode);
+    return;
+  }
+  if (!ready)
+    return;
+#if 0
+  MPU6500_ConvertData(mpu6500);
+  Serial.print(mpu6500->gyroRate.roll * RAD_TO_DEGf); Serial.write(',');
+  Serial.print(mpu6500->gyroRate.pitch * RAD_TO_DEGf); Serial.write(',');
+  Serial.print(mpu6500->gyroRate.yaw * RAD_TO_DEGf); Serial.write(',');
+  Serial.print(mpu6500->accSi.X); Serial.write(',');
+  Serial.print(mpu6500->accSi.Y); Serial.write(',');
+  Serial.println(mpu6500->accSi.Z);
+#endif
+
+  // Stream the readings whether or not a log is open, so the sensors can be checked on the pad
+  telemetry_t *telemetry = logger->telemetry;
+  if (telemetry && Telemetry_IsEnabled(telemetry)) {
+    Telemetry_SetScale(telemetry, mpu6500->gyroScaleFactor, mpu6500->accScaleFactor, Logger_GetGroundPressure(logger));
+    Telemetry_Add(telemetry, mpu6500->timestamp, logger->ms5611.pressure, &mpu6500->gyroRaw, &mpu6500->accRaw);
+  }
+
+  // Check if the file is open and skip any samples buffered by the FIFO before the log was started.
+  // The ranges follow the readings whether or not a log is open, so they fit the readings on the pad
+  if (!Logger_IsLogging(logger) || logger->erasing || (int32_t)(mpu6500->timestamp - logger->start_timestamp) < 0) {
+    logger->imu_dropped = mpu6500->fifo_dropped; // Only the samples lost while logging are counted
+    Logger_UpdateRange(logger);
+    return;
+  }
+
+  // The samples lost by the FIFO were taken right before this one, so they are written to the log in a dropped marker
+  // before it, the same way as the samples dropped because the queue was full
+  logger->queue_dropped += mpu6500->fifo_dropped - logger->imu_dropped;
+  logger->imu_dropped = mpu6500->fifo_dropped;
+
+  // Store the raw readings, they are converted using the scale factors in the header or the last range record when the log is read
+  log_record_t record;
+  record.timestamp = mpu6500->timestamp - logger->start_timestamp;
+  if (!MPU6500_RangeEquals(&mpu6500->range, &logger->range))
+    Logger_RangeChanged(logger, record.timestamp);
+  record.type = LOG_RECORD_SAMPLE;
+  LogFormat_SetPressure(&record, logger->ms5611.pressure); // The latest pressure reading
+  record.sample.gyro = mpu6500->gyroRaw;
+  record.sample.acc = mpu6500->accRaw;
+
+  // The record is queued and written to the file in blocks. If the queue is full, then the sample is dropped
+  // and the number of dropped samples is written to the file
+  Logger_Queue(logger, &record);
+
+  uint32_t start = Stats_Timestamp();
+  Estimator_UpdateImu(&logger->estimator, mpu6500->timestamp, &mpu6500->gyroRaw, &mpu6500->accRaw);
+  Stats_Record(&stats.estimator, start);
+  if (logger->log_estimates && record.timestamp - logger->estimate_timestamp >= LOGGER_ESTIMATE_INTERVAL) {
+    logger->estimate_timestamp = record.timestamp;
+    Logger_QueueEstimate(logger, record.timestamp);
+  }
+
+  if (FlightPhase_UpdateImu(&logger->flight_phase, mpu6500->timestamp, &mpu6500->accRaw))
+    Logger_PhaseChanged(logger);
+  Logger_UpdateRange(logger);
+  if (logger->phase_pending && !MPU6500_HasBufferedData(mpu6500)) // The buffered samples were taken at the old rate
+    Logger_ApplyPhase(logger, record.timestamp);
+
+  if (!logger->armed && ++logger->fs_check_counter >= LOGGER_FS_CHECK_INTERVAL) {
+    logger->fs_check_counter = 0;
+
+    // Determine if the file system or flash region is full
+    const flash_log_t *flash_log = logger->log_writer.flash_log;
+    if (flash_log ? FlashLog_GetFree(flash_log) < LOGGER_FLASH_RESERVE : Storage_IsFull()) {
+      Logger_Stop(logger);
+      Serial.print(F("Logging ended after: "));
+      Serial.print((float)(micros() - logger->commit_timestamp) * 1e-6f);
+      Serial.println(F(" s"));
+    }
+  }
+}
+
+// Erases the first LOGGER_FLASH_ERASE_SIZE bytes of the raw flash region before the samples are logged, so the flash is
+// never erased while the samples are written. Erasing a sector takes about as long as the FIFO can buffer, so the FIFO is
+// emptied right before every erase and before the samples are logged. It is read until no sample was taken while reading
+// it, so this is done over a few calls
+static void Logger_Erase(logger_t *logger) {
+  mpu6500_t *mpu6500 = &logger->mpu6500;
+  if (!Logger_IsErasing(logger) || (mpu6500->fifo_enabled && MPU6500_HasBufferedData(mpu6500)))
+    return;
+  if (mpu6500->fifo_enabled) {
+    uint8_t rcode = MPU6500_FifoRead(mpu6500);
+    if (rcode != 0) {
+      Serial.print(F("Failed reading MS6500: "));
+      Serial.println(rcode);
+      return;
+    }
+    if (MPU6500_HasBufferedData(mpu6500))
+      return; // Skip the samples and read the FIFO again
+  }
+  if (LogWriter_NeedsErase(&logger->log_writer, LOGGER_FLASH_ERASE_SIZE)) {
+    LogWriter_EraseAhead(&logger->log_writer);
+    return;
+  }
+
+  // The samples are logged from now on
+  logger->erasing = false;
+  logger->start_timestamp = logger->commit_timestamp = logger->rate_timestamp = micros();
+  logger->imu_dropped = mpu6500->fifo_dropped;
+  Stats_Reset();
+  Serial.println(F("Flash erased"));
+}
+
+// Moves the queued records to the log writer and writes the buffers to the file outside of the sample path
+void Logger_Service(logger_t *logger) {
+  LogWriter_Service(&logger->log_writer);
+  Logger_Commit(logger); // Move the records queued by the sampling path
+  Logger_Erase(logger);
+  if (Logger_IsLogging(logger) && logger->log_writer.write_error) {
+    Logger_Stop(logger);
+    Serial.println(F("Failed writing to the log file"));
+  }
+}
+
+// Does the I2C transactions submitted by the sensor drivers, which are due
+void Logger_UpdateBus(logger_t *logger) {
+  (void)logger;
+  I2CScheduler_Run();
+}
+
+void Logger_Loop(logger_t *logger) {
+  Logger_UpdateBus(logger);
+  Logger_UpdateBarometer(logger);
+  Logger_UpdateImu(logger);
+  Logger_Service(logger);
+}
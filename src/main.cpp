@@ -24,162 +24,553 @@
 #include <Arduino.h>
 #include <DNSServer.h>
 #include <ESPAsyncWebServer.h>
-#include <FS.h>
 
+#include "altitude.h"
+#include "csv_encoder.h"
+#include "csv_index.h"
+#include "flash_log.h"
+#include "flight_index.h"
+#include "http_range.h"
 #include "i2c.h"
-#include "mpu6500.h"
-#include "ms5611.h"
+#include "log_reader.h"
+#include "logger.h"
+#include "radio_quiet.h"
 #include "rocket_assert.h"
+#include "stats.h"
+#include "storage.h"
+#include "telemetry.h"
+#include "web_assets.h"
 
 #define USE_HEARTBEAT 0  // Used for debugging
+#define USE_MPU6500_FIFO 1 // Read the MPU-6500 samples in bursts from its FIFO instead of polling for every sample
+#define USE_LOG_COMPRESSION 1 // Store the records in compressed blocks
+#define USE_ADAPTIVE_SAMPLE_RATE 1 // Let the sample rates follow the flight phase, so less flash is used on the pad and under the parachute
+#define USE_IMU_AUTO_RANGE 0 // Let the full-scale ranges of the MPU-6500 follow the readings, see auto_range.h. Every change is written to the log
+#define USE_ESTIMATOR_LOG 0 // Write the altitude, vertical velocity and attitude found on the device to the log 50 times a second
+#define USE_I2C_FAST_DRIVER 0 // Use the I2C driver of the core directly instead of Wire, so the MPU-6500 FIFO is read in a single transaction
+#define USE_RAW_FLASH_LOG 0 // Write the log directly to the flash region of the file system instead of a file. Note that this overwrites the file system
+#define USE_RADIO_QUIET 0 // Turn off the WiFi while a flight is logged, so the CPU is only used for sampling. It is turned on again after the landing, see radio_quiet.h
+#define FLIGHT_EVICTION_POLICY FLIGHT_EVICT_DOWNLOADED // Decides which flights are deleted when a log is started and the file system is getting full
 
 static AsyncWebServer server(80);
+static AsyncWebSocket ws("/ws"); // Streams the samples to the live page
 static DNSServer dnsServer;
 
 const char *ssid = "Rocket";
 const char *password = "rocketsrocks";
 
-static mpu6500_t mpu6500;
-static ms5611_t ms5611;
-
-static volatile uint16_t sample_rate = MPU6500_MAX_SAMPLE_RATE;
-static uint32_t start_timestamp = 0;
-
-struct log_t {
-  uint32_t timestamp;
-  int32_t pressure;
-  float gyroX, gyroY, gyroZ;
-  float accX, accY, accZ;
-} __attribute__((packed));
-
-static File log_file;
-static constexpr const char *log_filename = "/log.bin";
-
-static void handleRoot(AsyncWebServerRequest *request) {
-  Serial.println(F("Sending root content"));
-
-  AsyncResponseStream *response = request->beginResponseStream(F("text/html"));
-  response->addHeader(F("Cache-Control"), F("no-cache,no-store,must-revalidate"));
-  response->addHeader(F("Pragma"), F("no-cache"));
-  response->addHeader(F("Expires"), F("-1"));
-
-  // Format the HTML response
-  response->print(F("<html><head><meta name=\"viewport\" content=\"width=device-width,initial-scale=1.0,minimum-scale=1.0,maximum-scale=1.0,user-scalable=no,viewport-fit=cover\"></head>"));
-  response->print(F("<body style=\"margin:50px auto;text-align:center;\">"));
-  response->print(F("<span>Sample rate: "));
-  response->print(String(sample_rate));
-  response->print(F(" Hz (max: "));
-  response->print(String(MPU6500_MAX_SAMPLE_RATE));
-  response->print(F(" Hz) </span>"));
-  response->print(F("<form action=\"/"));
-  response->print(log_file ? F("stop") : F("start")); // Check if the file is open
-  response->print(F("\" method=\"POST\">"));
-  if (!log_file) // Check if the file is closed
-    response->print(F("<input style=\"width:50%;\" type=\"number\" name=\"sample_rate\" placeholder=\"Sample rate\"></br>"));
-  response->print(F("<input style=\"width:50%;\" type=\"submit\" value=\""));
-  response->print(log_file ? F("Stop") : F("Start"));
-  response->print(F(" logging\"></form>"));
-  if (!log_file && SPIFFS.exists(log_filename)) // Make sure the log file is closed and exist
-    response->print(F("<a href=\"/log.txt\" target=\"_blank\">log.txt</a>")); // Create link to the log file
-  response->print(F("</body></html>")); // Close the body and html tags
-
-  request->send(response); // Send the response
-  Serial.println(F("Finished sending root content"));
+static logger_t logger;
+static uint32_t flight_id = 0; // Flight which is being logged or was logged last
+static bool flight_open = false; // Set while the log of the flight is open
+
+static csv_index_t csv_index; // Used for resuming a download of the CSV file
+static log_reader_t *csv_index_reader = nullptr; // Only allocated while the index is being built
+static uint32_t csv_index_flight = 0; // Flight which should be indexed next, zero if none
+
+static radio_quiet_t radio_quiet;
+static telemetry_t telemetry; // Filled by the sampling path and sent by streamTelemetry()
+
+#if USE_RAW_FLASH_LOG
+extern "C" uint32_t _FS_start, _FS_end; // The flash region of the file system is defined by the linker script
+static flash_log_t flash_log;
+static const uint32_t flash_log_flight = 1; // There is only room for a single flight
+#else
+static flight_index_t flight_index;
+#endif
+
+// Returns true if the log of the flight exists and has been closed
+static bool logExists(uint32_t id) {
+#if USE_RAW_FLASH_LOG
+  return id == flash_log_flight && !Logger_IsLogging(&logger) && FlashLog_GetLength(&flash_log) > 0;
+#else
+  const flight_entry_t *flight = FlightIndex_Find(&flight_index, id);
+  return flight && (flight->flags & FLIGHT_FLAG_CLOSED);
+#endif
+}
+
+static bool logOpen(log_reader_t *log_reader, uint32_t id) {
+#if USE_RAW_FLASH_LOG
+  return LogReader_OpenFlash(log_reader, &flash_log);
+#else
+  char path[FLIGHT_INDEX_PATH_SIZE];
+  FlightIndex_GetPath(id, path);
+  return LogReader_Open(log_reader, Storage_Open(path, "r"));
+#endif
+}
+
+// Returns the newest flight or zero if there is none
+static uint32_t latestFlight() {
+#if USE_RAW_FLASH_LOG
+  return flash_log_flight;
+#else
+  const flight_entry_t *flight = FlightIndex_GetLatest(&flight_index);
+  return flight ? flight->id : 0;
+#endif
+}
+
+// Returns the flight given by the "id" argument or the newest flight
+static uint32_t getFlight(AsyncWebServerRequest *request) {
+  if (request->hasArg("id"))
+    return request->arg("id").toInt();
+  return latestFlight();
+}
+
+// Called when the whole log has been sent, so the flight can be deleted when there is no more room
+static void logDownloaded(uint32_t id) {
+#if !USE_RAW_FLASH_LOG
+  FlightIndex_SetDownloaded(&flight_index, id);
+#endif
+}
+
+// Stores the summary of the flight once the log has been closed, either because it was stopped or the file system was full
+static void closeFlight() {
+  if (!flight_open || Logger_IsLogging(&logger))
+    return;
+  flight_open = false;
+#if !USE_RAW_FLASH_LOG
+  FlightIndex_Close(&flight_index, flight_id, logger.log_writer.written);
+#endif
+  csv_index_flight = flight_id; // Make the CSV file ready for download
+}
+
+// Sends a file of the web interface. The files are static, so the browser only has to check that its cached copy
+// is still valid, which is answered with "304 Not Modified" without sending the file again
+static void handleAsset(AsyncWebServerRequest *request, const web_asset_t *asset) {
+  if (request->hasHeader("If-None-Match") && request->getHeader("If-None-Match")->value() == asset->etag) {
+    request->send(304);
+    return;
+  }
+  AsyncWebServerResponse *response = request->beginResponse_P(200, asset->type, asset->data, asset->length);
+  response->addHeader(F("Content-Encoding"), F("gzip"));
+  response->addHeader(F("ETag"), asset->etag);
+  response->addHeader(F("Cache-Control"), F("no-cache")); // The file is cached, but it is checked every time as the firmware might have been updated
+  request->send(response);
+}
+
+// Returns the state of the logger as JSON. This is all the start page needs from the logger
+static void handleStatus(AsyncWebServerRequest *request) {
+  const char *state = "idle";
+  if (Logger_IsErasing(&logger))
+    state = "erasing";
+  else if (Logger_IsArmed(&logger))
+    state = "armed";
+  else if (Logger_IsLogging(&logger))
+    state = "logging";
+  char json[256];
+  snprintf(json, sizeof(json), "{\"state\":\"%s\",\"phase\":\"%s\",\"sample_rate\":%u,\"max_sample_rate\":%u,\"ground_pressure\":%d,"
+    "\"flash_log\":%s,\"log\":%s}", state, LogFormat_GetPhaseName(Logger_GetPhase(&logger)), logger.sample_rate, MPU6500_MAX_SAMPLE_RATE,
+    Logger_GetGroundPressure(&logger), USE_RAW_FLASH_LOG ? "true" : "false", logExists(latestFlight()) ? "true" : "false");
+  AsyncWebServerResponse *response = request->beginResponse(200, F("application/json"), json); // The string is copied
+  response->addHeader(F("Cache-Control"), F("no-cache"));
+  request->send(response);
+}
+
+// Returns the size of the log in bytes
+static uint32_t logSize(const log_reader_t *log_reader) {
+#if USE_RAW_FLASH_LOG
+  return FlashLog_GetLength(&flash_log);
+#else
+  return log_reader->file.size();
+#endif
+}
+
+// The ETag is derived from the identity of the log, so a download is only resumed if the log has not changed
+static String logEtag(uint32_t id, const char *suffix) {
+  char etag[24];
+  snprintf(etag, sizeof(etag), "\"%08x%s\"", id, suffix);
+  return String(etag);
+}
+
+// Finds the bytes requested using the "Range" header. The range is ignored if the "If-Range" header does not match the ETag
+static http_range_e getRange(AsyncWebServerRequest *request, const String &etag, uint32_t size, uint32_t *first, uint32_t *last) {
+  *first = 0;
+  *last = size - 1;
+  if (!request->hasHeader("Range"))
+    return HTTP_RANGE_NONE;
+  if (request->hasHeader("If-Range") && request->getHeader("If-Range")->value() != etag)
+    return HTTP_RANGE_NONE; // The log has changed, so the whole file is sent
+  return HttpRange_Parse(request->getHeader("Range")->value().c_str(), size, first, last);
+}
+
+static void sendRangeNotSatisfiable(AsyncWebServerRequest *request, uint32_t size) {
+  AsyncWebServerResponse *response = request->beginResponse(416, F("text/plain"), F("416: Range Not Satisfiable"));
+  response->addHeader(F("Content-Range"), String(F("bytes */")) + String(size));
+  request->send(response);
+}
+
+// Adds the headers used for resuming a download and turns the response into "206 Partial Content" if only a range is sent
+static void addRangeHeaders(AsyncWebServerResponse *response, const String &etag, http_range_e range, uint32_t first, uint32_t last, uint32_t size) {
+  response->addHeader(F("Accept-Ranges"), F("bytes"));
+  response->addHeader(F("ETag"), etag);
+  if (range == HTTP_RANGE_PARTIAL) {
+    char content_range[40];
+    snprintf(content_range, sizeof(content_range), "bytes %u-%u/%u", first, last, size);
+    response->setCode(206);
+    response->addHeader(F("Content-Range"), content_range);
+  }
+}
+
+// Every download has its own context, which is released when the client disconnects, so a dropped connection never blocks
+// another download. The contexts are allocated statically, as every CSV download needs a buffer for reading the log
+// and the heap would otherwise be fragmented by downloads coming and going
+#define MAX_DOWNLOADS 3
+
+typedef struct {
+  log_reader_t reader;
+  csv_encoder_t encoder;
+  uint32_t flight; /*!< Flight being sent */
+  uint32_t remaining; /*!< Number of bytes left of the requested range */
+  bool to_end; /*!< Set if the range ends at the end of the file */
+  bool used; /*!< Set while the context is used by a download */
+} log_download_t;
+static log_download_t log_downloads[MAX_DOWNLOADS];
+static uint8_t downloads = 0; // Number of logs being sent in binary or as CSV
+
+// Returns false and tells the client to try again later if too many logs are being sent already
+static bool downloadAvailable(AsyncWebServerRequest *request) {
+  if (downloads < MAX_DOWNLOADS)
+    return true;
+  AsyncWebServerResponse *response = request->beginResponse(503, F("text/plain"), F("503: Too many downloads"));
+  response->addHeader(F("Retry-After"), F("10"));
+  request->send(response);
+  return false;
+}
+
+// Returns a free context for a CSV download. There is always one, as the number of downloads is checked first
+static log_download_t *downloadAlloc() {
+  for (log_download_t &log_download : log_downloads) {
+    if (!log_download.used) {
+      log_download.used = true;
+      return &log_download;
+    }
+  }
+  ROCKET_ASSERT(false && "No free download context");
+  return nullptr;
+}
+
+static void downloadFree(log_download_t *log_download) {
+  LogReader_Close(&log_download->reader);
+  log_download->used = false;
+}
+
+#if !USE_RAW_FLASH_LOG
+static_assert(MAX_DOWNLOADS <= FLIGHT_INDEX_MAX_OPEN, "Every log being downloaded must be protected from being evicted");
+#endif
+
+// Sends the response and counts the download until the client disconnects, whether or not the whole log was sent.
+// The CSV context is released at that point as well. The flight is not evicted by a new flight while it is being sent
+static void downloadSend(AsyncWebServerRequest *request, AsyncWebServerResponse *response, uint32_t id, log_download_t *log_download) {
+  downloads++;
+#if !USE_RAW_FLASH_LOG
+  ROCKET_ASSERT(FlightIndex_Open(&flight_index, id));
+#endif
+  request->onDisconnect([id, log_download]() {
+    if (log_download != nullptr)
+      downloadFree(log_download);
+#if !USE_RAW_FLASH_LOG
+    FlightIndex_Release(&flight_index, id);
+#else
+    (void)id;
+#endif
+    downloads--;
+    Serial.println(F("Done sending log file"));
+  });
+  request->send(response);
+}
+
+// Sends the log in binary format. A download can be resumed using a "Range" request
+static void handleLogBinaryRead(AsyncWebServerRequest *request) {
+  uint32_t id = getFlight(request);
+  if (Logger_IsLogging(&logger) || !logExists(id)) {
+    request->send(404, F("text/plain"), F("404: Not Found"));
+    return;
+  }
+  if (!downloadAvailable(request))
+    return;
+
+  // Only the header is read for the ETag, as any file is sent, even if it is not a valid log
+  log_header_t header;
+  memset(&header, 0, sizeof(header));
+#if USE_RAW_FLASH_LOG
+  uint32_t size = FlashLog_GetLength(&flash_log);
+  FlashLog_Read(&flash_log, 0, (uint8_t*)&header, sizeof(header));
+#else
+  char path[FLIGHT_INDEX_PATH_SIZE];
+  FlightIndex_GetPath(id, path);
+  File file = Storage_Open(path, "r"); // The file is closed when the response is deleted
+  uint32_t size = file.size();
+  file.read((uint8_t*)&header, sizeof(header));
+#endif
+  String etag = logEtag(LogFormat_GetId(&header, size), "");
+
+  uint32_t first, last;
+  http_range_e range = getRange(request, etag, size, &first, &last);
+  if (range == HTTP_RANGE_UNSATISFIABLE) {
+    sendRangeNotSatisfiable(request, size);
+    return;
+  }
+
+#if USE_RAW_FLASH_LOG
+  AsyncWebServerResponse *response = request->beginResponse("application/octet-stream", last - first + 1, [id, first, size](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+    size_t n = FlashLog_Read(&flash_log, first + index, buffer, maxLen);
+    if (first + index + n == size)
+      logDownloaded(id);
+    return n;
+  });
+#else
+  AsyncWebServerResponse *response = request->beginResponse("application/octet-stream", last - first + 1, [file, id, first, size](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t {
+    if (!file.seek(first + index, SeekSet))
+      return 0;
+    int n = file.read(buffer, maxLen);
+    if (n <= 0)
+      return 0;
+    if (first + index + n == size)
+      logDownloaded(id);
+    return n;
+  });
+#endif
+  addRangeHeaders(response, etag, range, first, last, size);
+  downloadSend(request, response, id, nullptr); // Only the download is counted, the file is closed when the response is deleted
+}
+
+// Stops building the index, so the log can be changed
+static void stopIndexing() {
+  if (csv_index_reader != nullptr) {
+    LogReader_Close(csv_index_reader);
+    delete csv_index_reader;
+    csv_index_reader = nullptr;
+  }
+}
+
+// The file is kept open for the whole response and read in bulk, so the rows are streamed in order
+static size_t logDownloadRead(log_download_t *log_download, uint8_t *buffer, size_t maxLen) {
+  // Write up to "maxLen" bytes into "buffer" and return the amount written.
+  // You will be asked for more data until 0 is returned
+  // Keep in mind that you can not delay or yield waiting for more data!
+  if (maxLen > log_download->remaining)
+    maxLen = log_download->remaining; // Stop at the end of the range
+  if (maxLen == 0)
+    return 0;
+
+  // Finish the row which did not fit into the previous response and then fill up the buffer
+  size_t len = CsvEncoder_Flush(&log_download->encoder, buffer, maxLen);
+  log_record_t record;
+  while (len < maxLen && LogReader_Next(&log_download->reader, &record))
+    len += CsvEncoder_Write(&log_download->encoder, &record, &buffer[len], maxLen - len);
+
+  bool done = len == 0; // We are done reading the file
+  if (done && log_download->reader.error) {
+    Serial.println(F("The log file is corrupted"));
+    int copied = snprintf((char*)buffer, maxLen, CSV_ENCODER_CORRUPTED);
+    ROCKET_ASSERT(copied >= 0); // Make sure snprintf does not fail
+    len = (size_t)copied < maxLen ? copied : maxLen;
+  }
+  log_download->remaining -= len;
+  if (done || log_download->remaining == 0) {
+    if (log_download->to_end)
+      logDownloaded(log_download->flight);
+    log_download->remaining = 0; // Only 0 is returned from now on
+  }
+  return len;
 }
 
 // See: https://tttapa.github.io/ESP8266/Chap11%20-%20SPIFFS.html
 static void handleLogFileRead(AsyncWebServerRequest *request) {
-  static size_t row_count = 0;
   // Make sure the log file is closed and exist
-  // and make sure that we are not already sending the file
-  if (!log_file && SPIFFS.exists(log_filename) && row_count == 0) {
-    // Send the binary data as a normal CSV text file
-    AsyncWebServerResponse *response = request->beginChunkedResponse("text/plain", [](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
-      // Write up to "maxLen" bytes into "buffer" and return the amount written.
-      // index equals the amount of bytes that have been already sent
-      // You will be asked for more data until 0 is returned
-      // Keep in mind that you can not delay or yield waiting for more data!
-
-      //Serial.printf("maxLen: %u, index: %u\n", maxLen, index);
-      size_t len = 0;
-      if (index == 0) { // This is the first response, so copy over the header
-        // Write the header
-        Serial.println(F("Sending log file"));
-        int copied = snprintf((char*)buffer, maxLen, // Make sure we do not overflow the buffer
-          "Timestamp,pressure,altitude,gyroX,gyroY,gyroZ,accX,accY,accZ\n");
-        ROCKET_ASSERT(copied >= 0); // Make sure snprintf does not fail
-        //Serial.printf("Bytes copied: %u\n", copied);
-        len += copied; // Add the number of bytes we just wrote to the buffer
-      } else {
-        File f = SPIFFS.open(log_filename, "r");
-        ROCKET_ASSERT(f);
-        ROCKET_ASSERT(f.size() % sizeof(log_t) == 0); // If this fails, then the file is corrupted
-
-        //Serial.printf("File size: %u, row count: %u, log size: %u\n", f.size(), row_count, sizeof(log_t));
-        while (row_count * sizeof(log_t) < f.size()) { // Stop when we are done reading the file
-          ROCKET_ASSERT(f.seek(row_count * sizeof(log_t), SeekSet)); // Go to the current row
-          row_count++; // Increment the row counter
-          log_t log;
-          ROCKET_ASSERT((int)f.read((uint8_t*)&log, sizeof(log_t)) != -1); // Now read one log of data from the file
-
-          // Convert the binary data into a CSV format and copy it into the output buffer
-          // This code assumes that we have at least room for one row of data in each response or the string will be truncated
-          int copied = snprintf((char*)&buffer[len], maxLen - len, // Make sure we do not overflow the buffer
-            "%u,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n",
-            log.timestamp, log.pressure, MS5611_GetAbsoluteAltitude(log.pressure),
-            log.gyroX, log.gyroY, log.gyroZ,
-            log.accX, log.accY, log.accZ);
-          ROCKET_ASSERT(copied >= 0); // Make sure snprintf does not fail
-          //Serial.printf("Bytes copied: %u\n", copied);
-          len += copied; // Add the number of bytes we just wrote to the buffer
-          if (len + 2 * copied > maxLen) // Make sure we have room for at least two more rows of data
-            break;
-        }
-        f.close();
-      }
-
-      // Check if we are done reading the file
-      if (len == 0) {
-        Serial.println(F("Done sending log file"));
-        row_count = 0; // Reset the row count and allow another request to access the file
-      }
-
-      //Serial.printf("Total bytes copied: %u\n", len);
-      return len;
-    });
-    request->send(response);
-  } else
+  uint32_t flight = getFlight(request);
+  if (Logger_IsLogging(&logger) || !logExists(flight)) {
     request->send(404, F("text/plain"), F("404: Not Found"));
+    return;
+  }
+  if (!downloadAvailable(request))
+    return;
+
+  log_download_t *log_download = downloadAlloc();
+  log_download->flight = flight;
+  if (!logOpen(&log_download->reader, flight)) {
+    downloadFree(log_download);
+    request->send(500, F("text/plain"), F("500: Invalid log file"));
+    return;
+  }
+  CsvEncoder_Init(&log_download->encoder, &log_download->reader.header);
+  uint32_t id = LogFormat_GetId(&log_download->reader.header, logSize(&log_download->reader));
+  String etag = logEtag(id, "-csv");
+  auto filler = [log_download](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+    return logDownloadRead(log_download, buffer, maxLen);
+  };
+
+  // Send the binary data as a normal CSV text file
+  AsyncWebServerResponse *response;
+  if (csv_index.complete && csv_index.id == id) {
+    // The length is known, so the download can be resumed from any offset
+    uint32_t first, last;
+    http_range_e range = getRange(request, etag, csv_index.length, &first, &last);
+    if (range == HTTP_RANGE_UNSATISFIABLE) {
+      downloadFree(log_download);
+      sendRangeNotSatisfiable(request, csv_index.length);
+      return;
+    }
+    if (range == HTTP_RANGE_PARTIAL && !CsvIndex_Seek(&csv_index, &log_download->reader, &log_download->encoder, first)) {
+      // The offset is within the message about the corrupted log, so the whole file is sent instead
+      range = HTTP_RANGE_NONE;
+      first = 0;
+      last = csv_index.length - 1;
+      CsvIndex_Seek(&csv_index, &log_download->reader, &log_download->encoder, 0);
+    }
+    log_download->remaining = last - first + 1;
+    log_download->to_end = last == csv_index.length - 1;
+    response = request->beginResponse("text/plain", log_download->remaining, filler);
+    addRangeHeaders(response, etag, range, first, last, csv_index.length);
+  } else {
+    // The length is not known until the index has been built
+    if (csv_index.id != id) {
+      stopIndexing(); // Index this log instead
+      csv_index_flight = flight;
+    }
+    log_download->remaining = UINT32_MAX;
+    log_download->to_end = true;
+    response = request->beginChunkedResponse("text/plain", filler);
+    response->addHeader(F("ETag"), etag);
+  }
+  Serial.println(F("Sending log file"));
+  downloadSend(request, response, flight, log_download);
 }
 
-static void loggingRedirect(AsyncWebServerRequest *request) {
+// Builds the index of the CSV file in the background when the log has been closed, so the length of the CSV file is known
+// and a download can be resumed without converting the whole log again
+static void indexLog() {
+  if (Logger_IsLogging(&logger)) {
+    stopIndexing(); // The log is indexed once it is closed
+    return;
+  }
+
+  if (csv_index_reader == nullptr) {
+    uint32_t id = csv_index_flight;
+    csv_index_flight = 0;
+    if (!logExists(id))
+      return;
+    csv_index_reader = new log_reader_t;
+    ROCKET_ASSERT(csv_index_reader);
+    if (!logOpen(csv_index_reader, id)) {
+      stopIndexing();
+      return;
+    }
+    CsvIndex_Init(&csv_index, LogFormat_GetId(&csv_index_reader->header, logSize(csv_index_reader)), &csv_index_reader->header);
+  }
+
+  if (CsvIndex_Update(&csv_index, csv_index_reader)) {
+    stopIndexing();
+    Serial.printf("CSV file of %u bytes was indexed\n", csv_index.length);
+  }
+}
+
+// Returns the performance counters of the current or last log as JSON
+static void handleStats(AsyncWebServerRequest *request) {
+  char *json = new char[STATS_JSON_SIZE];
+  ROCKET_ASSERT(json);
+  stats_samples_t samples;
+  Logger_GetSamples(&logger, &samples);
+  Stats_FormatJson(json, STATS_JSON_SIZE, &samples);
+  AsyncWebServerResponse *response = request->beginResponse(200, F("application/json"), json); // The string is copied
+  delete[] json;
+  response->addHeader(F("Cache-Control"), F("no-cache"));
+  request->send(response);
+}
+
+// The client sends the rate in Hz it wants the samples at as text. The stream is stopped when the last client disconnects
+static void handleTelemetryEvent(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len) {
+  if (type == WS_EVT_DATA) {
+    const AwsFrameInfo *info = (const AwsFrameInfo*)arg;
+    if (info->opcode == WS_TEXT && info->final && info->index == 0 && info->len == len && len < 8) {
+      char rate[8];
+      memcpy(rate, data, len);
+      rate[len] = '\0';
+      int new_rate = atoi(rate);
+      Telemetry_SetRate(&telemetry, constrain(new_rate, 0, (int)TELEMETRY_MAX_RATE));
+      Serial.printf("Streaming at %d Hz\n", new_rate);
+    }
+  } else if (type == WS_EVT_DISCONNECT && server->count() == 0)
+    Telemetry_SetRate(&telemetry, 0);
+}
+
+// Sends the frames filled by the sampling path. A frame is only taken from the ring when every client can accept it,
+// so a slow client makes the sampling path drop frames instead of queuing them here
+static void streamTelemetry() {
+  ws.cleanupClients();
+  const telemetry_frame_t *frame;
+  size_t length;
+  while ((frame = Telemetry_Peek(&telemetry, &length)) != nullptr && ws.availableForWriteAll()) {
+    if (ws.count() > 0)
+      ws.binaryAll((uint8_t*)frame, length); // The frame is copied
+    Telemetry_Pop(&telemetry);
+  }
+}
+
+#if !USE_RAW_FLASH_LOG
+// Lists the flights as JSON. Only the index is read
+static void handleLogs(AsyncWebServerRequest *request) {
+  char *json = new char[FLIGHT_INDEX_JSON_SIZE];
+  ROCKET_ASSERT(json);
+  FlightIndex_FormatJson(&flight_index, json, FLIGHT_INDEX_JSON_SIZE);
+  AsyncWebServerResponse *response = request->beginResponse(200, F("application/json"), json); // The string is copied
+  delete[] json;
+  response->addHeader(F("Cache-Control"), F("no-cache"));
+  request->send(response);
+}
+#endif
+
+static void setSampleRate(AsyncWebServerRequest *request) {
   if (request->hasArg("sample_rate")) {
     int new_sample_rate = request->arg("sample_rate").toInt();
     if (new_sample_rate > 0) { // Make sure it was not an empty string
-      sample_rate = constrain((uint16_t)new_sample_rate, MPU6500_MIN_SAMPLE_RATE, MPU6500_MAX_SAMPLE_RATE);
-      Serial.print(F("New sample rate: ")); Serial.println(sample_rate);
-      MPU6500_SetSampleRate(sample_rate);
+      Logger_SetSampleRate(&logger, new_sample_rate > UINT16_MAX ? UINT16_MAX : new_sample_rate);
     }
   }
+}
+
+// Returns the ground reference pressure. The measured pressure is used unless it is set by the user
+static int32_t getGroundPressure(AsyncWebServerRequest *request) {
+  if (request->hasArg("ground_pressure")) {
+    int32_t ground_pressure = request->arg("ground_pressure").toInt();
+    if (ground_pressure > 0) // Make sure it was not an empty string
+      return constrain(ground_pressure, ALTITUDE_MIN_PRESSURE, ALTITUDE_MAX_PRESSURE);
+  }
+  return Logger_GetGroundPressure(&logger);
+}
+
+static void loggingRedirect(AsyncWebServerRequest *request) {
   request->redirect(F("/")); // Redirect to the root
 }
 
 static void loggingStart(AsyncWebServerRequest *request) {
   // Closed file it is is already open
-  if (log_file) { // Check if the file is open
+  if (Logger_IsLogging(&logger)) { // Check if the file is open
     Serial.println(F("Closed exiting logging file"));
-    log_file.close();
+    Logger_Stop(&logger);
+    closeFlight();
   }
 
-  // Delete the existing file
-  if (SPIFFS.exists(log_filename)) {
-    Serial.println(F("Removing existing file"));
-    SPIFFS.remove(log_filename);
+  setSampleRate(request); // Set the sample rate before the header is written
+  stopIndexing();
+  CsvIndex_Reset(&csv_index);
+#if USE_RAW_FLASH_LOG
+  Logger_StartFlash(&logger, &flash_log, getGroundPressure(request), USE_LOG_COMPRESSION); // The previous log is erased
+  flight_id = flash_log_flight;
+#else
+  // Every flight is stored in a new file. Old flights are deleted if there is not enough room
+  flight_id = FlightIndex_Start(&flight_index, request->hasArg("time") ? request->arg("time").toInt() : 0, logger.sample_rate);
+  if (flight_id == 0) {
+    Serial.println(F("There is no room for another flight"));
+    loggingRedirect(request);
+    return;
   }
-
-  start_timestamp = micros(); // Reset the start timestamp
-  log_file = SPIFFS.open(log_filename, "w"); // Open a file for writing
-  ROCKET_ASSERT(log_file);
+  char path[FLIGHT_INDEX_PATH_SIZE];
+  FlightIndex_GetPath(flight_id, path);
+  Logger_Start(&logger, Storage_Open(path, "w"), getGroundPressure(request), USE_LOG_COMPRESSION); // Open a file for writing
+#endif
+  flight_open = Logger_IsLogging(&logger);
+  if (request->hasArg("arm"))
+    Logger_Arm(&logger); // Only the samples around the launch are kept until it is detected
   Serial.println(F("Logging started"));
 
   // Automatically redirect the user to the root page
@@ -188,9 +579,9 @@ static void loggingStart(AsyncWebServerRequest *request) {
 
 static void loggingStop(AsyncWebServerRequest *request) {
   // Closed any existing file
-  if (log_file) { // Check if the file is open
+  if (Logger_IsLogging(&logger)) { // Check if the file is open
     Serial.println(F("Closed logging file"));
-    log_file.close();
+    Logger_Stop(&logger);
   }
   Serial.println(F("Logging stopped"));
 
@@ -198,6 +589,49 @@ static void loggingStop(AsyncWebServerRequest *request) {
   loggingRedirect(request);
 }
 
+// Starts the hotspot, the DNS server and the web server
+static void radioStart() {
+  // Every download has its own context, so several phones can download the flights at once, see MAX_DOWNLOADS
+  int channel = 1, ssid_hidden = 0, max_connection = 4;
+  ROCKET_ASSERT(WiFi.softAP(ssid, password, channel, ssid_hidden, max_connection));
+  IPAddress myIP = WiFi.softAPIP();
+  Serial.print(F("AP IP address: "));
+  Serial.println(myIP);
+
+  if (dnsServer.start(53, "*", myIP)) // Redirect all requests to the logger
+    Serial.println(F("DNS server started"));
+  else
+    Serial.println(F("Failed to start DNS server"));
+
+  server.begin();
+  Serial.println(F("HTTP server started"));
+}
+
+// Stops the web server, the DNS server and the hotspot and puts the modem to sleep. Any client is disconnected
+static void radioStop() {
+  ws.closeAll();
+  server.end();
+  dnsServer.stop();
+  WiFi.softAPdisconnect(true);
+  WiFi.mode(WIFI_OFF);
+  WiFi.forceSleepBegin();
+  Serial.println(F("Radio turned off"));
+}
+
+static void updateRadio() {
+  switch (RadioQuiet_Update(&radio_quiet, &logger, millis())) {
+    case RADIO_QUIET_TURN_OFF:
+      radioStop();
+      break;
+    case RADIO_QUIET_TURN_ON:
+      WiFi.forceSleepWake();
+      radioStart();
+      break;
+    case RADIO_QUIET_NONE:
+      break;
+  }
+}
+
 #if USE_HEARTBEAT
 #include <os_type.h>
 static const uint8_t led_pin = 1; // The builtin LED is active low
@@ -220,117 +654,76 @@ void setup() {
   Serial.begin(74880);
   Serial.println(F("\nStarting RocketLogger"));
 
+#if USE_RAW_FLASH_LOG
+  // Use the flash region of the file system directly. The file system is not mounted, as it would format the region
+  const uint32_t flash_start = (uint32_t)((uintptr_t)&_FS_start - 0x40200000UL); // The flash is mapped at 0x40200000
+  if (FlashLog_Init(&flash_log, flash_start, (uint32_t)((uintptr_t)&_FS_end - (uintptr_t)&_FS_start)))
+    Serial.printf("Found a log of %u bytes in the flash\n", FlashLog_GetLength(&flash_log));
+#else
   // Initailize the file system
-  ROCKET_ASSERT(SPIFFS.begin());
-  Serial.println(F("File system was initailize"));
+  ROCKET_ASSERT(Storage_Begin());
+  Serial.print(Storage_GetName());
+  Serial.println(F(" file system was initailize"));
+  FlightIndex_Init(&flight_index, FLIGHT_EVICTION_POLICY);
+  Serial.printf("Found %u flights\n", flight_index.count);
+#endif
+  csv_index_flight = latestFlight();
 
   // Initialize the I2C and configure the IMU and barometer
-  I2C_Init(2, 3); // SDA: GPIO2 and SCL: GPIO3
-  MPU6500_Init(&mpu6500, MPU6500_MAX_SAMPLE_RATE);
-  Serial.println(F("MPU6500 configured"));
-
-  MS5611_Init(&ms5611, MS5611_OSR_256); // Sample as fast as possible
-  Serial.println(F("MS5611 configured"));
-
-  // Configure the hotspot
-  // Note that we set the maximum number of connection to 1, as access to the log file is not thread safe
-  int channel = 1, ssid_hidden = 0, max_connection = 1;
-  ROCKET_ASSERT(WiFi.softAP(ssid, password, channel, ssid_hidden, max_connection));
-  IPAddress myIP = WiFi.softAPIP();
-  Serial.print(F("AP IP address: "));
-  Serial.println(myIP);
-
-  if (dnsServer.start(53, "*", myIP)) // Redirect all requests to the logger
-    Serial.println(F("DNS server started"));
-  else
-    Serial.println(F("Failed to start DNS server"));
+  I2C_Init(2, 3, USE_I2C_FAST_DRIVER); // SDA: GPIO2 and SCL: GPIO3
+  Logger_Init(&logger, MPU6500_MAX_SAMPLE_RATE, USE_MPU6500_FIFO);
+  Logger_SetAdaptiveRate(&logger, USE_ADAPTIVE_SAMPLE_RATE);
+  Logger_SetAutoRange(&logger, USE_IMU_AUTO_RANGE);
+  Logger_SetLogEstimates(&logger, USE_ESTIMATOR_LOG);
+  RadioQuiet_Init(&radio_quiet, USE_RADIO_QUIET);
+  Telemetry_Init(&telemetry);
+  Logger_SetTelemetry(&logger, &telemetry);
+  Stats_Reset();
 
   // Start the websever
-  server.on("/", HTTP_GET, handleRoot);
+  for (const web_asset_t &asset : web_assets) // The start page, the log viewer at /view and the live plots at /live
+    server.on(asset.url, HTTP_GET, [&asset](AsyncWebServerRequest *request) { handleAsset(request, &asset); });
+  server.on("/status", HTTP_GET, handleStatus);
   server.on("/log.txt", HTTP_GET, handleLogFileRead); // This will convert the binary log file into a CSV format
-  server.on(log_filename, HTTP_GET, [](AsyncWebServerRequest *request) {
-    request->send(SPIFFS, log_filename, "application/octet-stream"); // Send the log file in binary format
-  });
-  //server.serveStatic(LogFile::Filename, SPIFFS, LogFile::Filename);
+  server.on("/log.bin", HTTP_GET, handleLogBinaryRead); // Send the log file in binary format
+  //server.serveStatic(LogFile::Filename, Storage_GetFS(), LogFile::Filename);
+  server.on("/stats", HTTP_GET, handleStats);
+  ws.onEvent(handleTelemetryEvent);
+  server.addHandler(&ws);
+#if !USE_RAW_FLASH_LOG
+  server.on("/logs", HTTP_GET, handleLogs);
+#endif
   server.on("/start", HTTP_POST, loggingStart);
   server.on("/stop", HTTP_POST, loggingStop);
+#if !USE_RAW_FLASH_LOG
   server.on("/format", HTTP_GET, [](AsyncWebServerRequest *request) {
-    ROCKET_ASSERT(SPIFFS.format());
+    if (downloads > 0) {
+      request->send(409, F("text/plain"), F("409: A log is being downloaded"));
+      return;
+    }
+    stopIndexing();
+    CsvIndex_Reset(&csv_index);
+    ROCKET_ASSERT(Storage_Format());
+    FlightIndex_Init(&flight_index, FLIGHT_EVICTION_POLICY); // Start a new index
     request->send(200, F("text/plain"), F("Filesystem successfully formatted"));
   });
-  //server.serveStatic("/fs", SPIFFS, "/"); // Attach filesystem root at URL /fs
+#endif
+  //server.serveStatic("/fs", Storage_GetFS(), "/"); // Attach filesystem root at URL /fs
   server.onNotFound([](AsyncWebServerRequest *request) {
     request->send(404, F("text/plain"), F("404: Not Found"));
   });
-  server.begin();
-  Serial.println(F("HTTP server started"));
+  radioStart();
 }
 
 void loop() {
-  dnsServer.processNextRequest();
-
-  bool ready;
-  uint8_t rcode = MPU6500_DateReady(&ready);
-  if (rcode == 0) {
-    if (ready) {
-      MPU6500_GetData(&mpu6500);
-#if 0
-      Serial.print(mpu6500.gyroRate.roll * RAD_TO_DEGf); Serial.write(',');
-      Serial.print(mpu6500.gyroRate.pitch * RAD_TO_DEGf); Serial.write(',');
-      Serial.print(mpu6500.gyroRate.yaw * RAD_TO_DEGf); Serial.write(',');
-      Serial.print(mpu6500.accSi.X); Serial.write(',');
-      Serial.print(mpu6500.accSi.Y); Serial.write(',');
-      Serial.println(mpu6500.accSi.Z);
-#endif
-      rcode = MS5611_GetData(&ms5611);
-      if (rcode == 0) {
-#if 0
-        Serial.print(ms5611.pressure); Serial.print(F(" Pa,"));
-        Serial.print(ms5611.altitude); Serial.print(F(" m, "));
-        Serial.print(ms5611.temperature); Serial.print(F(" C\n"));
-#endif
-        if (log_file) { // Check if the file is open
-          log_t log = {
-            .timestamp = micros() - start_timestamp,
-            .pressure = ms5611.pressure,
-            .gyroX = mpu6500.gyroRate.roll * RAD_TO_DEGf,
-            .gyroY = mpu6500.gyroRate.pitch * RAD_TO_DEGf,
-            .gyroZ = mpu6500.gyroRate.yaw * RAD_TO_DEGf,
-            .accX = mpu6500.accSi.X,
-            .accY = mpu6500.accSi.Y,
-            .accZ = mpu6500.accSi.Z,
-          };
-
-          // Note that this might fail, but we do not care, as we will just write as fast as possible
-          log_file.write((uint8_t*)&log, sizeof(log));
-
-          static uint8_t check_files_info_counter = 0;
-          if (++check_files_info_counter >= 10) {
-            check_files_info_counter = 0;
-
-            // Determine if the file system is full
-            FSInfo fs_info;
-            SPIFFS.info(fs_info);
-
-            // TODO: Why does it stop working before it is actually full?
-            // It seems to have something to do with the blocks
-            if (fs_info.usedBytes + 2 * fs_info.blockSize >= fs_info.totalBytes) {
-              log_file.close();
-              Serial.print(F("Logging ended after: "));
-              Serial.print((float)(micros() - start_timestamp) * 1e-6f);
-              Serial.println(F(" s"));
-            }
-          }
-        }
-      } else {
-        Serial.print(F("Failed reading MS5611: "));
-        Serial.println(rcode);
-      }
-    }
-  } else {
-    Serial.print(F("Failed reading MS6500: "));
-    Serial.println(rcode);
-  }
-
+  Stats_Loop(); // Measure the time spent in every iteration
+  if (!radio_quiet.quiet)
+    dnsServer.processNextRequest();
+  Logger_Loop(&logger); // Read the sensors and write the samples to the log file
+  closeFlight(); // Update the index once the log is closed
+  indexLog(); // Find the length of the CSV file when the log is closed
+  if (!radio_quiet.quiet)
+    streamTelemetry(); // Send the live samples
+  updateRadio(); // Turn the radio off while logging a flight
   yield(); // Make sure we allow the RTOS to run other tasks
 }
@@ -20,31 +20,53 @@
 #include "rocket_assert.h"
 #include "i2c.h"
 #include "mpu6500.h"
+#include "stats.h"
 
 #define MPU6500_ADDRESS                     0x68
 #define MPU6500_WHO_AM_I_ID                 0x70
 
 #define MPU6500_SMPLRT_DIV                  0x19 /*!< Sample Rate Divider register */
+#define MPU6500_CONFIG                      0x1A /*!< Configuration register */
+#define MPU6500_GYRO_CONFIG                 0x1B /*!< Gyroscope Configuration register */
+#define MPU6500_FIFO_EN                     0x23 /*!< FIFO Enable register */
 #define MPU6500_INT_PIN_CFG                 0x37 /*!< INT Pin / Bypass Enable Configuration register */
 #define MPU6500_INT_STATUS                  0x3A /*!< Interrupts status register */
 #define MPU6500_ACCEL_XOUT_H                0x3B /*!< Start of Accelerometer Measurements registers */
 #define MPU6500_GYRO_XOUT_H                 0x43 /*!< Start of Gyroscope Measurements registers */
 #define MPU6500_USER_CTRL                   0x6A /*!< User Control register */
 #define MPU6500_PWR_MGMT_1                  0x6B /*!< Power Management 1 register */
+#define MPU6500_FIFO_COUNTH                 0x72 /*!< FIFO Count High register */
+#define MPU6500_FIFO_R_W                    0x74 /*!< FIFO Read Write register */
 #define MPU6500_WHO_AM_I                    0x75 /*!< Who Am I register */
 
-// MPU-6500 scale factors
-#define MPU6500_GYRO_SCALE_FACTOR_250       131.0f /*!< Gyroscope scale factor of +-250 deg/s */
-#define MPU6500_GYRO_SCALE_FACTOR_500       65.5f /*!< Gyroscope scale factor of +-500 deg/s */
-#define MPU6500_GYRO_SCALE_FACTOR_1000      32.8f /*!< Gyroscope scale factor of +-1000 deg/s */
-#define MPU6500_GYRO_SCALE_FACTOR_2000      16.4f /*!< Gyroscope scale factor of +-2000 deg/s */
+static_assert(MPU6500_GYRO_DLPF >= MPU6500_GYRO_DLPF_184 && MPU6500_GYRO_DLPF <= MPU6500_GYRO_DLPF_5, "The sample rate divider requires an internal sample rate of 1 kHz");
 
-#define MPU6500_ACC_SCALE_FACTOR_2          16384.0f /*!< Accelerometer scale factor of +-2 g */
-#define MPU6500_ACC_SCALE_FACTOR_4          8192.0f /*!< Accelerometer scale factor of +-4 g */
-#define MPU6500_ACC_SCALE_FACTOR_8          4096.0f /*!< Accelerometer scale factor of +-8 g */
-#define MPU6500_ACC_SCALE_FACTOR_16         2048.0f /*!< Accelerometer scale factor of +-16 g */
+// Sets the scale factors used to convert the readings when the range of the readings changes
+static void MPU6500_SetReadingRange(mpu6500_t *mpu6500, const mpu6500_range_t *range) {
+  mpu6500->range = *range;
+  mpu6500->gyroScaleFactor = MPU6500_GetGyroScaleFactor(range->gyro);
+  mpu6500->accScaleFactor = MPU6500_GetAccScaleFactor(range->acc);
+  mpu6500->gyroResolution = MPU6500_GetGyroResolution(range->gyro);
+  mpu6500->accResolution = MPU6500_GetAccResolution(range->acc);
+}
+
+static uint8_t MPU6500_FifoReset(mpu6500_t *mpu6500) {
+  I2CScheduler_Cancel(&mpu6500->fifo_job); // A read in progress is lost
+  mpu6500->fifo_buf_len = mpu6500->fifo_buf_index = 0;
+  mpu6500->fifo_read_len = mpu6500->fifo_read_index = 0;
+  uint8_t rcode = I2C_WriteData(MPU6500_ADDRESS, MPU6500_USER_CTRL, 1U << 2); // Reset the FIFO, the bit is cleared automatically
+  if (rcode != 0)
+    return rcode;
+  rcode = I2C_WriteData(MPU6500_ADDRESS, MPU6500_USER_CTRL, 1U << 6); // Enable the FIFO
+  if (rcode != 0)
+    return rcode;
+
+  // The first sample is written to the FIFO one sample period after the reset
+  mpu6500->fifo_timestamp = mpu6500->fifo_poll_timestamp = micros();
+  return 0;
+}
 
-void MPU6500_Init(mpu6500_t *mpu6500, uint16_t sample_rate) {
+void MPU6500_Init(mpu6500_t *mpu6500, uint16_t sample_rate, bool use_fifo /*= false*/) {
   uint8_t buf[5]; // Buffer for I2C data
   ROCKET_ASSERT(I2C_ReadData(MPU6500_ADDRESS, MPU6500_WHO_AM_I, buf, 1) == 0);
   ROCKET_ASSERT(buf[0] == MPU6500_WHO_AM_I_ID || buf[0] == MPU6500_WHO_AM_I_ID); // Read "WHO_AM_I" register
@@ -60,15 +82,27 @@ void MPU6500_Init(mpu6500_t *mpu6500, uint16_t sample_rate) {
 
   ROCKET_ASSERT(sample_rate >= MPU6500_MIN_SAMPLE_RATE && sample_rate <= MPU6500_MAX_SAMPLE_RATE);
   buf[0] = 1000U / sample_rate - 1; // Set the sample rate in Hz - frequency = 1000/(register + 1) Hz
-  buf[1] = 0x01; // Disable FSYNC and set 184 Hz Gyro filtering, 1 kHz sampling rate
-  buf[2] = 0U << 3; // Set Gyro Full Scale Range to +-250 deg/s
-  buf[3] = 3U << 3; // Set Accelerometer Full Scale Range to +-16 g
-  buf[4] = 0x00; // 218.1 Hz Acc filtering, 1 kHz sampling rate
+  buf[1] = MPU6500_GYRO_DLPF; // Disable FSYNC and set the Gyro filtering, 1 kHz sampling rate
+  if (use_fifo)
+    buf[1] |= 1U << 6; // Set FIFO_MODE, so no samples are overwritten when the FIFO is full, as that would misalign the samples
+  buf[2] = MPU6500_GYRO_RANGE << 3; // Set Gyro Full Scale Range
+  buf[3] = MPU6500_ACC_RANGE << 3; // Set Accelerometer Full Scale Range
+  buf[4] = MPU6500_ACC_DLPF; // Set the Acc filtering, 1 kHz sampling rate
   ROCKET_ASSERT(I2C_WriteData(MPU6500_ADDRESS, MPU6500_SMPLRT_DIV, buf, 5) == 0); // Write to all five registers at once
 
   // Set accelerometer and gyroscope scale factor from datasheet
-  mpu6500->gyroScaleFactor = MPU6500_GYRO_SCALE_FACTOR_250;
-  mpu6500->accScaleFactor = MPU6500_ACC_SCALE_FACTOR_16;
+  const mpu6500_range_t range = { MPU6500_GYRO_RANGE, MPU6500_ACC_RANGE };
+  MPU6500_SetReadingRange(mpu6500, &range);
+  mpu6500->config_range = mpu6500->fifo_buf_range = range;
+  mpu6500->sample_period_micros = (uint32_t)(buf[0] + 1) * 1000U;
+
+  mpu6500->fifo_enabled = use_fifo;
+  mpu6500->fifo_dropped = mpu6500->fifo_lost = 0;
+  I2CJob_Init(&mpu6500->fifo_job, MPU6500_ADDRESS, I2C_PRIORITY_HIGH);
+  if (use_fifo) {
+    ROCKET_ASSERT(I2C_WriteData(MPU6500_ADDRESS, MPU6500_FIFO_EN, (1U << 6) | (1U << 5) | (1U << 4) | (1U << 3)) == 0); // Write the gyroscope and accelerometer readings to the FIFO
+    ROCKET_ASSERT(MPU6500_FifoReset(mpu6500) == 0);
+  }
 
 #if 0
   // Enable Raw Data Ready Interrupt on INT pin
@@ -82,10 +116,64 @@ void MPU6500_Init(mpu6500_t *mpu6500, uint16_t sample_rate) {
   delay(10); // Wait for sensor to stabilize
 }
 
-void MPU6500_SetSampleRate(uint16_t sample_rate) {
+// The FIFO has to be reset, as the timestamps are reconstructed from the sample rate. If no samples are buffered,
+// then the samples taken at the old sample rate are read from the FIFO first, so they are not lost.
+// Use MPU6500_HasBufferedData() to check if the buffer is empty
+uint8_t MPU6500_SetSampleRate(mpu6500_t *mpu6500, uint16_t sample_rate) {
   ROCKET_ASSERT(sample_rate >= MPU6500_MIN_SAMPLE_RATE && sample_rate <= MPU6500_MAX_SAMPLE_RATE);
+  uint8_t rcode;
+  if (mpu6500->fifo_enabled && !MPU6500_HasBufferedData(mpu6500)) {
+    rcode = MPU6500_FifoRead(mpu6500);
+    if (rcode != 0)
+      return rcode;
+  }
+
   uint8_t reg = 1000U / sample_rate - 1; // Set the sample rate in Hz - frequency = 1000/(register + 1) Hz
-  ROCKET_ASSERT(I2C_WriteData(MPU6500_ADDRESS, MPU6500_SMPLRT_DIV, reg) == 0); // Update the sample rate
+  rcode = I2C_WriteData(MPU6500_ADDRESS, MPU6500_SMPLRT_DIV, reg); // Update the sample rate
+  if (rcode != 0)
+    return rcode;
+  mpu6500->sample_period_micros = (uint32_t)(reg + 1) * 1000U;
+  if (mpu6500->fifo_enabled) {
+    uint16_t len = mpu6500->fifo_buf_len, index = mpu6500->fifo_buf_index;
+    rcode = MPU6500_FifoReset(mpu6500);
+    mpu6500->fifo_buf_len = len; // Keep the buffered samples
+    mpu6500->fifo_buf_index = index;
+  }
+  return rcode;
+}
+
+// Changes the full-scale ranges. Like when the sample rate is changed, the samples taken using the old ranges are read
+// from the FIFO first if no samples are buffered, and the range of the readings only changes once they are returned.
+// Use MPU6500_HasBufferedData() to check if the buffer is empty
+uint8_t MPU6500_SetRange(mpu6500_t *mpu6500, const mpu6500_range_t *range) {
+  uint8_t rcode;
+  if (mpu6500->fifo_enabled && !MPU6500_HasBufferedData(mpu6500)) {
+    rcode = MPU6500_FifoRead(mpu6500);
+    if (rcode != 0)
+      return rcode;
+  }
+
+  uint8_t buf[2];
+  buf[0] = range->gyro << 3; // Gyro Full Scale Range. The self-test and filter bits are cleared
+  buf[1] = range->acc << 3; // Accelerometer Full Scale Range
+  rcode = I2C_WriteData(MPU6500_ADDRESS, MPU6500_GYRO_CONFIG, buf, 2); // Write to both registers at once
+  if (rcode != 0)
+    return rcode;
+  mpu6500->config_range = *range;
+  if (!mpu6500->fifo_enabled) {
+    MPU6500_SetReadingRange(mpu6500, range);
+    return 0;
+  }
+  uint16_t len = mpu6500->fifo_buf_len, index = mpu6500->fifo_buf_index;
+  rcode = MPU6500_FifoReset(mpu6500); // The samples taken while the range was changed are discarded
+  mpu6500->fifo_buf_len = len; // Keep the buffered samples
+  mpu6500->fifo_buf_index = index;
+  return rcode;
+}
+
+// Returns true if samples read from the FIFO have not been returned yet
+bool MPU6500_HasBufferedData(const mpu6500_t *mpu6500) {
+  return mpu6500->fifo_enabled && mpu6500->fifo_buf_index < mpu6500->fifo_buf_len;
 }
 
 uint8_t MPU6500_DateReady(bool *ready) {
@@ -97,26 +185,211 @@ uint8_t MPU6500_DateReady(bool *ready) {
   return 0;
 }
 
-// Returns accelerometer and gyro data with zero values subtracted
+// Parses the accelerometer and gyroscope registers into the raw readings
+static void MPU6500_ParseData(mpu6500_t *mpu6500, const uint8_t *acc_buf, const uint8_t *gyro_buf) {
+  mpu6500->accRaw.X = (int16_t)((acc_buf[0] << 8) | acc_buf[1]);
+  mpu6500->accRaw.Y = (int16_t)((acc_buf[2] << 8) | acc_buf[3]);
+  mpu6500->accRaw.Z = (int16_t)((acc_buf[4] << 8) | acc_buf[5]);
+  mpu6500->gyroRaw.X = (int16_t)((gyro_buf[0] << 8) | gyro_buf[1]);
+  mpu6500->gyroRaw.Y = (int16_t)((gyro_buf[2] << 8) | gyro_buf[3]);
+  mpu6500->gyroRaw.Z = (int16_t)((gyro_buf[4] << 8) | gyro_buf[5]);
+}
+
+// Returns the raw accelerometer and gyro data. Use MPU6500_ConvertData() to convert them into SI units
 uint8_t MPU6500_GetData(mpu6500_t *mpu6500) {
   uint8_t buf[14]; // Buffer for the SPI data
+  uint32_t now = micros();
   uint8_t rcode = I2C_ReadData(MPU6500_ADDRESS, MPU6500_ACCEL_XOUT_H, buf, 14);
   if (rcode != 0)
     return rcode;
 
-  sensorRaw_t acc, gyro; /*!< Raw accelerometer and gyroscope readings */
-  acc.X = (int16_t)((buf[0] << 8) | buf[1]);
-  acc.Y = (int16_t)((buf[2] << 8) | buf[3]);
-  acc.Z = (int16_t)((buf[4] << 8) | buf[5]);
+  // A new sample is taken every sample period, so a sample read later than that has waited for the rest
+  const uint32_t interval = now - mpu6500->timestamp, period = mpu6500->sample_period_micros;
+  Stats_RecordMicros(&stats.latency, interval > period ? interval - period : 0);
+
   /*int16_t tempRaw = (int16_t)((buf[6] << 8) | buf[7]);*/
-  gyro.X = (int16_t)((buf[8] << 8) | buf[9]);
-  gyro.Y = (int16_t)((buf[10] << 8) | buf[11]);
-  gyro.Z = (int16_t)((buf[12] << 8) | buf[13]);
+  MPU6500_ParseData(mpu6500, &buf[0], &buf[8]);
+  mpu6500->timestamp = now;
+
+  return 0;
+}
+
+// Parses the FIFO count read at "now" and prepares reading the complete samples. Returns the number of samples
+static uint16_t MPU6500_FifoParseCount(mpu6500_t *mpu6500, const uint8_t *buf, uint32_t now) {
+  mpu6500->fifo_poll_timestamp = now;
+  uint16_t count = (uint16_t)(((buf[0] & 0x1F) << 8) | buf[1]);
+
+  // The FIFO stops accepting new samples when there is no room for another complete sample
+  mpu6500->fifo_read_overflow = count + MPU6500_FIFO_SAMPLE_SIZE > MPU6500_FIFO_SIZE;
+  uint16_t samples = count / MPU6500_FIFO_SAMPLE_SIZE;
+  Stats_HighWater(&stats.fifo_high_water, samples);
+
+  // The oldest unread sample was taken one sample period after the newest sample read before, so this is how long it has
+  // waited in the FIFO plus a sample period. It also covers the samples lost if the FIFO overflowed
+  Stats_RecordMicros(&stats.latency, now - mpu6500->fifo_timestamp);
+  mpu6500->fifo_read_len = samples * MPU6500_FIFO_SAMPLE_SIZE;
+  mpu6500->fifo_read_index = 0;
+  return samples;
+}
+
+// Returns the number of bytes to read in the next burst. The samples are read in bursts if the driver limits the length
+// of a read, as the FIFO register address is not incremented
+static uint16_t MPU6500_FifoGetBurst(const mpu6500_t *mpu6500) {
+  size_t burst = mpu6500->fifo_read_len - mpu6500->fifo_read_index;
+  size_t max = I2C_GetMaxReadSize() / MPU6500_FIFO_SAMPLE_SIZE * MPU6500_FIFO_SAMPLE_SIZE; // Only read complete samples
+  return (uint16_t)(burst < max ? burst : max);
+}
+
+static uint8_t MPU6500_FifoReadFailed(mpu6500_t *mpu6500, uint8_t rcode) {
+  // The FIFO is now misaligned, so start over
+  mpu6500->fifo_dropped += mpu6500->fifo_read_len / MPU6500_FIFO_SAMPLE_SIZE;
+  MPU6500_FifoReset(mpu6500);
+  return rcode; // Return the original error
+}
+
+// Hands the samples over to the buffer once they are all read
+static uint8_t MPU6500_FifoReadDone(mpu6500_t *mpu6500) {
+  const uint32_t period = mpu6500->sample_period_micros, now = mpu6500->fifo_poll_timestamp;
+  const uint16_t len = mpu6500->fifo_read_len, samples = len / MPU6500_FIFO_SAMPLE_SIZE;
+  mpu6500->fifo_read_len = mpu6500->fifo_read_index = 0;
+
+  // Reconstruct the timestamps from the sample rate divider. As the newest sample was taken at most one sample period
+  // before the FIFO count was read, it is kept within that window and the samples are spread evenly since the previous
+  // newest sample. This corrects for the drift between the clocks while keeping the timestamps monotonic
+  uint32_t newest = mpu6500->fifo_timestamp + samples * period;
+  if ((int32_t)(newest - now) > 0)
+    newest = now;
+  else if (!mpu6500->fifo_read_overflow && now - newest > period)
+    newest = now - period;
+  mpu6500->fifo_buf_period = (newest - mpu6500->fifo_timestamp) / samples;
+  mpu6500->fifo_buf_timestamp = mpu6500->fifo_timestamp + mpu6500->fifo_buf_period;
+  mpu6500->fifo_timestamp = newest;
+  mpu6500->fifo_buf_len = len;
+  mpu6500->fifo_buf_index = 0;
+  mpu6500->fifo_buf_range = mpu6500->config_range; // The FIFO is reset when the range is changed
+
+  if (mpu6500->fifo_read_overflow) {
+    // Estimate the number of samples lost since the FIFO was filled until it is reset and start over.
+    // They were taken after the samples just read
+    mpu6500->fifo_lost += (micros() - mpu6500->fifo_timestamp) / period;
+    uint8_t rcode = MPU6500_FifoReset(mpu6500);
+    mpu6500->fifo_buf_len = len; // Keep the samples that were just read
+    return rcode;
+  }
+
+  return 0;
+}
+
+// Counts the samples lost after the buffered samples once these have all been returned
+static void MPU6500_FifoCountLost(mpu6500_t *mpu6500) {
+  mpu6500->fifo_dropped += mpu6500->fifo_lost;
+  mpu6500->fifo_lost = 0;
+}
+
+// Handles a transaction of the FIFO job, which is done. Returns the error code of the transaction
+static uint8_t MPU6500_FifoJobDone(mpu6500_t *mpu6500) {
+  i2c_job_t *job = &mpu6500->fifo_job;
+  job->state = I2C_JOB_IDLE;
+  if (job->reg == MPU6500_FIFO_COUNTH) {
+    if (job->rcode == 0)
+      MPU6500_FifoParseCount(mpu6500, mpu6500->fifo_count_buf, job->timestamp);
+    return job->rcode;
+  }
+  if (job->rcode != 0)
+    return MPU6500_FifoReadFailed(mpu6500, job->rcode);
+  mpu6500->fifo_read_index += job->size;
+  return 0;
+}
+
+// Reads all complete samples from the FIFO into the buffer without going through the I2C scheduler.
+// A read started by MPU6500_FifoGetData() is completed. The buffer must be empty, see MPU6500_HasBufferedData()
+uint8_t MPU6500_FifoRead(mpu6500_t *mpu6500) {
+  uint8_t rcode;
+  MPU6500_FifoCountLost(mpu6500);
+  if (mpu6500->fifo_job.state == I2C_JOB_DONE) {
+    rcode = MPU6500_FifoJobDone(mpu6500);
+    if (rcode != 0)
+      return rcode;
+  } else
+    I2CScheduler_Cancel(&mpu6500->fifo_job);
+  mpu6500->fifo_buf_len = mpu6500->fifo_buf_index = 0;
+
+  if (mpu6500->fifo_read_len == 0) { // Check if the count has been read
+    uint8_t buf[2];
+    uint32_t now = micros();
+    rcode = I2C_ReadData(MPU6500_ADDRESS, MPU6500_FIFO_COUNTH, buf, 2);
+    if (rcode != 0)
+      return rcode;
+    if (MPU6500_FifoParseCount(mpu6500, buf, now) == 0)
+      return 0;
+  }
 
-  for (uint8_t axis = 0; axis < 3; axis++) {
-    mpu6500->accSi.data[axis] = (float)acc.data[axis] / mpu6500->accScaleFactor * GRAVITATIONAL_ACCELERATION; // Convert to m/s^2
-    mpu6500->gyroRate.data[axis] = (float)gyro.data[axis] / mpu6500->gyroScaleFactor * DEG_TO_RADf; // Convert to rad/s
+  while (mpu6500->fifo_read_index < mpu6500->fifo_read_len) {
+    uint16_t burst = MPU6500_FifoGetBurst(mpu6500);
+    rcode = I2C_ReadData(MPU6500_ADDRESS, MPU6500_FIFO_R_W, &mpu6500->fifo_buf[mpu6500->fifo_read_index], burst);
+    if (rcode != 0)
+      return MPU6500_FifoReadFailed(mpu6500, rcode);
+    mpu6500->fifo_read_index += burst;
   }
+  return MPU6500_FifoReadDone(mpu6500);
+}
+
+// Reads the FIFO using the I2C scheduler. The count is read when at least MPU6500_FIFO_BATCH_SAMPLES should be
+// available, so many samples are transferred at a time, and then the samples are read right away. The deadline is
+// when the FIFO has no room for the next sample
+static uint8_t MPU6500_FifoUpdate(mpu6500_t *mpu6500) {
+  i2c_job_t *job = &mpu6500->fifo_job;
+  if (job->state == I2C_JOB_PENDING)
+    return 0;
+  if (job->state == I2C_JOB_DONE) {
+    uint8_t rcode = MPU6500_FifoJobDone(mpu6500);
+    if (rcode != 0)
+      return rcode;
+  }
+
+  const uint32_t period = mpu6500->sample_period_micros;
+  const uint32_t deadline = mpu6500->fifo_timestamp + (MPU6500_FIFO_SIZE / MPU6500_FIFO_SAMPLE_SIZE + 1) * period;
+  if (mpu6500->fifo_read_index < mpu6500->fifo_read_len) {
+    job->reg = MPU6500_FIFO_R_W;
+    job->data = &mpu6500->fifo_buf[mpu6500->fifo_read_index];
+    job->size = MPU6500_FifoGetBurst(mpu6500);
+    job->read = true;
+    job->send_stop = false;
+    I2CScheduler_Submit(job, micros(), deadline);
+    return 0;
+  }
+  if (mpu6500->fifo_read_len > 0)
+    return MPU6500_FifoReadDone(mpu6500);
+
+  job->reg = MPU6500_FIFO_COUNTH;
+  job->data = mpu6500->fifo_count_buf;
+  job->size = sizeof(mpu6500->fifo_count_buf);
+  job->read = true;
+  job->send_stop = false;
+  I2CScheduler_Submit(job, mpu6500->fifo_poll_timestamp + MPU6500_FIFO_BATCH_SAMPLES * period, deadline);
+  return 0;
+}
+
+// Returns one sample at a time from the FIFO. The FIFO is only read when all buffered samples have been returned
+uint8_t MPU6500_FifoGetData(mpu6500_t *mpu6500, bool *ready) {
+  *ready = false;
+
+  if (mpu6500->fifo_buf_index >= mpu6500->fifo_buf_len) { // Check if all buffered samples have been returned
+    MPU6500_FifoCountLost(mpu6500);
+    uint8_t rcode = MPU6500_FifoUpdate(mpu6500);
+    if (rcode != 0)
+      return rcode;
+    if (mpu6500->fifo_buf_index >= mpu6500->fifo_buf_len)
+      return 0; // The samples are not read yet
+  }
+
+  if (!MPU6500_RangeEquals(&mpu6500->range, &mpu6500->fifo_buf_range))
+    MPU6500_SetReadingRange(mpu6500, &mpu6500->fifo_buf_range);
+  const uint8_t *buf = &mpu6500->fifo_buf[mpu6500->fifo_buf_index];
+  MPU6500_ParseData(mpu6500, &buf[0], &buf[6]); // The accelerometer is followed by the gyroscope readings
+  mpu6500->timestamp = mpu6500->fifo_buf_timestamp + mpu6500->fifo_buf_index / MPU6500_FIFO_SAMPLE_SIZE * mpu6500->fifo_buf_period;
+  mpu6500->fifo_buf_index += MPU6500_FIFO_SAMPLE_SIZE;
+  *ready = true;
 
   return 0;
 }
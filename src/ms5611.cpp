@@ -31,13 +31,39 @@
 #define MS5611_CMD_CONV_D2              0x50
 #define MS5611_CMD_READ_PROM            0xA2
 
-#define pow2(x)                         ((x)*(x))
+static uint8_t MS5611_GetConversionCommand(const ms5611_t *ms5611, ms5611_state_e state) {
+  return (state == MS5611_STATE_CONV_D1 ? MS5611_CMD_CONV_D1 : MS5611_CMD_CONV_D2) | ms5611->osr_mask;
+}
 
-void MS5611_Init(ms5611_t *ms5611, ms5611_osr_mask_e ms5611_osr_mask) {
-  ROCKET_ASSERT(I2C_Write(MS5611_ADDRESS, MS5611_CMD_RESET) == 0);
+static uint8_t MS5611_StartConversion(ms5611_t *ms5611, ms5611_state_e state) {
+  uint8_t rcode = I2C_Write(MS5611_ADDRESS, MS5611_GetConversionCommand(ms5611, state));
+  if (rcode != 0) {
+    ms5611->state = MS5611_STATE_IDLE;
+    return rcode;
+  }
+  ms5611->state = state;
+  ms5611->conversion_timestamp = micros();
+  ms5611->conversion_delay_micros = ms5611->osr_delay_micros; // The OSR might be changed while converting
+  return 0;
+}
+
+static uint32_t MS5611_ParseAdc(const uint8_t *buf) {
+  return (uint32_t)((buf[0] << 16) | (buf[1] << 8) | buf[2]);
+}
 
-  // Set the OSR value and set the delay required for a measurement
-  // Note that the maximum value from the datasheet is used
+static uint8_t MS5611_ReadAdc(ms5611_t *ms5611, uint32_t *adc) {
+  uint8_t buf[3];
+  ms5611->state = MS5611_STATE_IDLE; // The conversion is finished no matter if the read succeeds or not
+  uint8_t rcode = I2C_ReadData(MS5611_ADDRESS, MS5611_CMD_ADC_READ, buf, 3, true);
+  if (rcode != 0)
+    return rcode;
+  *adc = MS5611_ParseAdc(buf);
+  return 0;
+}
+
+// Set the OSR value and set the delay required for a measurement. A running conversion finishes using the old value
+// Note that the maximum value from the datasheet is used
+void MS5611_SetOsr(ms5611_t *ms5611, ms5611_osr_mask_e ms5611_osr_mask) {
   ms5611->osr_mask = ms5611_osr_mask;
   switch (ms5611->osr_mask) {
     case MS5611_OSR_4096:
@@ -58,6 +84,17 @@ void MS5611_Init(ms5611_t *ms5611, ms5611_osr_mask_e ms5611_osr_mask) {
     default:
       ROCKET_ASSERT(false && "Invalid OSR value");
   }
+}
+
+void MS5611_Init(ms5611_t *ms5611, ms5611_osr_mask_e ms5611_osr_mask, uint8_t temperature_interval /*= 1*/) {
+  ROCKET_ASSERT(I2C_Write(MS5611_ADDRESS, MS5611_CMD_RESET) == 0);
+
+  MS5611_SetOsr(ms5611, ms5611_osr_mask);
+  ROCKET_ASSERT(temperature_interval > 0);
+  ms5611->temperature_interval = temperature_interval;
+  ms5611->temperature_counter = 0;
+  ms5611->state = MS5611_STATE_IDLE;
+  I2CJob_Init(&ms5611->job, MS5611_ADDRESS, I2C_PRIORITY_LOW);
 
   delay(100);
 
@@ -68,75 +105,92 @@ void MS5611_Init(ms5611_t *ms5611, ms5611_osr_mask_e ms5611_osr_mask) {
     ROCKET_ASSERT(I2C_ReadData(MS5611_ADDRESS, MS5611_CMD_READ_PROM + 2 * i, buf, 2, true) == 0);
     ms5611->prom_c[i] = (uint16_t)((buf[0] << 8) | buf[1]);
   }
+
+  // Do a blocking read, so the compensation values are valid before the first pressure conversion
+  ROCKET_ASSERT(MS5611_GetData(ms5611) == 0);
 }
 
+// Blocking read of both the pressure and temperature
 uint8_t MS5611_GetData(ms5611_t *ms5611) {
-  uint8_t buf[3];
+  uint32_t D1, D2;
 
   // Read digital pressure and temperature data
-  uint8_t rcode = I2C_Write(MS5611_ADDRESS, MS5611_CMD_CONV_D1 | ms5611->osr_mask);
+  uint8_t rcode = MS5611_StartConversion(ms5611, MS5611_STATE_CONV_D1);
   if (rcode != 0)
     return rcode;
   delayMicroseconds(ms5611->osr_delay_micros);
-  rcode = I2C_ReadData(MS5611_ADDRESS, MS5611_CMD_ADC_READ, buf, 3, true);
+  rcode = MS5611_ReadAdc(ms5611, &D1);
   if (rcode != 0)
     return rcode;
-  uint32_t D1 = (uint32_t)((buf[0] << 16) | (buf[1] << 8) | buf[2]);
 
-  rcode = I2C_Write(MS5611_ADDRESS, MS5611_CMD_CONV_D2 | ms5611->osr_mask);
+  rcode = MS5611_StartConversion(ms5611, MS5611_STATE_CONV_D2);
   if (rcode != 0)
     return rcode;
   delayMicroseconds(ms5611->osr_delay_micros);
-  rcode = I2C_ReadData(MS5611_ADDRESS, MS5611_CMD_ADC_READ, buf, 3, true);
+  rcode = MS5611_ReadAdc(ms5611, &D2);
   if (rcode != 0)
     return rcode;
-  uint32_t D2 = (uint32_t)((buf[0] << 16) | (buf[1] << 8) | buf[2]);
 
-  // Difference between actual and reference temperature
-  int32_t dT = D2 - (uint32_t)ms5611->prom_c[4] * 256;
+  MS5611_CalculateTemperature(ms5611, D2);
+  MS5611_CalculatePressure(ms5611, D1);
 
-  // Actual temperature (-40 ... 85 C with 0.01 C resolution)
-  int32_t TEMP = 2000L + ((int64_t)dT * (int64_t)ms5611->prom_c[5]) / 8388608UL;
-
-  // Offset at actual temperature
-  int64_t OFF = (int64_t)ms5611->prom_c[1] * 65536 + ((int64_t)ms5611->prom_c[3] * dT) / 128;
+  return 0;
+}
 
-  // Sensitivity at actual temperature
-  int64_t SENS = (int64_t)ms5611->prom_c[0] * 32768 + ((int64_t)ms5611->prom_c[2] * dT) / 256;
+// Non-blocking read using the I2C scheduler. This will start a new conversion if none is running and read the result
+// once it is done, so the bus is free for the IMU while converting.
+// The temperature is only converted once every "temperature_interval" pressure conversions,
+// in between the cached compensation values are reused.
+// "ready" is set to true when a new pressure value has been calculated.
+uint8_t MS5611_Update(ms5611_t *ms5611, bool *ready) {
+  *ready = false;
+  i2c_job_t *job = &ms5611->job;
+  if (job->state == I2C_JOB_PENDING)
+    return 0; // The conversion is still running or the bus is busy
+
+  if (job->state == I2C_JOB_DONE) {
+    job->state = I2C_JOB_IDLE;
+    if (job->rcode != 0) {
+      ms5611->state = MS5611_STATE_IDLE; // Start over
+      return job->rcode;
+    }
 
-  // Check if the temperature is below 20 C
-  int32_t T2 = 0;
-  int64_t OFF2 = 0, SENS2 = 0;
-  if (TEMP < 2000) {
-    T2 = pow2((int64_t)dT) / 2147483648UL;
-    OFF2 = 5 * pow2((int64_t)(TEMP - 2000)) / 2;
-    SENS2 = 5 * pow2((int64_t)(TEMP - 2000)) / 4;
+    if (!job->read) {
+      // The conversion was started, so read the result once it is done
+      ms5611->state = (job->reg & 0xF0) == MS5611_CMD_CONV_D2 ? MS5611_STATE_CONV_D2 : MS5611_STATE_CONV_D1;
+      ms5611->conversion_timestamp = micros();
+      ms5611->conversion_delay_micros = ms5611->osr_delay_micros; // The OSR might be changed while converting
+      job->reg = MS5611_CMD_ADC_READ;
+      job->data = ms5611->adc_buf;
+      job->size = sizeof(ms5611->adc_buf);
+      job->read = job->send_stop = true;
+      uint32_t done = ms5611->conversion_timestamp + ms5611->conversion_delay_micros;
+      I2CScheduler_Submit(job, done, done + ms5611->conversion_delay_micros);
+      return 0;
+    }
 
-    // Check if the temperature is below -15 C
-    if (TEMP < -1500) {
-      OFF2 = OFF2 + 7 * pow2((int64_t)(TEMP + 1500));
-      SENS2 = SENS2 + 11 * pow2((int64_t)(TEMP + 1500)) / 2;
+    ms5611_state_e state = ms5611->state;
+    ms5611->state = MS5611_STATE_IDLE;
+    if (state == MS5611_STATE_CONV_D2)
+      MS5611_CalculateTemperature(ms5611, MS5611_ParseAdc(ms5611->adc_buf));
+    else {
+      MS5611_CalculatePressure(ms5611, MS5611_ParseAdc(ms5611->adc_buf));
+      ms5611->temperature_counter++;
+      *ready = true;
     }
   }
 
-  // Second order temperature compensation
-  TEMP = TEMP - T2;
-  OFF = OFF - OFF2;
-  SENS = SENS - SENS2;
-
-  // Temperature compensated pressure (10 ... 1200 mbar with 0.01 mbar resolution i.e. pascal)
-  ms5611->pressure = (D1 * SENS / 2097152UL - OFF) / 32768;
-
-  static const int32_t p0 = 101325; // Pressure at sea level
-  ms5611->altitude = 44330.0f * (1.0f - powf((float)ms5611->pressure / (float)p0, 1.0f / 5.255f)); // Get altitude in m
-
-  // Convert temperature to celsius
-  ms5611->temperature = (float)TEMP / 100.0f;
-
+  // Start the next conversion right away
+  ms5611_state_e state = MS5611_STATE_CONV_D1;
+  if (ms5611->temperature_counter >= ms5611->temperature_interval) {
+    ms5611->temperature_counter = 0;
+    state = MS5611_STATE_CONV_D2;
+  }
+  job->reg = MS5611_GetConversionCommand(ms5611, state);
+  job->data = nullptr;
+  job->size = 0;
+  job->read = false;
+  uint32_t now = micros();
+  I2CScheduler_Submit(job, now, now + ms5611->osr_delay_micros);
   return 0;
 }
-
-float MS5611_GetAbsoluteAltitude(int32_t pressure) {
-  static const uint32_t p0 = 101325U; // Pressure at sea level
-  return 44330.0f * (1.0f - powf((float)pressure / (float)p0, 1.0f / 5.255f)); // Calculate the absolute altitude
-}
@@ -0,0 +1,53 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include "radio_quiet.h"
+
+void RadioQuiet_Init(radio_quiet_t *radio_quiet, bool enabled) {
+  radio_quiet->enabled = enabled;
+  radio_quiet->quiet = radio_quiet->logging = radio_quiet->done = false;
+  radio_quiet->start_millis = radio_quiet->off_millis = 0;
+}
+
+// Returns what should be done with the radio. It is turned on again when the log is stopped, the landing is detected
+// or after RADIO_QUIET_TIMEOUT_MILLIS, and it is not turned off again during the same log
+radio_quiet_action_e RadioQuiet_Update(radio_quiet_t *radio_quiet, const logger_t *logger, uint32_t now_millis) {
+  const bool logging = Logger_IsLogging(logger);
+  const bool landed = Logger_GetPhase(logger) == FLIGHT_PHASE_LANDED;
+  if (radio_quiet->quiet) {
+    if (logging && !landed && now_millis - radio_quiet->off_millis < RADIO_QUIET_TIMEOUT_MILLIS)
+      return RADIO_QUIET_NONE;
+    radio_quiet->quiet = false;
+    radio_quiet->done = logging;
+    return RADIO_QUIET_TURN_ON;
+  }
+
+  if (!logging) {
+    radio_quiet->logging = radio_quiet->done = false;
+    return RADIO_QUIET_NONE;
+  }
+  if (!radio_quiet->logging) {
+    radio_quiet->logging = true;
+    radio_quiet->start_millis = now_millis;
+  }
+  if (!radio_quiet->enabled || radio_quiet->done || landed || Logger_IsArmed(logger) || Logger_IsErasing(logger) ||
+      now_millis - radio_quiet->start_millis < RADIO_QUIET_GRACE_MILLIS)
+    return RADIO_QUIET_NONE;
+  radio_quiet->quiet = true;
+  radio_quiet->off_millis = now_millis;
+  return RADIO_QUIET_TURN_OFF;
+}
@@ -0,0 +1,54 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include "record_queue.h"
+
+void RecordQueue_Init(record_queue_t *queue) {
+  queue->head = queue->tail = 0;
+}
+
+// Adds a record to the end of the queue. Returns false if it is full. This and RecordQueue_GetNewest() are called by the producer
+bool RecordQueue_Push(record_queue_t *queue, const log_record_t *record) {
+  uint16_t tail = queue->tail, next = (tail + 1) % RECORD_QUEUE_SIZE;
+  if (next == queue->head)
+    return false;
+  queue->records[tail] = *record;
+  __sync_synchronize(); // The record must be written before it is handed over
+  queue->tail = next;
+  return true;
+}
+
+// Returns the record added last or nullptr if the queue is empty
+const log_record_t *RecordQueue_GetNewest(const record_queue_t *queue) {
+  if (queue->tail == queue->head)
+    return nullptr;
+  return &queue->records[(queue->tail + RECORD_QUEUE_SIZE - 1) % RECORD_QUEUE_SIZE];
+}
+
+// Returns the oldest record or nullptr if the queue is empty. It stays valid until RecordQueue_Pop() is called.
+// This and RecordQueue_Pop() are called by the consumer
+const log_record_t *RecordQueue_Peek(const record_queue_t *queue) {
+  if (queue->head == queue->tail)
+    return nullptr;
+  __sync_synchronize(); // Read the record after the tail
+  return &queue->records[queue->head];
+}
+
+void RecordQueue_Pop(record_queue_t *queue) {
+  __sync_synchronize(); // Done reading the record before the slot is given back
+  queue->head = (queue->head + 1) % RECORD_QUEUE_SIZE;
+}
@@ -0,0 +1,89 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Minimal replacement for the Arduino core used by the native simulator. The time is simulated, see sim.h
+
+#ifndef __sim_arduino_h__
+#define __sim_arduino_h__
+
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define F(string_literal)           (string_literal)
+#define constrain(amt, low, high)   ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+uint32_t micros();
+uint32_t millis();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+/** Writes the serial output to stderr, so it does not mix with the report from the simulator */
+class HardwareSerial {
+public:
+  void begin(uint32_t baud) { (void)baud; }
+  void setEnabled(bool enabled) { enabled_ = enabled; }
+
+  size_t write(uint8_t c) { return enabled_ ? fputc(c, stderr) != EOF : 1; }
+  size_t print(const char *s) { return enabled_ ? fputs(s, stderr) : 0; }
+  size_t print(char c) { return write(c); }
+  size_t print(unsigned char n) { return printf("%u", n); }
+  size_t print(int n) { return printf("%d", n); }
+  size_t print(unsigned int n) { return printf("%u", n); }
+  size_t print(long n) { return printf("%ld", n); }
+  size_t print(unsigned long n) { return printf("%lu", n); }
+  size_t print(double n, int digits = 2) { return printf("%.*f", digits, n); }
+  size_t println() { return print("\n"); }
+  template<typename T> size_t println(T value) { return print(value) + println(); }
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+    if (!enabled_)
+      return 0;
+    va_list args;
+    va_start(args, format);
+    int n = vfprintf(stderr, format, args);
+    va_end(args);
+    return n > 0 ? n : 0;
+  }
+  void flush() { fflush(stderr); }
+
+private:
+  bool enabled_ = true;
+};
+extern HardwareSerial Serial;
+
+/** The cycle counter runs at 80 MHz in simulated time. The heap of the host is not measured. The flash is simulated, see sim_flash.cpp */
+class EspClass {
+public:
+  void restart() { abort(); } // An assert failed, so stop the simulation
+  uint32_t getCycleCount();
+  uint8_t getCpuFreqMHz() { return 80; }
+  uint32_t getFreeHeap() { return 0; }
+  bool flashEraseSector(uint32_t sector);
+  bool flashWrite(uint32_t address, uint32_t *data, size_t size);
+  bool flashRead(uint32_t address, uint32_t *data, size_t size);
+};
+extern EspClass ESP;
+
+#endif // __sim_arduino_h__
@@ -0,0 +1,94 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Replacement for the ESP8266 file system used by the native simulator. The files are stored in a directory on the host
+
+#ifndef __sim_fs_h__
+#define __sim_fs_h__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <memory>
+
+namespace fs {
+
+enum SeekMode {
+  SeekSet = 0,
+  SeekCur = 1,
+  SeekEnd = 2
+};
+
+struct FSInfo {
+  size_t totalBytes;
+  size_t usedBytes;
+  size_t blockSize;
+  size_t pageSize;
+  size_t maxOpenFiles;
+  size_t maxPathLength;
+};
+
+/** Copies share the same handle like on the ESP8266 */
+class File {
+public:
+  File() {}
+  explicit File(FILE *file);
+
+  size_t write(uint8_t c) { return write(&c, 1); }
+  size_t write(const uint8_t *buf, size_t size);
+  size_t read(uint8_t *buf, size_t size);
+  int read();
+  int available();
+  bool seek(uint32_t pos, SeekMode mode = SeekSet);
+  size_t position() const;
+  size_t size() const;
+  void flush();
+  void close();
+  operator bool() const { return handle_ && handle_->file; }
+
+private:
+  struct Handle {
+    FILE *file;
+    ~Handle() { if (file) fclose(file); }
+  };
+  std::shared_ptr<Handle> handle_;
+};
+
+class FS {
+public:
+  bool begin();
+  bool format();
+  bool info(FSInfo &info);
+  File open(const char *path, const char *mode);
+  bool exists(const char *path);
+  bool remove(const char *path);
+  bool rename(const char *from, const char *to);
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+using fs::FSInfo;
+using fs::SeekMode;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
+
+extern fs::FS SPIFFS;
+
+#endif // __sim_fs_h__
@@ -0,0 +1,27 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Replacement for the LittleFS library used by the native simulator. It uses the same directory as SPIFFS
+
+#ifndef __sim_littlefs_h__
+#define __sim_littlefs_h__
+
+#include <FS.h>
+
+extern fs::FS LittleFS;
+
+#endif // __sim_littlefs_h__
@@ -0,0 +1,82 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#ifndef __sim_h__
+#define __sim_h__
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The simulated time only advances by the modelled cost of the hardware: I2C transfers, flash writes, delays and yield().
+// The code itself is assumed to take no time, so a run is deterministic and independent of the speed of the host
+
+#define SIM_I2C_BIT_NS              (2500U) // 400 kHz
+#define SIM_I2C_OVERHEAD_NS         (5000U) // Time spent in the Wire library for every transaction
+#define SIM_I2C_FAST_OVERHEAD_NS    (1500U) // Time spent in the driver of the core for every transaction, see I2C_Init()
+#define SIM_FLASH_WRITE_NS_PER_BYTE (5000U) // Around 200 kB/s including the erase
+#define SIM_FS_INFO_NS              (50000U) // Time spent in SPIFFS.info()
+#define SIM_FLASH_ERASE_NS          (40000000U) // Typical time to erase a 4 kB sector
+#define SIM_FLASH_PROGRAM_NS_PER_BYTE (2700U) // Typical page program time of 0.7 ms per 256 bytes
+#define SIM_YIELD_NS                (10000U) // Time spent by the WiFi stack every time loop() returns
+#define SIM_YIELD_QUIET_NS          (1000U) // Time spent in yield() while the radio is off, see radio_quiet.h
+
+/** I2C bus statistics */
+typedef struct {
+  uint32_t transactions;
+  uint32_t bytes;
+  uint32_t errors; /*!< Transactions to an address without a device or failed by SimI2C_SetErrorInterval() */
+  uint64_t busy_ns; /*!< Time the bus was busy */
+} sim_i2c_stats_t;
+
+/** Sensor readings in physical units */
+typedef struct {
+  float gyro[3]; /*!< Angular rate in deg/s */
+  float acc[3]; /*!< Specific force in g */
+  int32_t pressure; /*!< Pressure in pascal */
+} sim_sample_t;
+
+// Clock
+uint64_t Sim_Time();
+void Sim_Advance(uint64_t ns);
+void Sim_SetRadio(bool on);
+
+// I2C bus
+void SimI2C_GetStats(sim_i2c_stats_t *stats);
+void SimI2C_SetErrorInterval(uint32_t interval);
+
+// MPU-6500
+uint8_t SimMpu6500_Write(uint8_t reg, const uint8_t *data, size_t size);
+uint8_t SimMpu6500_Read(uint8_t reg, uint8_t *data, size_t size);
+uint32_t SimMpu6500_GetSampleCount();
+uint32_t SimMpu6500_GetFifoOverflows();
+
+// MS5611
+uint8_t SimMs5611_Write(uint8_t cmd);
+uint8_t SimMs5611_Read(uint8_t cmd, uint8_t *data, size_t size);
+
+// Flight profile
+bool SimProfile_Load(const char *filename);
+void SimProfile_SetLaunch(double time);
+void SimProfile_Get(uint64_t time_ns, sim_sample_t *sample);
+
+// File system
+void SimFs_Init(const char *root, size_t total_bytes);
+
+// Raw flash starting at address 0
+void SimFlash_Init(size_t size);
+
+#endif // __sim_h__
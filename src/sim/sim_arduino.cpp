@@ -0,0 +1,63 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <Arduino.h>
+
+#include "sim.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+
+static uint64_t sim_time_ns = 0;
+static bool sim_radio = true;
+
+uint64_t Sim_Time() {
+  return sim_time_ns;
+}
+
+void Sim_Advance(uint64_t ns) {
+  sim_time_ns += ns;
+}
+
+// The WiFi stack only takes time in yield() while the radio is on
+void Sim_SetRadio(bool on) {
+  sim_radio = on;
+}
+
+uint32_t micros() {
+  return (uint32_t)(sim_time_ns / 1000U);
+}
+
+uint32_t EspClass::getCycleCount() {
+  return (uint32_t)(sim_time_ns * getCpuFreqMHz() / 1000U);
+}
+
+uint32_t millis() {
+  return (uint32_t)(sim_time_ns / 1000000U);
+}
+
+void delay(uint32_t ms) {
+  Sim_Advance((uint64_t)ms * 1000000U);
+}
+
+void delayMicroseconds(uint32_t us) {
+  Sim_Advance((uint64_t)us * 1000U);
+}
+
+void yield() {
+  Sim_Advance(sim_radio ? SIM_YIELD_NS : SIM_YIELD_QUIET_NS);
+}
@@ -0,0 +1,56 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Simulates the raw flash access of the ESP8266. Like NOR flash, erasing sets all bits and programming can only clear bits
+
+#include <Arduino.h>
+#include <vector>
+
+#include "sim.h"
+
+#define SIM_FLASH_SECTOR_SIZE       (4096U)
+
+static std::vector<uint8_t> flash;
+
+void SimFlash_Init(size_t size) {
+  flash.assign(size, 0xFF);
+}
+
+bool EspClass::flashEraseSector(uint32_t sector) {
+  if ((uint64_t)(sector + 1) * SIM_FLASH_SECTOR_SIZE > flash.size())
+    return false;
+  Sim_Advance(SIM_FLASH_ERASE_NS);
+  memset(&flash[sector * SIM_FLASH_SECTOR_SIZE], 0xFF, SIM_FLASH_SECTOR_SIZE);
+  return true;
+}
+
+bool EspClass::flashWrite(uint32_t address, uint32_t *data, size_t size) {
+  if (address % 4 != 0 || size % 4 != 0 || (uintptr_t)data % 4 != 0 || address + size > flash.size())
+    return false;
+  Sim_Advance((uint64_t)size * SIM_FLASH_PROGRAM_NS_PER_BYTE);
+  const uint8_t *src = (const uint8_t*)data;
+  for (size_t i = 0; i < size; i++)
+    flash[address + i] &= src[i];
+  return true;
+}
+
+bool EspClass::flashRead(uint32_t address, uint32_t *data, size_t size) {
+  if (address % 4 != 0 || size % 4 != 0 || (uintptr_t)data % 4 != 0 || address + size > flash.size())
+    return false;
+  memcpy(data, &flash[address], size);
+  return true;
+}
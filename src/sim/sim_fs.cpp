@@ -0,0 +1,158 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <dirent.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <FS.h>
+
+#include "sim.h"
+
+fs::FS SPIFFS;
+fs::FS LittleFS; // Both use the same directory
+
+static std::string fs_root = "sim_fs";
+static size_t fs_total_bytes = 3U * 1024U * 1024U;
+
+void SimFs_Init(const char *root, size_t total_bytes) {
+  fs_root = root;
+  fs_total_bytes = total_bytes;
+  mkdir(root, 0755);
+}
+
+static std::string SimFs_Path(const char *path) {
+  return fs_root + (path[0] == '/' ? "" : "/") + path;
+}
+
+namespace fs {
+
+File::File(FILE *file) : handle_(std::make_shared<Handle>()) {
+  handle_->file = file;
+}
+
+size_t File::write(const uint8_t *buf, size_t size) {
+  if (!*this)
+    return 0;
+  Sim_Advance((uint64_t)size * SIM_FLASH_WRITE_NS_PER_BYTE);
+  return fwrite(buf, 1, size, handle_->file);
+}
+
+size_t File::read(uint8_t *buf, size_t size) {
+  return *this ? fread(buf, 1, size, handle_->file) : 0;
+}
+
+int File::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int File::available() {
+  return *this ? (int)(size() - position()) : 0;
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+  static const int whence[] = { SEEK_SET, SEEK_CUR, SEEK_END };
+  return *this && fseek(handle_->file, pos, whence[mode]) == 0;
+}
+
+size_t File::position() const {
+  return *this ? ftell(handle_->file) : 0;
+}
+
+size_t File::size() const {
+  struct stat st;
+  return *this && fstat(fileno(handle_->file), &st) == 0 ? st.st_size : 0;
+}
+
+void File::flush() {
+  if (*this)
+    fflush(handle_->file);
+}
+
+void File::close() {
+  if (*this) {
+    fclose(handle_->file);
+    handle_->file = nullptr; // Closes all copies, like on the ESP8266
+  }
+}
+
+bool FS::begin() {
+  mkdir(fs_root.c_str(), 0755);
+  return true;
+}
+
+bool FS::format() {
+  DIR *dir = opendir(fs_root.c_str());
+  if (!dir)
+    return false;
+  struct dirent *entry;
+  while ((entry = readdir(dir)) != nullptr) {
+    if (entry->d_type == DT_REG)
+      unlink((fs_root + "/" + entry->d_name).c_str());
+  }
+  closedir(dir);
+  return true;
+}
+
+bool FS::info(FSInfo &info) {
+  Sim_Advance(SIM_FS_INFO_NS);
+  memset(&info, 0, sizeof(info));
+  info.totalBytes = fs_total_bytes;
+  info.blockSize = 8192;
+  info.pageSize = 256;
+  info.maxOpenFiles = 5;
+  info.maxPathLength = 32;
+
+  DIR *dir = opendir(fs_root.c_str());
+  if (!dir)
+    return false;
+  struct dirent *entry;
+  while ((entry = readdir(dir)) != nullptr) {
+    struct stat st;
+    if (entry->d_type == DT_REG && stat((fs_root + "/" + entry->d_name).c_str(), &st) == 0)
+      info.usedBytes += st.st_size;
+  }
+  closedir(dir);
+  return true;
+}
+
+File FS::open(const char *path, const char *mode) {
+  std::string host_mode = std::string(mode) + "b";
+  if (host_mode == "r+b" || host_mode == "w+b" || host_mode == "a+b" || host_mode == "rb" || host_mode == "wb" || host_mode == "ab") {
+    FILE *file = fopen(SimFs_Path(path).c_str(), host_mode.c_str());
+    if (file)
+      return File(file);
+  }
+  return File();
+}
+
+bool FS::exists(const char *path) {
+  return access(SimFs_Path(path).c_str(), F_OK) == 0;
+}
+
+bool FS::remove(const char *path) {
+  return unlink(SimFs_Path(path).c_str()) == 0;
+}
+
+bool FS::rename(const char *from, const char *to) {
+  return ::rename(SimFs_Path(from).c_str(), SimFs_Path(to).c_str()) == 0;
+}
+
+} // namespace fs
@@ -0,0 +1,110 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Replaces src/i2c.cpp and routes the transactions to the simulated devices
+
+#include <Arduino.h>
+
+#include "i2c.h"
+#include "rocket_assert.h"
+#include "sim.h"
+#include "stats.h"
+
+#define SIM_MPU6500_ADDRESS         0x68
+#define SIM_MS5611_ADDRESS          0x77
+
+static sim_i2c_stats_t i2c_stats;
+static bool i2c_fast;
+static uint32_t error_interval, error_counter;
+
+// Every byte is followed by an acknowledge bit
+static void SimI2C_Transfer(size_t bytes) {
+  uint64_t ns = (uint64_t)(bytes * 9 + 2) * SIM_I2C_BIT_NS + (i2c_fast ? SIM_I2C_FAST_OVERHEAD_NS : SIM_I2C_OVERHEAD_NS); // The start and stop condition takes a bit each
+  i2c_stats.transactions++;
+  i2c_stats.bytes += bytes;
+  i2c_stats.busy_ns += ns;
+  Sim_Advance(ns);
+}
+
+void SimI2C_GetStats(sim_i2c_stats_t *stats) {
+  *stats = i2c_stats;
+}
+
+// Lets every n-th transaction fail as if the device did not acknowledge its address. 0 disables it
+void SimI2C_SetErrorInterval(uint32_t interval) {
+  error_interval = interval;
+  error_counter = 0;
+}
+
+// Returns true if the transaction should fail. Only the address is sent in that case
+static bool SimI2C_InjectError() {
+  if (error_interval == 0 || ++error_counter < error_interval)
+    return false;
+  error_counter = 0;
+  SimI2C_Transfer(1);
+  i2c_stats.errors++;
+  return true;
+}
+
+void I2C_Init(int sda, int scl, bool fast /*= false*/) {
+  (void)sda;
+  (void)scl;
+  i2c_fast = fast;
+  memset(&i2c_stats, 0, sizeof(i2c_stats));
+}
+
+size_t I2C_GetMaxReadSize() {
+  return i2c_fast ? SIZE_MAX : I2C_WIRE_BUFFER_SIZE;
+}
+
+uint8_t I2C_Write(uint8_t addr, uint8_t regAddr, bool sendStop /*= true*/) {
+  return I2C_WriteData(addr, regAddr, nullptr, 0, sendStop);
+}
+
+uint8_t I2C_WriteData(uint8_t addr, uint8_t regAddr, uint8_t data, bool sendStop /*= true*/) {
+  return I2C_WriteData(addr, regAddr, &data, 1, sendStop); // Returns 0 on success
+}
+
+uint8_t I2C_WriteData(uint8_t addr, uint8_t regAddr, uint8_t *data, size_t size, bool sendStop /*= true*/) {
+  (void)sendStop;
+  uint32_t start = Stats_Timestamp();
+  if (SimI2C_InjectError())
+    return Stats_I2C(2, start); // Received NACK on transmit of address
+  SimI2C_Transfer(2 + size); // Address, register and data
+  if (addr == SIM_MPU6500_ADDRESS)
+    return Stats_I2C(SimMpu6500_Write(regAddr, data, size), start);
+  if (addr == SIM_MS5611_ADDRESS && size == 0)
+    return Stats_I2C(SimMs5611_Write(regAddr), start);
+  i2c_stats.errors++;
+  return Stats_I2C(2, start); // Received NACK on transmit of address
+}
+
+uint8_t I2C_ReadData(uint8_t addr, uint8_t regAddr, uint8_t *data, size_t size, bool sendStop /*= false*/) {
+  (void)sendStop;
+  uint32_t start = Stats_Timestamp();
+  if (SimI2C_InjectError())
+    return Stats_I2C(2, start); // Received NACK on transmit of address
+  ROCKET_ASSERT(size <= I2C_GetMaxReadSize());
+  SimI2C_Transfer(2); // Address and register
+  SimI2C_Transfer(1 + size); // Repeated start, address and data
+  if (addr == SIM_MPU6500_ADDRESS)
+    return Stats_I2C(SimMpu6500_Read(regAddr, data, size), start);
+  if (addr == SIM_MS5611_ADDRESS)
+    return Stats_I2C(SimMs5611_Read(regAddr, data, size), start);
+  i2c_stats.errors++;
+  return Stats_I2C(2, start); // Received NACK on transmit of address
+}
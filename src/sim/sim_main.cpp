@@ -0,0 +1,367 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Runs the sampling core against the simulated sensors and reports the achieved sample rate, dropped samples and the time
+// spent in every stage of the loop. Build and run using: pio run -e native && .pio/build/native/program --help
+
+#include <Arduino.h>
+#include <chrono>
+
+#include "flash_log.h"
+#include "flight_index.h"
+#include "i2c.h"
+#include "log_reader.h"
+#include "logger.h"
+#include "radio_quiet.h"
+#include "sim.h"
+#include "stats.h"
+#include "storage.h"
+#include "synthetic_flight.h"
+
+/** Time spent in one stage of the loop */
+typedef struct {
+  const char *name;
+  uint32_t calls;
+  uint64_t sim_ns, sim_max_ns; /*!< Simulated time */
+  uint64_t host_ns; /*!< Time spent on the host */
+} sim_stage_t;
+
+static logger_t logger;
+static flash_log_t flash_log;
+
+// Reads the barometer using the blocking driver, like the loop did before the conversions were polled, so the two can be compared
+static void updateBarometerBlocking(logger_t *logger) {
+  MS5611_GetData(&logger->ms5611);
+}
+
+static void runStage(sim_stage_t *stage, void (*function)(logger_t *logger)) {
+  uint64_t sim_start = Sim_Time();
+  auto host_start = std::chrono::steady_clock::now();
+  if (function)
+    function(&logger);
+  else
+    yield();
+  stage->host_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - host_start).count();
+  uint64_t sim_ns = Sim_Time() - sim_start;
+  stage->sim_ns += sim_ns;
+  if (sim_ns > stage->sim_max_ns)
+    stage->sim_max_ns = sim_ns;
+  stage->calls++;
+}
+
+static void usage(const char *name) {
+  printf("Usage: %s [options]\n", name);
+  printf("  --duration <s>     Simulated time (default: 120)\n");
+  printf("  --start <s>        Time when logging is started (default: 2)\n");
+  printf("  --rate <Hz>        Sample rate (default: %u)\n", MPU6500_MAX_SAMPLE_RATE);
+  printf("  --profile <file>   Play back the samples from a log file instead of a synthetic flight\n");
+  printf("  --launch <s>       Time of the launch of the synthetic flight (default: %.0f)\n", SYNTHETIC_FLIGHT_LAUNCH);
+  printf("  --fs <dir>         Directory used as the file system (default: sim_fs)\n");
+  printf("  --fs-size <bytes>  Size of the file system or raw flash region (default: 3145728)\n");
+  printf("  --flash            Write the log directly to a raw flash region instead of a file\n");
+  printf("  --flights          Store the log as a new flight, so the flights of previous runs are kept until there is no room\n");
+  printf("  --arm              Only log the samples from just before the launch is detected\n");
+  printf("  --adaptive         Let the sample rates follow the flight phase\n");
+  printf("  --auto-range       Let the full-scale ranges of the IMU follow the readings\n");
+  printf("  --radio-quiet      Turn the radio off while logging until the landing is detected\n");
+  printf("  --estimates        Write the output of the estimator to the log\n");
+  printf("  --no-fifo          Poll the data ready flag instead of reading the FIFO\n");
+  printf("  --fast-i2c         Use the I2C driver of the core instead of Wire\n");
+  printf("  --no-baro          Do not read the barometer, see tools/check_baro_rate.py\n");
+  printf("  --blocking-baro    Read the barometer using the blocking MS5611_GetData()\n");
+  printf("  --i2c-errors <n>   Let every n-th I2C transaction fail after the sensors are configured\n");
+  printf("  --stall <ms>       Block the loop this long once every second while logging, so the FIFO overflows\n");
+  printf("  --raw              Store the records uncompressed\n");
+  printf("  --stats            Print the performance counters served on /stats\n");
+  printf("  --verbose          Print the serial output to stderr\n");
+}
+
+int main(int argc, char *argv[]) {
+  double duration = 120, start = 2;
+  uint16_t sample_rate = MPU6500_MAX_SAMPLE_RATE;
+  const char *profile = nullptr, *fs_root = "sim_fs";
+  size_t fs_size = 3U * 1024U * 1024U;
+  uint32_t i2c_error_interval = 0;
+  uint64_t stall_ns = 0;
+  bool fast_i2c = false, use_baro = true, blocking_baro = false, use_fifo = true, compressed = true, raw_flash = false, flights = false, arm = false, adaptive = false, auto_range = false, radio_quiet = false, estimates = false, print_stats = false, verbose = false;
+  for (int i = 1; i < argc; i++) {
+    bool has_value = i + 1 < argc;
+    if (strcmp(argv[i], "--duration") == 0 && has_value)
+      duration = atof(argv[++i]);
+    else if (strcmp(argv[i], "--start") == 0 && has_value)
+      start = atof(argv[++i]);
+    else if (strcmp(argv[i], "--rate") == 0 && has_value) {
+      int rate = atoi(argv[++i]);
+      sample_rate = constrain(rate, (int)MPU6500_MIN_SAMPLE_RATE, (int)MPU6500_MAX_SAMPLE_RATE);
+    }
+    else if (strcmp(argv[i], "--profile") == 0 && has_value)
+      profile = argv[++i];
+    else if (strcmp(argv[i], "--launch") == 0 && has_value)
+      SimProfile_SetLaunch(atof(argv[++i]));
+    else if (strcmp(argv[i], "--fs") == 0 && has_value)
+      fs_root = argv[++i];
+    else if (strcmp(argv[i], "--fs-size") == 0 && has_value)
+      fs_size = strtoul(argv[++i], nullptr, 0);
+    else if (strcmp(argv[i], "--arm") == 0)
+      arm = true;
+    else if (strcmp(argv[i], "--adaptive") == 0)
+      adaptive = true;
+    else if (strcmp(argv[i], "--auto-range") == 0)
+      auto_range = true;
+    else if (strcmp(argv[i], "--radio-quiet") == 0)
+      radio_quiet = true;
+    else if (strcmp(argv[i], "--estimates") == 0)
+      estimates = true;
+    else if (strcmp(argv[i], "--flash") == 0)
+      raw_flash = true;
+    else if (strcmp(argv[i], "--flights") == 0)
+      flights = true;
+    else if (strcmp(argv[i], "--no-fifo") == 0)
+      use_fifo = false;
+    else if (strcmp(argv[i], "--fast-i2c") == 0)
+      fast_i2c = true;
+    else if (strcmp(argv[i], "--no-baro") == 0)
+      use_baro = false;
+    else if (strcmp(argv[i], "--blocking-baro") == 0)
+      blocking_baro = true;
+    else if (strcmp(argv[i], "--i2c-errors") == 0 && has_value)
+      i2c_error_interval = strtoul(argv[++i], nullptr, 0);
+    else if (strcmp(argv[i], "--stall") == 0 && has_value)
+      stall_ns = (uint64_t)(atof(argv[++i]) * 1e6);
+    else if (strcmp(argv[i], "--raw") == 0)
+      compressed = false;
+    else if (strcmp(argv[i], "--stats") == 0)
+      print_stats = true;
+    else if (strcmp(argv[i], "--verbose") == 0)
+      verbose = true;
+    else {
+      usage(argv[0]);
+      return strcmp(argv[i], "--help") == 0 ? 0 : 1;
+    }
+  }
+
+  Serial.setEnabled(verbose);
+  if (profile && !SimProfile_Load(profile)) {
+    fprintf(stderr, "Failed to load the profile: %s\n", profile);
+    return 1;
+  }
+  SimFs_Init(fs_root, fs_size);
+  SimFlash_Init(fs_size);
+  FlashLog_Init(&flash_log, 0, fs_size);
+  static flight_index_t flight_index;
+  char log_filename[FLIGHT_INDEX_PATH_SIZE] = "/log.bin";
+  uint32_t flight_id = 0;
+  if (flights)
+    FlightIndex_Init(&flight_index, FLIGHT_EVICT_OLDEST);
+  else
+    Storage_Remove(log_filename);
+
+  // Same as setup() and loop() in main.cpp, but with every stage measured separately
+  I2C_Init(2, 3, fast_i2c);
+  Logger_Init(&logger, sample_rate, use_fifo);
+  Logger_SetAdaptiveRate(&logger, adaptive);
+  Logger_SetAutoRange(&logger, auto_range);
+  static radio_quiet_t radio;
+  RadioQuiet_Init(&radio, radio_quiet);
+  uint64_t radio_off_ns = 0, radio_on_ns = 0;
+  Logger_SetLogEstimates(&logger, estimates);
+  SimI2C_SetErrorInterval(i2c_error_interval);
+  Stats_Reset();
+  sim_stage_t stages[] = { { "bus", 0, 0, 0, 0 }, { "barometer", 0, 0, 0, 0 }, { "imu", 0, 0, 0, 0 }, { "service", 0, 0, 0, 0 }, { "yield", 0, 0, 0, 0 } };
+  const uint64_t start_ns = (uint64_t)(start * 1e9), stop_ns = (uint64_t)(duration * 1e9);
+  uint32_t sensor_samples = 0, sensor_overflows = 0;
+  uint64_t stall_next_ns = 0;
+  bool started = false, counting = false;
+  while (Sim_Time() < stop_ns) {
+    if (!started && Sim_Time() >= start_ns) {
+      if (raw_flash)
+        Logger_StartFlash(&logger, &flash_log, Logger_GetGroundPressure(&logger), compressed);
+      else {
+        if (flights) {
+          flight_id = FlightIndex_Start(&flight_index, 0, sample_rate);
+          FlightIndex_GetPath(flight_id, log_filename);
+        }
+        Logger_Start(&logger, Storage_Open(log_filename, "w"), Logger_GetGroundPressure(&logger), compressed);
+      }
+      if (arm)
+        Logger_Arm(&logger);
+      started = true;
+    }
+    if (started && !counting && !Logger_IsErasing(&logger)) { // The raw flash region is erased before the samples are logged
+      sensor_samples = SimMpu6500_GetSampleCount();
+      sensor_overflows = SimMpu6500_GetFifoOverflows();
+      counting = true;
+      stall_next_ns = Sim_Time() + 1000000000ULL;
+    }
+    if (stall_ns > 0 && counting && Sim_Time() >= stall_next_ns) {
+      Sim_Advance(stall_ns); // Like the WiFi stack or a slow flash write blocking the loop
+      stall_next_ns += 1000000000ULL;
+    }
+    Stats_Loop();
+    runStage(&stages[0], Logger_UpdateBus);
+    if (use_baro)
+      runStage(&stages[1], blocking_baro ? updateBarometerBlocking : Logger_UpdateBarometer);
+    runStage(&stages[2], Logger_UpdateImu);
+    runStage(&stages[3], Logger_Service);
+    runStage(&stages[4], nullptr);
+    radio_quiet_action_e action = RadioQuiet_Update(&radio, &logger, millis());
+    if (action == RADIO_QUIET_TURN_OFF)
+      radio_off_ns = Sim_Time();
+    else if (action == RADIO_QUIET_TURN_ON)
+      radio_on_ns = Sim_Time();
+    if (action != RADIO_QUIET_NONE)
+      Sim_SetRadio(action == RADIO_QUIET_TURN_ON);
+  }
+  sensor_samples = SimMpu6500_GetSampleCount() - sensor_samples;
+  sensor_overflows = SimMpu6500_GetFifoOverflows() - sensor_overflows;
+  const bool stopped_early = started && !Logger_IsLogging(&logger); // The file system was full or a write failed
+  const uint32_t max_flush_micros = logger.log_writer.max_flush_micros;
+  if (Logger_IsLogging(&logger))
+    Logger_Stop(&logger);
+  if (flights && flight_id != 0)
+    FlightIndex_Close(&flight_index, flight_id, logger.log_writer.written);
+
+  // Read back the log file and check it
+  log_reader_t *log_reader = new log_reader_t;
+  if (!started || !(raw_flash ? LogReader_OpenFlash(log_reader, &flash_log) : LogReader_Open(log_reader, Storage_Open(log_filename, "r")))) {
+    fprintf(stderr, "Failed to open the log file\n");
+    return 1;
+  }
+  uint32_t range_changes = 0, clipped = 0;
+  uint32_t samples = 0, dropped = 0, non_monotonic = 0, first = 0, last = 0, launch = 0, launch_cause = LAUNCH_DETECTOR_NONE;
+  uint32_t phase_samples[FLIGHT_PHASE_COUNT] = {}, phase_start[FLIGHT_PHASE_COUNT] = {}, phase_rate[FLIGHT_PHASE_COUNT] = {}, phase = FLIGHT_PHASE_COUNT;
+  int32_t max_altitude = INT32_MIN, max_velocity = INT32_MIN;
+  uint32_t max_altitude_timestamp = 0;
+  log_record_t record;
+  while (LogReader_Next(log_reader, &record)) {
+    if (record.type == LOG_RECORD_DROPPED)
+      dropped += record.event.arg[0];
+    else if (record.type == LOG_RECORD_ESTIMATE) {
+      if ((int32_t)record.event.arg[0] > max_altitude) {
+        max_altitude = (int32_t)record.event.arg[0];
+        max_altitude_timestamp = record.timestamp;
+      }
+      if ((int32_t)record.event.arg[1] > max_velocity)
+        max_velocity = (int32_t)record.event.arg[1];
+    } else if (record.type == LOG_RECORD_PHASE && record.event.arg[0] < FLIGHT_PHASE_COUNT) {
+      phase = record.event.arg[0];
+      phase_start[phase] = record.timestamp;
+      phase_rate[phase] = record.event.arg[1];
+    }
+    else if (record.type == LOG_RECORD_RANGE)
+      range_changes++;
+    else if (record.type == LOG_RECORD_LAUNCH) {
+      launch = record.timestamp;
+      launch_cause = record.event.arg[0];
+    }
+    else if (record.type == LOG_RECORD_SAMPLE) {
+      if (samples == 0)
+        first = record.timestamp;
+      else if (record.timestamp <= last)
+        non_monotonic++;
+      last = record.timestamp;
+      samples++;
+      for (uint8_t axis = 0; axis < 3; axis++) {
+        const int16_t gyro = record.sample.gyro.data[axis], acc = record.sample.acc.data[axis];
+        if (gyro == INT16_MAX || gyro == INT16_MIN || acc == INT16_MAX || acc == INT16_MIN) {
+          clipped++; // The reading was saturated
+          break;
+        }
+      }
+      if (phase < FLIGHT_PHASE_COUNT)
+        phase_samples[phase]++;
+    }
+  }
+  const bool corrupted = log_reader->error || log_reader->corrupted_blocks > 0;
+  const uint32_t corrupted_blocks = log_reader->corrupted_blocks;
+  const size_t file_size = raw_flash ? FlashLog_GetLength(&flash_log) : log_reader->file.size();
+  LogReader_Close(log_reader);
+  delete log_reader;
+
+  sim_i2c_stats_t i2c_stats;
+  SimI2C_GetStats(&i2c_stats);
+  const double log_start = counting ? logger.start_timestamp * 1e-6 : start; // The records are timed from when the samples are logged
+  printf("Simulated %.1f s, logging from %.1f s at %u Hz (%s, %s, %s, %s)\n", duration, log_start, sample_rate,
+    use_fifo ? "FIFO" : "polling", fast_i2c ? "fast I2C" : "Wire", compressed ? "compressed" : "raw", raw_flash ? "raw flash" : Storage_GetName());
+  if (profile)
+    printf("Profile:             %s\n", profile);
+  if (flights) {
+    char json[FLIGHT_INDEX_JSON_SIZE];
+    FlightIndex_FormatJson(&flight_index, json, sizeof(json));
+    printf("Flight:              %u (%s)\n", flight_id, log_filename);
+    printf("Flights:             %s\n", json);
+  }
+  if (raw_flash)
+    printf("Flash erased:        %.1f s before the samples were logged\n", log_start - start);
+  if (stopped_early)
+    printf("Logging stopped early, see --verbose\n");
+  if (launch_cause != LAUNCH_DETECTOR_NONE) {
+    printf("Launch detected:     %.3f s by the %s, log starts at %.3f s\n", log_start + launch * 1e-6,
+      launch_cause == LAUNCH_DETECTOR_ACC ? "acceleration" : "altitude", log_start + first * 1e-6);
+  } else if (arm)
+    printf("Launch detected:     no\n");
+  for (uint32_t i = 0; i < FLIGHT_PHASE_COUNT; i++) {
+    if (phase_rate[i] > 0) {
+      char name[16];
+      snprintf(name, sizeof(name), "%s:", LogFormat_GetPhaseName(i));
+      printf("Phase %-14s%.3f s, %u Hz, %u samples\n", name, log_start + phase_start[i] * 1e-6, phase_rate[i], phase_samples[i]);
+    }
+  }
+  if (max_altitude != INT32_MIN) {
+    printf("Estimated apogee:    %.3f m at %.3f s, max velocity %.3f m/s\n", max_altitude / 1000.0, log_start + max_altitude_timestamp * 1e-6,
+      max_velocity / 1000.0);
+  }
+  printf("Sensor samples:      %u\n", sensor_samples);
+  printf("Logged samples:      %u\n", samples);
+  printf("Dropped samples:     %u (FIFO overflows: %u)\n", dropped, sensor_overflows);
+  printf("Achieved rate:       %.1f Hz\n", samples > 1 ? (samples - 1) / ((last - first) * 1e-6) : 0.0);
+  printf("Non-monotonic:       %u\n", non_monotonic);
+  printf("Range changes:       %u, %u samples clipped\n", range_changes, clipped);
+  if (radio_quiet && radio_off_ns == 0)
+    printf("Radio:               stayed on\n");
+  else if (radio_quiet && radio_on_ns == 0)
+    printf("Radio:               off at %.3f s\n", radio_off_ns * 1e-9);
+  else if (radio_quiet)
+    printf("Radio:               off at %.3f s, on at %.3f s\n", radio_off_ns * 1e-9, radio_on_ns * 1e-9);
+  printf("Log file:            %zu bytes (%.2f bytes per sample)%s\n", file_size, samples ? (double)file_size / samples : 0.0,
+    corrupted ? ", corrupted" : "");
+  if (corrupted_blocks > 0)
+    printf("Corrupted blocks:    %u skipped\n", corrupted_blocks);
+  printf("Worst case flush:    %u us\n", max_flush_micros);
+  printf("Sample latency:      mean %u us, max %u us\n", Stats_GetMeanMicros(&stats.latency), Stats_GetMaxMicros(&stats.latency));
+  printf("High-water:          queue %u of %u records, FIFO %u of %u samples\n", stats.queue_high_water, RECORD_QUEUE_SIZE - 1,
+    stats.fifo_high_water, MPU6500_FIFO_SIZE / MPU6500_FIFO_SAMPLE_SIZE);
+  printf("I2C:                 %u transactions, %u bytes, %u errors, bus busy %.1f %%\n", i2c_stats.transactions,
+    i2c_stats.bytes, i2c_stats.errors, 100.0 * i2c_stats.busy_ns / Sim_Time());
+  printf("I2C while logging:   %.1f %% busy, %u transactions/s, %u retries, %u deferred, %u missed deadlines\n",
+    Stats_GetI2CUtilisation() / 10.0, Stats_GetI2CRate(), stats.i2c_retries, stats.i2c_deferred, stats.i2c_missed_deadlines);
+  printf("\n%-10s %10s %14s %14s %14s\n", "Stage", "Calls", "Sim avg (us)", "Sim max (us)", "Host avg (ns)");
+  for (const sim_stage_t &stage : stages) {
+    if (stage.calls == 0)
+      continue; // The barometer is not read when using --no-baro
+    printf("%-10s %10u %14.2f %14.1f %14.1f\n", stage.name, stage.calls, stage.sim_ns * 1e-3 / stage.calls,
+      stage.sim_max_ns * 1e-3, (double)stage.host_ns / stage.calls);
+  }
+  if (print_stats) {
+    char json[STATS_JSON_SIZE];
+    stats_samples_t stats_samples;
+    Logger_GetSamples(&logger, &stats_samples);
+    Stats_FormatJson(json, sizeof(json), &stats_samples);
+    printf("\n%s\n", json);
+  }
+  return corrupted || non_monotonic > 0 ? 2 : 0;
+}
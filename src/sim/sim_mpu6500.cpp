@@ -0,0 +1,184 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Register level model of the MPU-6500. Only the registers used by the driver are modelled:
+// reset, sleep, sample rate divider, full scale ranges, data ready, data registers and the FIFO
+
+#include <Arduino.h>
+
+#include "mpu6500.h"
+#include "sim.h"
+
+#define SIM_MPU6500_CLOCK_ERROR_PPM (500) // The internal oscillator runs slightly fast
+
+#define SIM_MPU6500_SMPLRT_DIV      0x19
+#define SIM_MPU6500_CONFIG          0x1A
+#define SIM_MPU6500_GYRO_CONFIG     0x1B
+#define SIM_MPU6500_ACCEL_CONFIG    0x1C
+#define SIM_MPU6500_FIFO_EN         0x23
+#define SIM_MPU6500_INT_STATUS      0x3A
+#define SIM_MPU6500_ACCEL_XOUT_H    0x3B
+#define SIM_MPU6500_TEMP_OUT_H      0x41
+#define SIM_MPU6500_GYRO_XOUT_H     0x43
+#define SIM_MPU6500_USER_CTRL       0x6A
+#define SIM_MPU6500_PWR_MGMT_1      0x6B
+#define SIM_MPU6500_FIFO_COUNTH     0x72
+#define SIM_MPU6500_FIFO_COUNTL     0x73
+#define SIM_MPU6500_FIFO_R_W        0x74
+#define SIM_MPU6500_WHO_AM_I        0x75
+
+static uint8_t regs[128];
+static uint8_t fifo[MPU6500_FIFO_SIZE];
+static uint16_t fifo_head, fifo_count; // The oldest byte and the number of bytes in the FIFO
+static uint64_t next_sample_ns;
+static uint32_t sample_count, fifo_overflows;
+static bool powered_on = false;
+
+static void SimMpu6500_Reset() {
+  memset(regs, 0, sizeof(regs));
+  regs[SIM_MPU6500_PWR_MGMT_1] = 1U << 6; // Sleep
+  regs[SIM_MPU6500_WHO_AM_I] = 0x70;
+  fifo_head = fifo_count = 0;
+}
+
+static uint64_t SimMpu6500_SamplePeriod() {
+  // The internal sample rate is 1 kHz when the digital low pass filter is enabled
+  return (uint64_t)(regs[SIM_MPU6500_SMPLRT_DIV] + 1) * 1000000000000ULL / (1000000ULL + SIM_MPU6500_CLOCK_ERROR_PPM);
+}
+
+static void SimMpu6500_Put(uint8_t reg, float value, float scale) {
+  float raw = roundf(value * scale);
+  int16_t v = raw > 32767.0f ? 32767 : raw < -32768.0f ? -32768 : (int16_t)raw;
+  regs[reg] = (uint8_t)(v >> 8);
+  regs[reg + 1] = (uint8_t)v;
+}
+
+static void SimMpu6500_FifoPush(uint8_t reg, uint8_t size) {
+  for (uint8_t i = 0; i < size; i++)
+    fifo[(fifo_head + fifo_count++) % MPU6500_FIFO_SIZE] = regs[reg + i];
+}
+
+static void SimMpu6500_Sample(uint64_t time_ns) {
+  sim_sample_t sample;
+  SimProfile_Get(time_ns, &sample);
+  const float gyro_scale = MPU6500_GetGyroScaleFactor((regs[SIM_MPU6500_GYRO_CONFIG] >> 3) & 0x03);
+  const float acc_scale = MPU6500_GetAccScaleFactor((regs[SIM_MPU6500_ACCEL_CONFIG] >> 3) & 0x03);
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    SimMpu6500_Put(SIM_MPU6500_ACCEL_XOUT_H + 2 * axis, sample.acc[axis], acc_scale);
+    SimMpu6500_Put(SIM_MPU6500_GYRO_XOUT_H + 2 * axis, sample.gyro[axis], gyro_scale);
+  }
+  regs[SIM_MPU6500_INT_STATUS] |= 1U << 0; // RAW_DATA_RDY_INT
+  sample_count++;
+
+  // Write the enabled registers into the FIFO in the order of the register addresses
+  if (!(regs[SIM_MPU6500_USER_CTRL] & (1U << 6)))
+    return;
+  const uint8_t fifo_en = regs[SIM_MPU6500_FIFO_EN];
+  uint8_t size = (fifo_en & (1U << 7) ? 2 : 0) + (fifo_en & (1U << 3) ? 6 : 0);
+  for (uint8_t bit = 4; bit <= 6; bit++)
+    size += fifo_en & (1U << bit) ? 2 : 0;
+  if (size == 0)
+    return;
+  if (fifo_count + size > MPU6500_FIFO_SIZE) {
+    regs[SIM_MPU6500_INT_STATUS] |= 1U << 4; // FIFO_OFLOW_INT
+    fifo_overflows++;
+    if (regs[SIM_MPU6500_CONFIG] & (1U << 6))
+      return; // FIFO_MODE: additional writes are not written to the FIFO
+    // Otherwise the oldest data is overwritten
+    uint16_t overwrite = fifo_count + size - MPU6500_FIFO_SIZE;
+    fifo_head = (fifo_head + overwrite) % MPU6500_FIFO_SIZE;
+    fifo_count -= overwrite;
+  }
+  if (fifo_en & (1U << 3))
+    SimMpu6500_FifoPush(SIM_MPU6500_ACCEL_XOUT_H, 6);
+  if (fifo_en & (1U << 7))
+    SimMpu6500_FifoPush(SIM_MPU6500_TEMP_OUT_H, 2);
+  for (uint8_t bit = 6; bit >= 4; bit--) {
+    if (fifo_en & (1U << bit))
+      SimMpu6500_FifoPush(SIM_MPU6500_GYRO_XOUT_H + 2 * (6 - bit), 2);
+  }
+}
+
+// Takes all the samples up to the current time
+static void SimMpu6500_Update() {
+  const uint64_t now = Sim_Time();
+  if (!powered_on) {
+    SimMpu6500_Reset(); // Power on reset
+    powered_on = true;
+  }
+  if (regs[SIM_MPU6500_PWR_MGMT_1] & (1U << 6)) {
+    next_sample_ns = now + SimMpu6500_SamplePeriod(); // The first sample is taken one period after waking up
+    return;
+  }
+  while (next_sample_ns <= now) {
+    SimMpu6500_Sample(next_sample_ns);
+    next_sample_ns += SimMpu6500_SamplePeriod();
+  }
+}
+
+uint8_t SimMpu6500_Write(uint8_t reg, const uint8_t *data, size_t size) {
+  SimMpu6500_Update();
+  for (size_t i = 0; i < size; i++, reg++) {
+    if (reg >= sizeof(regs))
+      return 3; // Received NACK on transmit of data
+    if (reg == SIM_MPU6500_PWR_MGMT_1 && (data[i] & (1U << 7))) {
+      SimMpu6500_Reset(); // The reset bit is cleared right away
+      return 0;
+    }
+    regs[reg] = data[i];
+    if (reg == SIM_MPU6500_USER_CTRL && (data[i] & (1U << 2))) {
+      fifo_head = fifo_count = 0; // FIFO_RST is cleared automatically
+      regs[reg] &= ~(1U << 2);
+    }
+  }
+  return 0;
+}
+
+uint8_t SimMpu6500_Read(uint8_t reg, uint8_t *data, size_t size) {
+  SimMpu6500_Update();
+  for (size_t i = 0; i < size; i++) {
+    if (reg == SIM_MPU6500_FIFO_R_W) { // The address is not incremented, so the FIFO can be read in a single burst
+      if (fifo_count > 0) {
+        data[i] = fifo[fifo_head];
+        fifo_head = (fifo_head + 1) % MPU6500_FIFO_SIZE;
+        fifo_count--;
+      } else
+        data[i] = 0xFF;
+      continue;
+    }
+    if (reg == SIM_MPU6500_FIFO_COUNTH)
+      data[i] = (uint8_t)(fifo_count >> 8);
+    else if (reg == SIM_MPU6500_FIFO_COUNTL)
+      data[i] = (uint8_t)fifo_count;
+    else if (reg < sizeof(regs))
+      data[i] = regs[reg];
+    else
+      data[i] = 0;
+    if (reg == SIM_MPU6500_INT_STATUS)
+      regs[reg] = 0; // The interrupt status is cleared when it is read
+    reg++;
+  }
+  return 0;
+}
+
+uint32_t SimMpu6500_GetSampleCount() {
+  return sample_count;
+}
+
+uint32_t SimMpu6500_GetFifoOverflows() {
+  return fifo_overflows;
+}
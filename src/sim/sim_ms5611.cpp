@@ -0,0 +1,83 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Model of the MS5611 command interface: reset, PROM, conversion timing and the ADC
+
+#include <Arduino.h>
+
+#include "sim.h"
+
+#define SIM_MS5611_CMD_ADC_READ     0x00
+#define SIM_MS5611_CMD_RESET        0x1E
+#define SIM_MS5611_CMD_CONV_D1      0x40
+#define SIM_MS5611_CMD_CONV_D2      0x50
+#define SIM_MS5611_CMD_READ_PROM    0xA0
+
+// Calibration data and temperature reading from the example in the datasheet
+static const uint16_t prom[8] = { 0, 40127, 36924, 23317, 23282, 33464, 28312, 0 };
+static const uint32_t D2 = 8569150; // 20.07 C
+
+static uint8_t conversion_cmd; // Command of the conversion in progress or 0 if idle
+static uint64_t conversion_start_ns;
+
+// Typical conversion time for each oversampling ratio
+static uint32_t SimMs5611_ConversionTime(uint8_t osr) {
+  static const uint32_t conversion_micros[] = { 540, 1060, 2080, 4130, 8220 };
+  return conversion_micros[(osr >> 1) < 5 ? osr >> 1 : 4];
+}
+
+// Inverts the compensation in the datasheet. The temperature is above 20 C, so there is no second order compensation
+static uint32_t SimMs5611_PressureToD1(int32_t pressure) {
+  int64_t dT = (int64_t)D2 - ((int64_t)prom[5] << 8);
+  int64_t OFF = ((int64_t)prom[2] << 16) + (((int64_t)prom[4] * dT) >> 7);
+  int64_t SENS = ((int64_t)prom[1] << 15) + (((int64_t)prom[3] * dT) >> 8);
+  return (uint32_t)(((((int64_t)pressure << 15) + OFF) << 21) / SENS + 1);
+}
+
+uint8_t SimMs5611_Write(uint8_t cmd) {
+  if (cmd == SIM_MS5611_CMD_RESET)
+    conversion_cmd = 0;
+  else if ((cmd & 0xF0) == SIM_MS5611_CMD_CONV_D1 || (cmd & 0xF0) == SIM_MS5611_CMD_CONV_D2) {
+    conversion_cmd = cmd;
+    conversion_start_ns = Sim_Time();
+  }
+  return 0;
+}
+
+uint8_t SimMs5611_Read(uint8_t cmd, uint8_t *data, size_t size) {
+  memset(data, 0, size);
+  if ((cmd & 0xF0) == SIM_MS5611_CMD_READ_PROM && size == 2) {
+    uint16_t value = prom[(cmd >> 1) & 0x07];
+    data[0] = (uint8_t)(value >> 8);
+    data[1] = (uint8_t)value;
+  } else if (cmd == SIM_MS5611_CMD_ADC_READ && size == 3) {
+    // The result is 0 if the conversion is not finished
+    if (conversion_cmd != 0 && Sim_Time() - conversion_start_ns >= SimMs5611_ConversionTime(conversion_cmd & 0x0F) * 1000ULL) {
+      uint32_t adc = D2;
+      if ((conversion_cmd & 0xF0) == SIM_MS5611_CMD_CONV_D1) {
+        sim_sample_t sample;
+        SimProfile_Get(conversion_start_ns, &sample);
+        adc = SimMs5611_PressureToD1(sample.pressure);
+      }
+      data[0] = (uint8_t)(adc >> 16);
+      data[1] = (uint8_t)(adc >> 8);
+      data[2] = (uint8_t)adc;
+    }
+    conversion_cmd = 0;
+  }
+  return 0;
+}
@@ -0,0 +1,108 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Provides the sensor readings for the simulated devices: either a synthetic flight or the samples from a log file
+
+#include <Arduino.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "log_file.h"
+#include "sim.h"
+#include "synthetic_flight.h"
+
+// The devices take their samples when they are accessed, so the samples are kept for a while, as the time they ask
+// for can be earlier than a time already asked for by another device
+#define SIM_PROFILE_STEP_NS         (250000U) // The synthetic flight is generated at 4 kHz
+#define SIM_PROFILE_HISTORY         (1024U) // Number of steps kept i.e. 256 ms
+
+static bool profile_loaded = false;
+static std::vector<log_record_t> profile_records;
+static std::vector<std::pair<float, float>> profile_scale; // Gyroscope and accelerometer scale factor of every sample
+static log_header_t profile_header;
+
+static synthetic_flight_t synthetic_flight;
+static synthetic_sample_t synthetic_history[SIM_PROFILE_HISTORY];
+static uint64_t synthetic_steps = 0; // Number of steps generated
+static double synthetic_launch = SYNTHETIC_FLIGHT_LAUNCH;
+
+// Plays back the samples in a log file instead of the synthetic flight
+bool SimProfile_Load(const char *filename) {
+  std::vector<uint8_t> data;
+  bool corrupted;
+  if (!LogFile_Load(filename, &data) || !LogFile_Parse(data.data(), data.size(), &profile_header, &profile_records, &corrupted))
+    return false;
+  if (profile_header.gyroScaleFactor <= 0 || profile_header.accScaleFactor <= 0)
+    return false;
+
+  // Only the samples are used. The scale factors follow the ranges in the log
+  std::pair<float, float> scale((float)profile_header.gyroScaleFactor, (float)profile_header.accScaleFactor);
+  profile_scale.clear();
+  size_t n = 0;
+  for (size_t i = 0; i < profile_records.size(); i++) {
+    if (profile_records[i].type == LOG_RECORD_RANGE) {
+      const mpu6500_range_t range = LogFormat_GetRange(&profile_records[i]);
+      scale = std::make_pair(MPU6500_GetGyroScaleFactor(range.gyro), MPU6500_GetAccScaleFactor(range.acc));
+    } else if (profile_records[i].type == LOG_RECORD_SAMPLE) {
+      profile_records[n++] = profile_records[i];
+      profile_scale.push_back(scale);
+    }
+  }
+  profile_records.resize(n);
+  profile_loaded = n > 0;
+  return profile_loaded;
+}
+
+// Sets the time of the launch in s of the synthetic flight
+void SimProfile_SetLaunch(double time) {
+  synthetic_launch = time;
+}
+
+// Returns the latest sample at the given time
+void SimProfile_Get(uint64_t time_ns, sim_sample_t *sample) {
+  if (profile_loaded) {
+    const uint32_t timestamp = (uint32_t)(time_ns / 1000U);
+    auto it = std::upper_bound(profile_records.begin(), profile_records.end(), timestamp,
+      [](uint32_t t, const log_record_t &record) { return t < record.timestamp; });
+    const size_t index = it == profile_records.begin() ? 0 : it - profile_records.begin() - 1;
+    const log_record_t *record = &profile_records[index];
+    for (uint8_t axis = 0; axis < 3; axis++) {
+      sample->gyro[axis] = record->sample.gyro.data[axis] / profile_scale[index].first;
+      sample->acc[axis] = record->sample.acc.data[axis] / profile_scale[index].second;
+    }
+    sample->pressure = LogFormat_GetPressure(record);
+    return;
+  }
+
+  if (synthetic_steps == 0) {
+    SyntheticFlight_Init(&synthetic_flight);
+    synthetic_flight.launch = synthetic_launch;
+  }
+  const uint64_t step = time_ns / SIM_PROFILE_STEP_NS;
+  while (synthetic_steps <= step) {
+    SyntheticFlight_Step(&synthetic_flight, synthetic_steps == 0 ? 0 : SIM_PROFILE_STEP_NS * 1e-9, &synthetic_history[synthetic_steps % SIM_PROFILE_HISTORY]);
+    synthetic_steps++;
+  }
+  const uint64_t oldest = synthetic_steps > SIM_PROFILE_HISTORY ? synthetic_steps - SIM_PROFILE_HISTORY : 0;
+  const synthetic_sample_t *synthetic_sample = &synthetic_history[(step < oldest ? oldest : step) % SIM_PROFILE_HISTORY];
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    sample->gyro[axis] = synthetic_sample->gyro[axis];
+    sample->acc[axis] = synthetic_sample->acc[axis];
+  }
+  sample->pressure = (int32_t)lround(synthetic_sample->pressure);
+}
@@ -0,0 +1,121 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <Arduino.h>
+#include <stdarg.h>
+
+#include "stats.h"
+
+#define STATS_HEAP_INTERVAL         (1024U) // The free heap is checked every n loop iterations
+
+stats_t stats;
+
+void Stats_Reset() {
+  memset(&stats, 0, sizeof(stats));
+  stats.loop_timestamp = Stats_Timestamp();
+  stats.min_free_heap = ESP.getFreeHeap();
+  stats.reset_millis = millis();
+}
+
+// Must be called at the start of every iteration of the main loop
+void Stats_Loop() {
+  uint32_t start = stats.loop_timestamp;
+  stats.loop_timestamp = Stats_Timestamp();
+  Stats_Record(&stats.loop, start);
+
+  if (stats.loop.count % STATS_HEAP_INTERVAL == 0) {
+    uint32_t free_heap = ESP.getFreeHeap();
+    if (free_heap < stats.min_free_heap)
+      stats.min_free_heap = free_heap;
+  }
+}
+
+uint32_t Stats_GetMeanMicros(const stats_histogram_t *histogram) {
+  if (histogram->count == 0)
+    return 0;
+  return (uint32_t)(histogram->sum / histogram->count / ESP.getCpuFreqMHz());
+}
+
+uint32_t Stats_GetMaxMicros(const stats_histogram_t *histogram) {
+  return histogram->max / ESP.getCpuFreqMHz();
+}
+
+// Returns the fraction of the time the I2C bus has been busy since the counters were reset in 0.1 %
+uint32_t Stats_GetI2CUtilisation() {
+  uint32_t elapsed = millis() - stats.reset_millis;
+  if (elapsed == 0)
+    return 0;
+  return (uint32_t)(stats.i2c.sum / ESP.getCpuFreqMHz() / elapsed); // The busy time is in us, so this gives 1000 times the fraction
+}
+
+// Returns the number of I2C transactions per second since the counters were reset
+uint32_t Stats_GetI2CRate() {
+  uint32_t elapsed = millis() - stats.reset_millis;
+  if (elapsed == 0)
+    return 0;
+  return (uint32_t)((uint64_t)stats.i2c.count * 1000 / elapsed);
+}
+
+// Appends to the buffer and keeps track of the length. The output is truncated if the buffer is too small
+static void Stats_Append(char *buffer, size_t size, size_t *length, const char *format, ...) __attribute__((format(printf, 4, 5)));
+static void Stats_Append(char *buffer, size_t size, size_t *length, const char *format, ...) {
+  if (*length >= size)
+    return;
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(&buffer[*length], size - *length, format, args);
+  va_end(args);
+  if (n > 0)
+    *length = *length + n < size ? *length + n : size - 1;
+}
+
+static void Stats_AppendHistogram(char *buffer, size_t size, size_t *length, const char *name, const stats_histogram_t *histogram) {
+  Stats_Append(buffer, size, length, "\"%s\":{\"count\":%u,\"mean_us\":%u,\"max_us\":%u,\"buckets\":[", name,
+    histogram->count, Stats_GetMeanMicros(histogram), Stats_GetMaxMicros(histogram));
+  for (uint8_t i = 0; i < STATS_HISTOGRAM_BUCKETS; i++)
+    Stats_Append(buffer, size, length, i ? ",%u" : "%u", histogram->buckets[i]);
+  Stats_Append(buffer, size, length, "]}");
+}
+
+// Formats the counters as a JSON object. Returns the length of the string
+size_t Stats_FormatJson(char *buffer, size_t size, const stats_samples_t *samples) {
+  size_t length = 0;
+  const uint32_t cpu_mhz = ESP.getCpuFreqMHz();
+
+  // The upper limit of every bucket except the last one, which is unbounded
+  Stats_Append(buffer, size, &length, "{\"bucket_limits_us\":[");
+  for (uint8_t i = 0; i < STATS_HISTOGRAM_BUCKETS - 1; i++)
+    Stats_Append(buffer, size, &length, i ? ",%u" : "%u", (uint32_t)(((1UL << (i + STATS_HISTOGRAM_SHIFT)) + cpu_mhz - 1) / cpu_mhz));
+  Stats_Append(buffer, size, &length, "],");
+
+  Stats_AppendHistogram(buffer, size, &length, "loop", &stats.loop);
+  Stats_Append(buffer, size, &length, ",");
+  Stats_AppendHistogram(buffer, size, &length, "i2c", &stats.i2c);
+  Stats_Append(buffer, size, &length, ",\"i2c_errors\":%u,", stats.i2c_errors);
+  Stats_Append(buffer, size, &length, "\"i2c_bus\":{\"utilisation_permille\":%u,\"transactions_per_s\":%u,\"retries\":%u,\"deferred\":%u,\"missed_deadlines\":%u},",
+    Stats_GetI2CUtilisation(), Stats_GetI2CRate(), stats.i2c_retries, stats.i2c_deferred, stats.i2c_missed_deadlines);
+  Stats_AppendHistogram(buffer, size, &length, "flash", &stats.flash);
+  Stats_Append(buffer, size, &length, ",");
+  Stats_AppendHistogram(buffer, size, &length, "estimator", &stats.estimator);
+  Stats_Append(buffer, size, &length, ",");
+  Stats_AppendHistogram(buffer, size, &length, "latency", &stats.latency);
+  Stats_Append(buffer, size, &length, ",\"high_water\":{\"queue\":%u,\"fifo\":%u}", stats.queue_high_water, stats.fifo_high_water);
+  Stats_Append(buffer, size, &length, ",\"samples\":{\"expected\":%u,\"logged\":%u,\"dropped\":%u}",
+    samples->expected, samples->logged, samples->dropped);
+  Stats_Append(buffer, size, &length, ",\"heap\":{\"free\":%u,\"min_free\":%u}}", ESP.getFreeHeap(), stats.min_free_heap);
+  return length;
+}
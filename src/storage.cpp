@@ -0,0 +1,89 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <Arduino.h>
+
+#include "storage.h"
+
+#if STORAGE_BACKEND == STORAGE_LITTLEFS
+#include <LittleFS.h>
+#define STORAGE_FS                  LittleFS
+#define STORAGE_NAME                "LittleFS"
+#define STORAGE_RESERVED_BLOCKS     (2U) // Metadata is copied on write, so a couple of blocks must always be free
+#elif STORAGE_BACKEND == STORAGE_SPIFFS
+#define STORAGE_FS                  SPIFFS
+#define STORAGE_NAME                "SPIFFS"
+#define STORAGE_RESERVED_BLOCKS     (2U) // The garbage collection needs free blocks to move the pages into, so writes fail before it is completely full
+#else
+#error "Unknown STORAGE_BACKEND"
+#endif
+
+bool Storage_Begin() {
+  return STORAGE_FS.begin();
+}
+
+bool Storage_Format() {
+  return STORAGE_FS.format();
+}
+
+File Storage_Open(const char *path, const char *mode) {
+  return STORAGE_FS.open(path, mode);
+}
+
+bool Storage_Exists(const char *path) {
+  return STORAGE_FS.exists(path);
+}
+
+bool Storage_Remove(const char *path) {
+  return STORAGE_FS.remove(path);
+}
+
+bool Storage_Rename(const char *from, const char *to) {
+  return STORAGE_FS.rename(from, to);
+}
+
+// Returns the total size of the file system in bytes
+size_t Storage_GetSize() {
+  FSInfo fs_info;
+  if (!STORAGE_FS.info(fs_info))
+    return 0;
+  return fs_info.totalBytes;
+}
+
+// Returns the number of bytes which can still be written. The used space only counts the data,
+// so the blocks needed by the file system itself are kept free
+size_t Storage_GetFree() {
+  FSInfo fs_info;
+  if (!STORAGE_FS.info(fs_info))
+    return 0;
+  size_t used = fs_info.usedBytes + STORAGE_RESERVED_BLOCKS * fs_info.blockSize;
+  return used < fs_info.totalBytes ? fs_info.totalBytes - used : 0;
+}
+
+// Returns true when there is no longer room for more data
+bool Storage_IsFull() {
+  return Storage_GetFree() == 0;
+}
+
+// Used when the web server sends a file directly
+fs::FS &Storage_GetFS() {
+  return STORAGE_FS;
+}
+
+const char *Storage_GetName() {
+  return STORAGE_NAME;
+}
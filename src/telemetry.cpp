@@ -0,0 +1,113 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+#include <string.h>
+
+#include "telemetry.h"
+
+void Telemetry_Init(telemetry_t *telemetry) {
+  memset(telemetry, 0, sizeof(telemetry_t));
+}
+
+// Sets the rate in Hz the samples are streamed at. The samples are not decimated if it is above the sample rate.
+// Zero disables the stream. This is called by the web server
+void Telemetry_SetRate(telemetry_t *telemetry, uint16_t rate) {
+  if (rate > TELEMETRY_MAX_RATE)
+    rate = TELEMETRY_MAX_RATE;
+  telemetry->interval = rate ? 1000000UL / rate : 0;
+}
+
+static void Telemetry_Publish(telemetry_t *telemetry) {
+  telemetry_frame_t *frame = &telemetry->frames[telemetry->head];
+  uint8_t next = (telemetry->head + 1) % TELEMETRY_FRAMES;
+  if (next == telemetry->tail) {
+    // All the other frames are waiting to be sent, so drop this one and fill it again
+    telemetry->dropped += frame->header.count;
+    telemetry->total_dropped += frame->header.count;
+    frame->header.count = 0;
+    return;
+  }
+
+  frame->header.version = TELEMETRY_VERSION;
+  frame->header.sequence = telemetry->sequence++;
+  frame->header.dropped = telemetry->dropped;
+  frame->header.gyroScaleFactor = telemetry->gyroScaleFactor;
+  frame->header.accScaleFactor = telemetry->accScaleFactor;
+  frame->header.ground_pressure = telemetry->ground_pressure;
+  telemetry->dropped = 0;
+
+  __sync_synchronize(); // The frame must be written before it is handed over
+  telemetry->frames[next].header.count = 0;
+  telemetry->head = next;
+}
+
+// Sets the values copied into the header of every frame. This and Telemetry_Add() are called by the sampling path
+void Telemetry_SetScale(telemetry_t *telemetry, float gyroScaleFactor, float accScaleFactor, int32_t ground_pressure) {
+  // The samples in the frame being filled were taken using the old range, so it is sent first
+  const bool changed = gyroScaleFactor != telemetry->gyroScaleFactor || accScaleFactor != telemetry->accScaleFactor;
+  if (changed && telemetry->frames[telemetry->head].header.count > 0)
+    Telemetry_Publish(telemetry);
+  telemetry->gyroScaleFactor = gyroScaleFactor;
+  telemetry->accScaleFactor = accScaleFactor;
+  telemetry->ground_pressure = ground_pressure;
+}
+
+void Telemetry_Add(telemetry_t *telemetry, uint32_t timestamp, int32_t pressure, const sensorRaw_t *gyro, const sensorRaw_t *acc) {
+  uint32_t interval = telemetry->interval;
+  if (interval == 0)
+    return;
+
+  // Decimate the samples. A bit of jitter is accepted, so every sample is kept when the rates are the same
+  uint32_t early = telemetry->next_timestamp - timestamp; // Wraps around if the sample is overdue
+  if (early > interval / 4 && early <= interval + interval / 4)
+    return;
+  if (early <= interval / 4 || timestamp - telemetry->next_timestamp < interval)
+    telemetry->next_timestamp += interval;
+  else
+    telemetry->next_timestamp = timestamp + interval; // The stream was just enabled or the samples were paused
+
+  telemetry_frame_t *frame = &telemetry->frames[telemetry->head];
+  if (frame->header.count == 0)
+    telemetry->frame_timestamp = timestamp;
+  log_record_t *record = &frame->records[frame->header.count++];
+  record->timestamp = timestamp;
+  record->type = LOG_RECORD_SAMPLE;
+  LogFormat_SetPressure(record, pressure);
+  record->sample.gyro = *gyro;
+  record->sample.acc = *acc;
+  telemetry->samples++;
+
+  // Send the frame when it is full or if the next sample would make it too old
+  if (frame->header.count == TELEMETRY_FRAME_RECORDS || timestamp + interval - telemetry->frame_timestamp >= TELEMETRY_MAX_LATENCY)
+    Telemetry_Publish(telemetry);
+}
+
+// Returns the oldest frame waiting to be sent and its length in bytes or nullptr if there is none.
+// The frame stays valid until Telemetry_Pop() is called. This and Telemetry_Pop() are called by the web server
+const telemetry_frame_t *Telemetry_Peek(const telemetry_t *telemetry, size_t *length) {
+  if (telemetry->tail == telemetry->head)
+    return nullptr;
+  __sync_synchronize(); // Read the frame after the head
+  const telemetry_frame_t *frame = &telemetry->frames[telemetry->tail];
+  *length = sizeof(telemetry_header_t) + frame->header.count * sizeof(log_record_t);
+  return frame;
+}
+
+void Telemetry_Pop(telemetry_t *telemetry) {
+  __sync_synchronize(); // Done reading the frame before it is given back
+  telemetry->tail = (telemetry->tail + 1) % TELEMETRY_FRAMES;
+}
@@ -0,0 +1,93 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Compares the accuracy and speed of the table based altitude conversion against powf.
+// Build: g++ -O2 -std=c++11 -Iinclude tools/bench_altitude.cpp src/altitude.cpp -o bench_altitude
+// Usage: ./bench_altitude [--table]
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "altitude.h"
+
+// The exact altitude in mm
+static double altitude(double pressure) {
+  return 44330.0 * (1.0 - pow(pressure / 101325.0, 1.0 / 5.255)) * 1000.0;
+}
+
+// The previous implementation in single precision
+static float altitudePowf(int32_t pressure) {
+  static const uint32_t p0 = 101325U; // Pressure at sea level
+  return 44330.0f * (1.0f - powf((float)pressure / (float)p0, 1.0f / 5.255f));
+}
+
+// Prints the table used by src/altitude.cpp
+static void printTable() {
+  for (int octave = 9; octave <= 16; octave++) {
+    printf("  // %d - %d Pa\n", 1 << octave, 2 << octave);
+    for (int i = 0; i < 34; i++)
+      printf("%s%ld,%s", i % 9 == 0 ? "  " : " ", lround(altitude((1 << octave) + i * (1 << (octave - 5)))), i % 9 == 8 || i == 33 ? "\n" : "");
+  }
+}
+
+int main(int argc, char *argv[]) {
+  if (argc > 1 && strcmp(argv[1], "--table") == 0) {
+    printTable();
+    return 0;
+  }
+
+  // Check every pressure between 10 and 1200 mbar
+  const int32_t min_pressure = 1000, max_pressure = 120000;
+  double max_error = 0, max_error_powf = 0;
+  int32_t worst = 0, worst_powf = 0;
+  for (int32_t p = min_pressure; p <= max_pressure; p++) {
+    double exact = altitude(p);
+    double error = fabs(Altitude_FromPressure(p) - exact), error_powf = fabs(altitudePowf(p) * 1000.0 - exact);
+    if (error > max_error) {
+      max_error = error;
+      worst = p;
+    }
+    if (error_powf > max_error_powf) {
+      max_error_powf = error_powf;
+      worst_powf = p;
+    }
+  }
+
+  const int iterations = 50;
+  volatile int64_t sum = 0; // Prevent the compiler from removing the loops
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    for (int32_t p = min_pressure; p <= max_pressure; p++)
+      sum += Altitude_FromPressure(p);
+  }
+  double table_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations / (max_pressure - min_pressure + 1);
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    for (int32_t p = min_pressure; p <= max_pressure; p++)
+      sum += (int64_t)altitudePowf(p);
+  }
+  double powf_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations / (max_pressure - min_pressure + 1);
+
+  printf("Pressure range:   %d - %d Pa\n", min_pressure, max_pressure);
+  printf("Table max error:  %.3f mm at %d Pa\n", max_error, worst);
+  printf("powf max error:   %.3f mm at %d Pa\n", max_error_powf, worst_powf);
+  printf("Table (host):     %.1f ns per conversion\n", table_ns);
+  printf("powf (host):      %.1f ns per conversion\n", powf_ns);
+  return 0;
+}
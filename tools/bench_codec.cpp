@@ -0,0 +1,81 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Measures the compression ratio and the encode and decode time per record of the block compression.
+// If no log file is given a synthetic flight is used.
+// Build: g++ -O2 -std=c++11 -Iinclude tools/bench_codec.cpp src/log_codec.cpp -o bench_codec
+// Usage: ./bench_codec [log.bin]
+
+#include <chrono>
+#include <stdio.h>
+
+#include "log_file.h"
+#include "synthetic_flight.h"
+
+int main(int argc, char *argv[]) {
+  log_header_t header;
+  std::vector<log_record_t> records;
+  if (argc > 1) {
+    std::vector<uint8_t> data;
+    bool corrupted;
+    if (!LogFile_Load(argv[1], &data) || !LogFile_Parse(data.data(), data.size(), &header, &records, &corrupted)) {
+      fprintf(stderr, "Failed to read log file: %s\n", argv[1]);
+      return 1;
+    }
+    printf("Log file: %s\n", argv[1]);
+  } else {
+    SyntheticFlight_Generate(&records, &header, 1000, 60.0);
+    printf("Synthetic flight: 60 s at 1000 Hz\n");
+  }
+  if (records.empty()) {
+    fprintf(stderr, "No records\n");
+    return 1;
+  }
+
+  const int iterations = 20;
+  std::vector<uint8_t> encoded;
+  size_t size = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++)
+    size = LogFile_Encode(records, sizeof(header), false, &encoded) - sizeof(header);
+  double encode_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations / records.size();
+
+  // Decode and verify the round trip
+  header.flags = LOG_FLAG_COMPRESSED;
+  std::vector<uint8_t> file = encoded;
+  memcpy(file.data(), &header, sizeof(header));
+  std::vector<log_record_t> decoded;
+  bool corrupted = false;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    decoded.clear();
+    LogFile_Parse(file.data(), file.size(), &header, &decoded, &corrupted);
+  }
+  double decode_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations / records.size();
+  if (corrupted || decoded.size() != records.size() || memcmp(decoded.data(), records.data(), records.size() * sizeof(log_record_t)) != 0) {
+    fprintf(stderr, "Round trip failed\n");
+    return 1;
+  }
+
+  printf("Records:              %zu\n", records.size());
+  printf("Raw size:             %zu bytes (%zu bytes per record)\n", records.size() * sizeof(log_record_t), sizeof(log_record_t));
+  printf("Compressed size:      %zu bytes (%.2f bytes per record)\n", size, (double)size / records.size());
+  printf("Compression ratio:    %.2fx\n", (double)(records.size() * sizeof(log_record_t)) / size);
+  printf("Encode time (host):   %.1f ns per record\n", encode_ns);
+  printf("Decode time (host):   %.1f ns per record\n", decode_ns);
+  return 0;
+}
@@ -0,0 +1,150 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Measures the throughput of the CSV conversion used by the web server, compared to the previous snprintf based version.
+// If no log file is given a synthetic flight is used.
+// Build: g++ -O2 -std=c++11 -Iinclude tools/bench_csv.cpp src/altitude.cpp src/csv_encoder.cpp src/log_codec.cpp -o bench_csv
+// Usage: ./bench_csv [log.bin]
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include "csv_encoder.h"
+#include "log_file.h"
+#include "synthetic_flight.h"
+
+// The altitude calculation previously used by the MS5611 driver
+static float altitudePowf(int32_t pressure) {
+  static const uint32_t p0 = 101325U; // Pressure at sea level
+  return 44330.0f * (1.0f - powf((float)pressure / (float)p0, 1.0f / 5.255f)); // Calculate the absolute altitude
+}
+
+// The previous implementation, which formatted every value using snprintf and calculated the altitude for every row.
+// The altitude is now relative to the ground reference pressure
+static size_t formatPrintf(const log_header_t &header, const log_record_t &record, char *out, size_t size) {
+  const float gyro_scale = 1.0f / header.gyroScaleFactor;
+  const float acc_scale = GRAVITATIONAL_ACCELERATION / header.accScaleFactor;
+  if (record.type == LOG_RECORD_DROPPED)
+    return snprintf(out, size, "# Dropped %u samples before %u\n", record.event.arg[0], record.timestamp);
+  int32_t pressure = LogFormat_GetPressure(&record);
+  return snprintf(out, size, "%u,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+    record.timestamp, pressure, altitudePowf(pressure) - (header.ground_pressure > 0 ? altitudePowf(header.ground_pressure) : 0.0f),
+    record.sample.gyro.X * gyro_scale, record.sample.gyro.Y * gyro_scale, record.sample.gyro.Z * gyro_scale,
+    record.sample.acc.X * acc_scale, record.sample.acc.Y * acc_scale, record.sample.acc.Z * acc_scale);
+}
+
+// Returns the largest difference between two values in the same column in units of the last digit.
+// The difference in altitude is returned separately in mm
+static long compareRows(const char *a, const char *b, long *altitude_diff) {
+  long diff = 0;
+  for (int column = 0; *a && *b; column++) {
+    char *end_a, *end_b;
+    double x = strtod(a, &end_a), y = strtod(b, &end_b);
+    if (end_a == a || end_b == b)
+      return *a == *b ? diff : -1; // Compare comments as text
+    if (column == 2) {
+      long d = labs(lround((x - y) * 1000.0));
+      if (d > *altitude_diff)
+        *altitude_diff = d;
+    } else {
+      long d = labs(lround((x - y) * 10000.0));
+      if (d > diff)
+        diff = d;
+    }
+    a = *end_a ? end_a + 1 : end_a;
+    b = *end_b ? end_b + 1 : end_b;
+  }
+  return diff;
+}
+
+int main(int argc, char *argv[]) {
+  log_header_t header;
+  std::vector<log_record_t> records;
+  if (argc > 1) {
+    std::vector<uint8_t> data;
+    bool corrupted;
+    if (!LogFile_Load(argv[1], &data) || !LogFile_Parse(data.data(), data.size(), &header, &records, &corrupted)) {
+      fprintf(stderr, "Failed to read log file: %s\n", argv[1]);
+      return 1;
+    }
+    printf("Log file: %s\n", argv[1]);
+  } else {
+    SyntheticFlight_Generate(&records, &header, 1000, 60.0);
+    // The barometer is sampled slower than the IMU, so the pressure is repeated in the log
+    for (size_t i = 1; i < records.size(); i++) {
+      if (i % 4)
+        LogFormat_SetPressure(&records[i], LogFormat_GetPressure(&records[i - 1]));
+    }
+    printf("Synthetic flight: 60 s at 1000 Hz\n");
+  }
+  if (records.empty()) {
+    fprintf(stderr, "No records\n");
+    return 1;
+  }
+
+  // Convert all the records into 1460 byte responses i.e. the size of a single TCP segment
+  const size_t response_size = 1460;
+  std::string before, after;
+  std::vector<uint8_t> buffer(response_size);
+  auto start = std::chrono::steady_clock::now();
+  for (const log_record_t &record : records) {
+    char row[CSV_ENCODER_MAX_ROW_SIZE];
+    before.append(row, formatPrintf(header, record, row, sizeof(row)));
+  }
+  double before_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  start = std::chrono::steady_clock::now();
+  csv_encoder_t csv_encoder;
+  CsvEncoder_Init(&csv_encoder, &header);
+  size_t i = 0, len;
+  do {
+    len = CsvEncoder_Flush(&csv_encoder, buffer.data(), buffer.size());
+    while (len < buffer.size() && i < records.size())
+      len += CsvEncoder_Write(&csv_encoder, &records[i++], &buffer[len], buffer.size() - len);
+    after.append((const char*)buffer.data(), len);
+  } while (len > 0);
+  double after_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  // Compare the output. The header is only written by the encoder
+  after.erase(0, after.find('\n') + 1);
+  size_t rows = 0, mismatches = 0;
+  long max_altitude_diff = 0;
+  for (size_t a = 0, b = 0; a < before.size() && b < after.size(); rows++) {
+    size_t end_a = before.find('\n', a), end_b = after.find('\n', b);
+    std::string row_a = before.substr(a, end_a - a), row_b = after.substr(b, end_b - b);
+    if (row_a != row_b) {
+      long diff = compareRows(row_a.c_str(), row_b.c_str(), &max_altitude_diff);
+      if (diff < 0 || diff > 1) {
+        fprintf(stderr, "Rows differ:\n%s\n%s\n", row_a.c_str(), row_b.c_str());
+        return 1;
+      }
+      if (diff > 0)
+        mismatches++;
+    }
+    a = end_a + 1;
+    b = end_b + 1;
+  }
+
+  printf("Rows:                 %zu\n", records.size());
+  printf("snprintf and powf:    %.0f rows/s\n", records.size() / before_s);
+  printf("Fixed-point encoder:  %.0f rows/s (%.1fx)\n", records.size() / after_s, before_s / after_s);
+  printf("Rows differing in the last digit: %zu of %zu\n", mismatches, rows);
+  printf("Largest altitude difference: %ld mm\n", max_altitude_diff);
+  return 0;
+}
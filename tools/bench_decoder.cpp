@@ -0,0 +1,114 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Measures the throughput of log_decoder on a large synthetic log. The synthetic flight is repeated until the log
+// has the given size in MB, both uncompressed and compressed. It is converted into CSV and columns using one thread
+// and all cores. The output of a single thread is compared against the output of all cores first.
+// Build: g++ -O2 -std=c++11 -pthread -Iinclude tools/bench_decoder.cpp src/altitude.cpp src/csv_encoder.cpp src/log_codec.cpp -o bench_decoder
+// Usage: ./bench_decoder [MB]
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "log_convert.h"
+#include "synthetic_flight.h"
+
+// Builds a log file of at least "size" bytes by repeating the records
+static void generate(const log_header_t *header, const std::vector<log_record_t> &records, bool compressed, size_t size, std::vector<uint8_t> *file) {
+  log_header_t file_header = *header;
+  file_header.flags = compressed ? LOG_FLAG_COMPRESSED : 0;
+  std::vector<uint8_t> body;
+  if (compressed) {
+    // The blocks after the first one can be repeated, as they are decoded independently and fill whole buffers
+    LogFile_Encode(records, sizeof(file_header), true, file);
+    memcpy(file->data(), &file_header, sizeof(file_header));
+    body.assign(file->begin() + LOG_CODEC_BLOCK_SIZE, file->end());
+    file->resize(LOG_CODEC_BLOCK_SIZE);
+  } else {
+    body.assign((const uint8_t*)records.data(), (const uint8_t*)(records.data() + records.size()));
+    file->assign((const uint8_t*)&file_header, (const uint8_t*)&file_header + sizeof(file_header));
+  }
+  file->reserve(size + body.size());
+  while (file->size() < size)
+    file->insert(file->end(), body.begin(), body.end());
+}
+
+// Converts the log and returns the output in "out" if it is not NULL
+static bool convert(const std::vector<uint8_t> &file, log_convert_format_e format, unsigned threads, std::string *out, log_convert_result_t *result, double *seconds) {
+  log_convert_t log_convert;
+  if (!LogConvert_Open(&log_convert, file.data(), file.size()))
+    return false;
+  FILE *f = out ? tmpfile() : fopen("/dev/null", "wb");
+  if (!f)
+    return false;
+  auto start = std::chrono::steady_clock::now();
+  bool written = LogConvert_Run(&log_convert, format, threads, f, result) && fflush(f) == 0;
+  *seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if (written && out) {
+    out->resize(result->bytes);
+    rewind(f);
+    written = fread(&(*out)[0], 1, out->size(), f) == out->size();
+  }
+  fclose(f);
+  return written;
+}
+
+int main(int argc, char *argv[]) {
+  const size_t megabytes = argc > 1 ? strtoul(argv[1], nullptr, 10) : 256;
+  const unsigned cores = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+  log_header_t header;
+  std::vector<log_record_t> records;
+  SyntheticFlight_Generate(&records, &header, 1000, 60.0);
+  printf("Synthetic flight: 60 s at 1000 Hz repeated to %zu MB, %u cores\n\n", megabytes, cores);
+
+  // The segments are converted in parallel, so the output must not depend on the number of threads
+  for (bool compressed : { false, true }) {
+    std::vector<uint8_t> file;
+    generate(&header, records, compressed, 8 << 20, &file);
+    for (log_convert_format_e format : { LOG_CONVERT_CSV, LOG_CONVERT_COLUMNAR }) {
+      std::string single, parallel;
+      log_convert_result_t result;
+      double seconds;
+      if (!convert(file, format, 1, &single, &result, &seconds) || !convert(file, format, cores + 1, &parallel, &result, &seconds) || single != parallel) {
+        fprintf(stderr, "The output depends on the number of threads\n");
+        return 1;
+      }
+    }
+  }
+
+  printf("%-12s %-8s %7s %14s %10s %10s\n", "Log", "Output", "Threads", "Records/s", "In MB/s", "Out MB/s");
+  for (bool compressed : { false, true }) {
+    std::vector<uint8_t> file;
+    generate(&header, records, compressed, megabytes << 20, &file);
+    for (log_convert_format_e format : { LOG_CONVERT_CSV, LOG_CONVERT_COLUMNAR }) {
+      for (unsigned threads : { 1U, cores }) {
+        log_convert_result_t result;
+        double seconds;
+        if (!convert(file, format, threads, nullptr, &result, &seconds) || result.corrupted || result.corrupted_blocks) {
+          fprintf(stderr, "Failed to convert the log\n");
+          return 1;
+        }
+        printf("%-12s %-8s %7u %14.0f %10.1f %10.1f\n", compressed ? "compressed" : "raw", format == LOG_CONVERT_CSV ? "CSV" : "columns",
+          threads, result.records / seconds, file.size() / seconds / (1 << 20), result.bytes / seconds / (1 << 20));
+        if (cores == 1)
+          break;
+      }
+    }
+  }
+  return 0;
+}
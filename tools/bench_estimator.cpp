@@ -0,0 +1,212 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Compares the fixed point estimator against the same filter in double precision and measures the time per update.
+// For the synthetic flight the estimates are compared against the true altitude and velocity as well.
+// The exit code is non-zero if the fixed point version deviates more than the tolerances below.
+// Build: g++ -O2 -std=c++11 -Iinclude tools/bench_estimator.cpp src/altitude.cpp src/estimator.cpp src/log_codec.cpp -o bench_estimator
+// Usage: ./bench_estimator [log.bin]
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+#include "estimator.h"
+#include "log_file.h"
+#include "synthetic_flight.h"
+
+#define MAX_ALTITUDE_ERROR          (0.1) // Tolerances in m, m/s and deg compared to double precision
+#define MAX_VELOCITY_ERROR          (0.1)
+#define MAX_TILT_ERROR              (0.5)
+
+/** The estimator in double precision. See src/estimator.cpp for a description of every step */
+typedef struct {
+  double q[4], gyro_bias[3], altitude, velocity;
+  double gyro_k, acc_k, acc_scale_factor, ground_altitude;
+  uint32_t imu_timestamp, baro_timestamp;
+  bool imu_valid, baro_valid;
+} reference_t;
+
+static double altitude(double pressure) {
+  return 44330.0 * (1.0 - pow(pressure / 101325.0, 1.0 / 5.255));
+}
+
+static double timeStep(uint32_t *last, uint32_t timestamp) {
+  uint32_t dt = timestamp - *last;
+  *last = timestamp;
+  return (dt > ESTIMATOR_MAX_DT ? ESTIMATOR_MAX_DT : dt) * 1e-6;
+}
+
+static void Reference_Init(reference_t *r, const log_header_t *header) {
+  memset(r, 0, sizeof(reference_t));
+  r->q[0] = 1;
+  r->gyro_k = DEG_TO_RADf / header->gyroScaleFactor;
+  r->acc_k = 1.0 / header->accScaleFactor;
+  r->ground_altitude = altitude(header->ground_pressure);
+}
+
+static void Reference_UpdateImu(reference_t *r, uint32_t timestamp, const sensorRaw_t *gyro, const sensorRaw_t *acc) {
+  if (!r->imu_valid) {
+    r->imu_timestamp = timestamp;
+    r->imu_valid = true;
+    return;
+  }
+  const double dt = timeStep(&r->imu_timestamp, timestamp);
+  double *q = r->q;
+  const double v[3] = { 2 * (q[1] * q[3] - q[0] * q[2]), 2 * (q[0] * q[1] + q[2] * q[3]), q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3] };
+  double a[3], rate[3];
+  for (int axis = 0; axis < 3; axis++) {
+    a[axis] = acc->data[axis] * r->acc_k;
+    rate[axis] = gyro->data[axis] * r->gyro_k - r->gyro_bias[axis];
+  }
+  const double vertical_acc = ((a[0] * v[0] + a[1] * v[1] + a[2] * v[2]) - 1.0) * GRAVITATIONAL_ACCELERATION;
+
+  double norm = sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+  if (norm >= ESTIMATOR_ACC_MIN && norm <= ESTIMATOR_ACC_MAX) {
+    const double error[3] = { a[1] * v[2] - a[2] * v[1], a[2] * v[0] - a[0] * v[2], a[0] * v[1] - a[1] * v[0] };
+    for (int axis = 0; axis < 3; axis++) {
+      r->gyro_bias[axis] -= error[axis] * ESTIMATOR_ATTITUDE_KI * dt;
+      rate[axis] += error[axis] * ESTIMATOR_ATTITUDE_KP;
+    }
+  }
+
+  const double hx = rate[0] * dt / 2, hy = rate[1] * dt / 2, hz = rate[2] * dt / 2;
+  const double w = q[0], x = q[1], y = q[2], z = q[3];
+  q[0] += -x * hx - y * hy - z * hz;
+  q[1] += w * hx + y * hz - z * hy;
+  q[2] += w * hy - x * hz + z * hx;
+  q[3] += w * hz + x * hy - y * hx;
+  norm = sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+  for (int i = 0; i < 4; i++)
+    q[i] /= norm;
+
+  if (r->baro_valid) {
+    r->velocity += vertical_acc * dt;
+    r->altitude += r->velocity * dt;
+  }
+}
+
+static void Reference_UpdatePressure(reference_t *r, uint32_t timestamp, int32_t pressure) {
+  const double h = altitude(pressure) - r->ground_altitude;
+  if (!r->baro_valid) {
+    r->altitude = h;
+    r->velocity = 0;
+    r->baro_timestamp = timestamp;
+    r->baro_valid = true;
+    return;
+  }
+  const double dt = timeStep(&r->baro_timestamp, timestamp);
+  const double error = h - r->altitude;
+  r->altitude += error * ESTIMATOR_ALTITUDE_GAIN * dt;
+  r->velocity += error * ESTIMATOR_VELOCITY_GAIN * dt;
+}
+
+// Returns the angle between the z-axis of the body and vertical in degrees
+static double tilt(double x, double y) {
+  return acos(fmax(-1.0, fmin(1.0, 1.0 - 2.0 * (x * x + y * y)))) * RAD_TO_DEGf;
+}
+
+int main(int argc, char *argv[]) {
+  log_header_t header;
+  std::vector<log_record_t> records;
+  std::vector<double> true_altitude, true_velocity; // Only known for the synthetic flight
+  if (argc > 1) {
+    std::vector<uint8_t> data;
+    bool corrupted;
+    if (!LogFile_Load(argv[1], &data) || !LogFile_Parse(data.data(), data.size(), &header, &records, &corrupted)) {
+      fprintf(stderr, "Failed to read log file: %s\n", argv[1]);
+      return 1;
+    }
+    printf("Log file: %s\n", argv[1]);
+  } else {
+    const uint16_t sample_rate = 1000;
+    const double duration = 60.0;
+    synthetic_flight_t flight;
+    SyntheticFlight_Init(&flight);
+    SyntheticFlight_Header(&header, sample_rate);
+    records.resize((size_t)(duration * sample_rate));
+    for (log_record_t &record : records) {
+      synthetic_sample_t sample;
+      SyntheticFlight_Step(&flight, 1.0 / sample_rate, &sample);
+      SyntheticFlight_ToRecord(&header, flight.time, &sample, &record);
+      true_altitude.push_back(flight.altitude);
+      true_velocity.push_back(flight.velocity);
+    }
+    printf("Synthetic flight: %.0f s at %u Hz\n", duration, sample_rate);
+  }
+
+  estimator_t estimator;
+  reference_t reference;
+  Estimator_Init(&estimator, header.gyroScaleFactor, header.accScaleFactor, header.ground_pressure);
+  Reference_Init(&reference, &header);
+
+  // The pressure is stored with every sample, so a new barometer reading is assumed whenever it changes
+  double max_altitude_error = 0, max_velocity_error = 0, max_tilt_error = 0, max_true_altitude_error = 0, max_true_velocity_error = 0;
+  double fixed_ns = 0, reference_ns = 0;
+  int32_t last_pressure = -1;
+  size_t samples = 0;
+  for (size_t i = 0; i < records.size(); i++) {
+    const log_record_t &record = records[i];
+    if (record.type != LOG_RECORD_SAMPLE)
+      continue;
+    const sensorRaw_t gyro = record.sample.gyro, acc = record.sample.acc;
+    const int32_t pressure = LogFormat_GetPressure(&record);
+    if (pressure != last_pressure) {
+      last_pressure = pressure;
+      Estimator_UpdatePressure(&estimator, record.timestamp, pressure);
+      Reference_UpdatePressure(&reference, record.timestamp, pressure);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Estimator_UpdateImu(&estimator, record.timestamp, &gyro, &acc);
+    auto middle = std::chrono::steady_clock::now();
+    Reference_UpdateImu(&reference, record.timestamp, &gyro, &acc);
+    auto end = std::chrono::steady_clock::now();
+    fixed_ns += std::chrono::duration<double, std::nano>(middle - start).count();
+    reference_ns += std::chrono::duration<double, std::nano>(end - middle).count();
+    samples++;
+
+    const double h = Estimator_GetAltitude(&estimator) / 1000.0, v = Estimator_GetVelocity(&estimator) / 1000.0;
+    max_altitude_error = fmax(max_altitude_error, fabs(h - reference.altitude));
+    max_velocity_error = fmax(max_velocity_error, fabs(v - reference.velocity));
+    max_tilt_error = fmax(max_tilt_error, fabs(tilt(estimator.q[1] / 1073741824.0, estimator.q[2] / 1073741824.0) - tilt(reference.q[1], reference.q[2])));
+    if (!true_altitude.empty()) {
+      max_true_altitude_error = fmax(max_true_altitude_error, fabs(h - true_altitude[i]));
+      max_true_velocity_error = fmax(max_true_velocity_error, fabs(v - true_velocity[i]));
+    }
+  }
+  if (samples == 0) {
+    fprintf(stderr, "No samples\n");
+    return 1;
+  }
+
+  printf("Samples:             %zu\n", samples);
+  printf("Fixed point:         %.1f ns per sample\n", fixed_ns / samples);
+  printf("Double precision:    %.1f ns per sample\n", reference_ns / samples);
+  printf("Max altitude error:  %.4f m\n", max_altitude_error);
+  printf("Max velocity error:  %.4f m/s\n", max_velocity_error);
+  printf("Max tilt error:      %.4f deg\n", max_tilt_error);
+  if (!true_altitude.empty()) {
+    printf("Compared to the true flight:\n");
+    printf("Max altitude error:  %.3f m\n", max_true_altitude_error);
+    printf("Max velocity error:  %.3f m/s\n", max_true_velocity_error);
+  }
+
+  bool passed = max_altitude_error <= MAX_ALTITUDE_ERROR && max_velocity_error <= MAX_VELOCITY_ERROR && max_tilt_error <= MAX_TILT_ERROR;
+  printf("%s\n", passed ? "Passed" : "Failed");
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Measures the per-sample cost of converting the raw MPU-6500 readings into SI units using the previous division by
+// the scale factors, the multiplication by the resolution of the current range and a resolution known at compile time.
+// The cost of the auto-ranging, which runs for every sample when it is enabled, is measured as well.
+// Note that the ESP8266 has no FPU, so there the difference between a division and a multiplication is larger
+// Build: g++ -O2 -std=c++11 -Iinclude tools/bench_imu.cpp src/auto_range.cpp src/log_codec.cpp -o bench_imu
+// Usage: ./bench_imu [log.bin]
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+#include "auto_range.h"
+#include "log_file.h"
+#include "synthetic_flight.h"
+
+#define ITERATIONS                  (20U)
+#define OUTPUT_SAMPLES              (1024U) // The outputs are stored in a small buffer, so the time is not spent waiting on the memory
+
+// The previous implementation dividing by the scale factors
+static void convertDivide(mpu6500_t *mpu6500) {
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    mpu6500->accSi.data[axis] = (float)mpu6500->accRaw.data[axis] / mpu6500->accScaleFactor * GRAVITATIONAL_ACCELERATION;
+    mpu6500->gyroRate.data[axis] = (float)mpu6500->gyroRaw.data[axis] / mpu6500->gyroScaleFactor * DEG_TO_RADf;
+  }
+}
+
+// The ranges are fixed at compile time, so the resolutions are constants
+static void convertConstant(mpu6500_t *mpu6500) {
+  static constexpr float acc_resolution = MPU6500_GetAccResolution(MPU6500_ACC_RANGE);
+  static constexpr float gyro_resolution = MPU6500_GetGyroResolution(MPU6500_GYRO_RANGE);
+  for (uint8_t axis = 0; axis < 3; axis++) {
+    mpu6500->accSi.data[axis] = (float)mpu6500->accRaw.data[axis] * acc_resolution;
+    mpu6500->gyroRate.data[axis] = (float)mpu6500->gyroRaw.data[axis] * gyro_resolution;
+  }
+}
+
+// Converts all the samples and returns the time per sample in ns. The sum of the outputs is returned in "sum"
+template <typename F>
+static double run(const std::vector<log_record_t> &samples, F convert, double *sum) {
+  float out[OUTPUT_SAMPLES][6];
+  mpu6500_t mpu6500;
+  memset(&mpu6500, 0, sizeof(mpu6500));
+  mpu6500.gyroScaleFactor = MPU6500_GetGyroScaleFactor(MPU6500_GYRO_RANGE);
+  mpu6500.accScaleFactor = MPU6500_GetAccScaleFactor(MPU6500_ACC_RANGE);
+  mpu6500.gyroResolution = MPU6500_GetGyroResolution(MPU6500_GYRO_RANGE);
+  mpu6500.accResolution = MPU6500_GetAccResolution(MPU6500_ACC_RANGE);
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < ITERATIONS; i++) {
+    for (size_t j = 0; j < samples.size(); j++) {
+      mpu6500.gyroRaw = samples[j].sample.gyro;
+      mpu6500.accRaw = samples[j].sample.acc;
+      convert(&mpu6500);
+      float *p = out[j % OUTPUT_SAMPLES]; // Stored, so the conversions do not depend on each other
+      memcpy(p, mpu6500.gyroRate.data, sizeof(mpu6500.gyroRate.data));
+      memcpy(p + 3, mpu6500.accSi.data, sizeof(mpu6500.accSi.data));
+    }
+  }
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  *sum = 0;
+  for (uint32_t j = 0; j < OUTPUT_SAMPLES; j++) {
+    for (uint8_t axis = 0; axis < 6; axis++)
+      *sum += out[j][axis];
+  }
+  return ns / ITERATIONS / samples.size();
+}
+
+int main(int argc, char *argv[]) {
+  log_header_t header;
+  std::vector<log_record_t> records;
+  if (argc > 1) {
+    std::vector<uint8_t> data;
+    bool corrupted;
+    if (!LogFile_Load(argv[1], &data) || !LogFile_Parse(data.data(), data.size(), &header, &records, &corrupted)) {
+      fprintf(stderr, "Failed to read log file: %s\n", argv[1]);
+      return 1;
+    }
+    printf("Log file: %s\n", argv[1]);
+  } else {
+    SyntheticFlight_Generate(&records, &header, 1000, 120.0);
+    printf("Synthetic flight: 120 s at 1000 Hz\n");
+  }
+
+  // Only the samples are converted
+  std::vector<log_record_t> samples;
+  for (const log_record_t &record : records) {
+    if (record.type == LOG_RECORD_SAMPLE)
+      samples.push_back(record);
+  }
+  if (samples.empty()) {
+    fprintf(stderr, "No samples\n");
+    return 1;
+  }
+
+  // The results differ by the rounding of the division and the multiplication
+  mpu6500_t a, b;
+  memset(&a, 0, sizeof(a));
+  a.gyroScaleFactor = MPU6500_GetGyroScaleFactor(MPU6500_GYRO_RANGE);
+  a.accScaleFactor = MPU6500_GetAccScaleFactor(MPU6500_ACC_RANGE);
+  a.gyroResolution = MPU6500_GetGyroResolution(MPU6500_GYRO_RANGE);
+  a.accResolution = MPU6500_GetAccResolution(MPU6500_ACC_RANGE);
+  double max_error = 0;
+  for (const log_record_t &record : samples) {
+    a.gyroRaw = record.sample.gyro;
+    a.accRaw = record.sample.acc;
+    b = a;
+    convertDivide(&a);
+    MPU6500_ConvertData(&b);
+    for (uint8_t axis = 0; axis < 3; axis++) {
+      double error = fabs(a.gyroRate.data[axis] - b.gyroRate.data[axis]) / MPU6500_GetGyroResolution(MPU6500_GYRO_RANGE);
+      error = fmax(error, fabs(a.accSi.data[axis] - b.accSi.data[axis]) / MPU6500_GetAccResolution(MPU6500_ACC_RANGE));
+      max_error = fmax(max_error, error);
+    }
+  }
+
+  double sum_divide, sum_multiply, sum_constant;
+  // Lambdas have different types, so every conversion is inlined into its own loop
+  const double divide_ns = run(samples, [](mpu6500_t *mpu6500) { convertDivide(mpu6500); }, &sum_divide);
+  const double multiply_ns = run(samples, [](mpu6500_t *mpu6500) { MPU6500_ConvertData(mpu6500); }, &sum_multiply);
+  const double constant_ns = run(samples, [](mpu6500_t *mpu6500) { convertConstant(mpu6500); }, &sum_constant);
+
+  // The auto-ranging compares the raw readings against the thresholds. The time is measured on the readings as they are
+  const mpu6500_range_t config_range = { MPU6500_GYRO_RANGE, MPU6500_ACC_RANGE };
+  auto_range_t auto_range;
+  uint32_t changes = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < ITERATIONS; i++) {
+    AutoRange_Init(&auto_range, &config_range, samples[0].timestamp);
+    for (const log_record_t &record : samples) {
+      const sensorRaw_t gyro = record.sample.gyro, acc = record.sample.acc;
+      changes += AutoRange_Update(&auto_range, record.timestamp, &config_range, &gyro, &acc);
+    }
+  }
+  const double auto_range_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / ITERATIONS / samples.size();
+
+  // Then the readings are taken again using the ranges chosen, as the sensor would, to count the changes
+  mpu6500_range_t range = config_range;
+  AutoRange_Init(&auto_range, &range, samples[0].timestamp);
+  changes = 0;
+  for (const log_record_t &record : samples) {
+    sensorRaw_t gyro, acc;
+    for (uint8_t axis = 0; axis < 3; axis++) {
+      const float g = record.sample.gyro.data[axis] / header.gyroScaleFactor * MPU6500_GetGyroScaleFactor(range.gyro);
+      const float a = record.sample.acc.data[axis] / header.accScaleFactor * MPU6500_GetAccScaleFactor(range.acc);
+      gyro.data[axis] = (int16_t)fmaxf(-32768.0f, fminf(32767.0f, roundf(g)));
+      acc.data[axis] = (int16_t)fmaxf(-32768.0f, fminf(32767.0f, roundf(a)));
+    }
+    if (AutoRange_Update(&auto_range, record.timestamp, &range, &gyro, &acc)) {
+      range = auto_range.range;
+      changes++;
+    }
+  }
+
+  printf("Samples:             %zu (+-%u deg/s, +-%u g)\n", samples.size(), MPU6500_GetGyroFullScale(MPU6500_GYRO_RANGE), MPU6500_GetAccFullScale(MPU6500_ACC_RANGE));
+  printf("Max difference:      %.2e LSB\n", max_error);
+  printf("Division (host):     %.2f ns per sample\n", divide_ns);
+  printf("Resolution (host):   %.2f ns per sample\n", multiply_ns);
+  printf("Constant (host):     %.2f ns per sample\n", constant_ns);
+  printf("Auto-range (host):   %.2f ns per sample, %u changes\n", auto_range_ns, changes);
+  return fabs(sum_divide - sum_multiply) > 1e-3 * fabs(sum_divide) + 1 ? 1 : 0;
+}
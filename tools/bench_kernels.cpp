@@ -0,0 +1,96 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Measures the time per operation of the kernels of the data path, see src/bench/bench_kernels.h.
+// The result is written as CSV, so it can be compared between commits: save the output of one build and give it
+// using -b to another build, which then adds the baseline and the change in percent to every kernel.
+// The same kernels are measured on the device in cycles by the bench_kernels environment.
+// Build: g++ -O2 -std=c++11 -Iinclude tools/bench_kernels.cpp src/altitude.cpp src/csv_encoder.cpp src/estimator.cpp src/log_codec.cpp -o bench_kernels
+// Usage: ./bench_kernels [-b baseline.csv] > results.csv
+
+#include <chrono>
+#include <map>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#include "../src/bench/bench_kernels.h"
+
+#define BENCH_MIN_NANOS             (20000000ULL) // Every run takes at least 20 ms
+#define BENCH_RUNS                  (5U) // The fastest run is used
+
+static volatile uint32_t bench_sink; // Keeps the checksums, so the kernels are not optimised away
+
+static uint64_t runKernel(const bench_kernel_t *kernel, uint32_t ops) {
+  auto start = std::chrono::steady_clock::now();
+  bench_sink = bench_sink + kernel->run(ops);
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Reads the "kernel,ops,ns_per_op" rows written by a previous run
+static bool loadBaseline(const char *path, std::map<std::string, double> *baseline) {
+  FILE *f = fopen(path, "r");
+  if (!f)
+    return false;
+  char line[128], name[64];
+  unsigned ops;
+  double ns;
+  while (fgets(line, sizeof(line), f)) {
+    if (sscanf(line, "%63[^,],%u,%lf", name, &ops, &ns) == 3)
+      (*baseline)[name] = ns;
+  }
+  fclose(f);
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  std::map<std::string, double> baseline;
+  if (argc == 3 && strcmp(argv[1], "-b") == 0) {
+    if (!loadBaseline(argv[2], &baseline)) {
+      fprintf(stderr, "Failed to open: %s\n", argv[2]);
+      return 1;
+    }
+  } else if (argc != 1) {
+    fprintf(stderr, "Usage: %s [-b baseline.csv]\n", argv[0]);
+    return 1;
+  }
+
+  BenchKernels_Init();
+  printf(baseline.empty() ? "kernel,ops,ns_per_op\n" : "kernel,ops,ns_per_op,baseline_ns_per_op,change_percent\n");
+  for (const bench_kernel_t &kernel : bench_kernels) {
+    // Find the number of operations which takes long enough to time
+    uint32_t ops = 1024;
+    while (runKernel(&kernel, ops) < BENCH_MIN_NANOS && ops < (1UL << 30))
+      ops *= 2;
+
+    uint64_t best = UINT64_MAX;
+    for (uint8_t run = 0; run < BENCH_RUNS; run++) {
+      uint64_t nanos = runKernel(&kernel, ops);
+      if (nanos < best)
+        best = nanos;
+    }
+    const double ns = (double)best / ops;
+    printf("%s,%u,%.3f", kernel.name, ops, ns);
+    auto it = baseline.find(kernel.name);
+    if (it != baseline.end())
+      printf(",%.3f,%+.1f", it->second, (ns / it->second - 1.0) * 100.0);
+    else if (!baseline.empty())
+      printf(",,");
+    printf("\n");
+  }
+  return 0;
+}
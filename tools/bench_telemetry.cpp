@@ -0,0 +1,146 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Measures the cost of the telemetry stream in the sampling path and how it behaves when the client is slow.
+// The samples are streamed at a range of rates to a client which keeps up and to one behind a slow link, which
+// can only send one frame at a time. Every sample must either be delivered or be reported as dropped.
+// The exit code is non-zero if samples are lost without being reported or if the fast client drops any samples
+// Build: g++ -O2 -std=c++11 -Iinclude tools/bench_telemetry.cpp src/log_codec.cpp src/telemetry.cpp -o bench_telemetry
+// Usage: ./bench_telemetry [log.bin]
+
+#include <chrono>
+#include <stdio.h>
+
+#include "log_file.h"
+#include "synthetic_flight.h"
+#include "telemetry.h"
+
+#define SLOW_LINK_RATE              (4000U) // Bytes per second the slow client can receive
+
+/** Result of streaming all the samples */
+typedef struct {
+  uint32_t added; /*!< Samples added to a frame after the decimation */
+  uint32_t delivered; /*!< Samples received by the client */
+  uint32_t dropped; /*!< Samples the client was told were dropped */
+  uint32_t pending; /*!< Samples still in the ring at the end */
+  uint32_t frames; /*!< Frames received by the client */
+  uint32_t max_latency; /*!< Longest time in us from a sample was taken until the client had it */
+  double seconds; /*!< Time spent adding the samples and taking the frames out of the ring */
+} result_t;
+
+static void receive(const telemetry_frame_t *frame, uint32_t now, result_t *result) {
+  result->frames++;
+  result->delivered += frame->header.count;
+  result->dropped += frame->header.dropped;
+  for (uint8_t i = 0; i < frame->header.count; i++) {
+    uint32_t latency = now - frame->records[i].timestamp;
+    if (latency > result->max_latency)
+      result->max_latency = latency;
+  }
+}
+
+// Streams the records at "rate" Hz. If "link_rate" is zero, then every frame is received right away
+static void stream(const log_header_t *header, const std::vector<log_record_t> &records, uint16_t rate, uint32_t link_rate, result_t *result) {
+  static telemetry_t telemetry;
+  memset(result, 0, sizeof(result_t));
+  Telemetry_Init(&telemetry);
+  Telemetry_SetRate(&telemetry, rate);
+  Telemetry_SetScale(&telemetry, header->gyroScaleFactor, header->accScaleFactor, header->ground_pressure);
+
+  uint32_t busy_until = 0; // Time in us when the frame being sent over the slow link has been received
+  const telemetry_frame_t *sending = nullptr;
+  auto start = std::chrono::steady_clock::now();
+  for (const log_record_t &record : records) {
+    if (record.type != LOG_RECORD_SAMPLE)
+      continue;
+    const sensorRaw_t gyro = record.sample.gyro, acc = record.sample.acc;
+    Telemetry_Add(&telemetry, record.timestamp, LogFormat_GetPressure(&record), &gyro, &acc);
+
+    size_t length;
+    const telemetry_frame_t *frame;
+    if (link_rate == 0) {
+      while ((frame = Telemetry_Peek(&telemetry, &length)) != nullptr) {
+        receive(frame, record.timestamp, result);
+        Telemetry_Pop(&telemetry);
+      }
+      continue;
+    }
+    if (sending && (int32_t)(record.timestamp - busy_until) >= 0) {
+      receive(sending, busy_until, result);
+      Telemetry_Pop(&telemetry);
+      sending = nullptr;
+    }
+    if (!sending && (frame = Telemetry_Peek(&telemetry, &length)) != nullptr) {
+      sending = frame; // The frame stays in the ring until it has been sent
+      busy_until = record.timestamp + (uint32_t)(length * 1000000ULL / link_rate);
+    }
+  }
+
+  result->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  result->added = telemetry.samples;
+  result->pending = telemetry.dropped + telemetry.frames[telemetry.head].header.count; // Not reported yet
+  for (uint8_t i = telemetry.tail; i != telemetry.head; i = (i + 1) % TELEMETRY_FRAMES)
+    result->pending += telemetry.frames[i].header.count + telemetry.frames[i].header.dropped;
+}
+
+int main(int argc, char *argv[]) {
+  log_header_t header;
+  std::vector<log_record_t> records;
+  if (argc > 1) {
+    std::vector<uint8_t> data;
+    bool corrupted;
+    if (!LogFile_Load(argv[1], &data) || !LogFile_Parse(data.data(), data.size(), &header, &records, &corrupted)) {
+      fprintf(stderr, "Failed to read log file: %s\n", argv[1]);
+      return 1;
+    }
+    printf("Log file: %s\n", argv[1]);
+  } else {
+    SyntheticFlight_Generate(&records, &header, 1000, 60.0);
+    printf("Synthetic flight: 60 s at 1000 Hz\n");
+  }
+  if (records.size() < 2) {
+    fprintf(stderr, "No records\n");
+    return 1;
+  }
+  const double duration = (records.back().timestamp - records.front().timestamp) * 1e-6;
+
+  result_t result;
+  stream(&header, records, 0, 0, &result);
+  printf("Disabled: %.1f ns/sample\n\n", result.seconds * 1e9 / records.size());
+
+  printf("%-6s %-5s %10s %10s %10s %8s %12s %12s\n", "Rate", "Link", "ns/sample", "Delivered", "Dropped", "Frames", "Bytes/s", "Latency (ms)");
+  const uint16_t rates[] = { 10, 50, 100, 250, 1000 };
+  int rcode = 0;
+  for (uint16_t rate : rates) {
+    for (uint32_t link_rate : { 0U, SLOW_LINK_RATE }) {
+      stream(&header, records, rate, link_rate, &result);
+      double bytes = result.frames * sizeof(telemetry_header_t) + (double)result.delivered * sizeof(log_record_t);
+      printf("%-6u %-5s %10.1f %10u %10u %8u %12.0f %12.1f\n", rate, link_rate ? "slow" : "fast", result.seconds * 1e9 / records.size(),
+        result.delivered, result.dropped, result.frames, bytes / duration, result.max_latency * 1e-3);
+
+      if (result.delivered + result.dropped + result.pending != result.added) {
+        fprintf(stderr, "%u samples were lost without being reported\n", result.added - result.delivered - result.dropped - result.pending);
+        rcode = 1;
+      }
+      if (link_rate == 0 && (result.dropped != 0 || result.max_latency > TELEMETRY_MAX_LATENCY)) {
+        fprintf(stderr, "The fast client must receive every sample in time\n");
+        rcode = 1;
+      }
+    }
+  }
+  return rcode;
+}
@@ -0,0 +1,69 @@
+# Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+#
+# This software may be distributed and modified under the terms of the GNU
+# General Public License version 2 (GPL2) as published by the Free Software
+# Foundation and appearing in the file GPL2.TXT included in the packaging of
+# this file. Please note that GPL2 Section 2[b] requires that all works based
+# on this software must also be made publicly available under the terms of
+# the GPL2 ("Copyleft").
+#
+# Contact information
+# -------------------
+#
+# Kristian Lauszus
+# Web      :  https://lauszus.com
+# e-mail   :  lauszus@gmail.com
+
+# Checks that reading the barometer does not lower the sample rate of the IMU. The IMU is polled using --no-fifo, as the
+# sample clock of the IMU sets the rate when the FIFO is used, so the loop has to keep up with every sample. The simulator
+# is run without the barometer, with the non-blocking state machine and with the blocking MS5611_GetData(). The state
+# machine must stay within TOLERANCE of the rate without the barometer and the blocking driver must not, which shows that
+# the check would catch the barometer stalling the loop. The exit code is non-zero if either fails or any of the runs fail.
+# Any other arguments are given to all runs of the simulator. Note that the phase of the flight is detected using the
+# barometer, so the rates can not be compared using --arm or --adaptive:
+#   pio run -e native && python tools/check_baro_rate.py [--sim .pio/build/native/program] [--duration 60 ...]
+
+from __future__ import print_function
+
+import re
+import subprocess
+import sys
+
+# The state machine still uses the bus to start the conversions and read the results, so a poll of the IMU has to wait
+# for one of these once in a while
+TOLERANCE = 0.01
+
+
+def run(sim, args):
+    process = subprocess.Popen([sim, '--no-fifo'] + args, stdout=subprocess.PIPE, universal_newlines=True)
+    stdout = process.communicate()[0]
+    match = re.search(r'^Achieved rate:\s*([0-9.]+) Hz$', stdout, re.MULTILINE)
+    if process.returncode != 0 or not match:
+        sys.stdout.write(stdout)
+        sys.exit('Simulator failed: {} --no-fifo {}'.format(sim, ' '.join(args)))
+    return float(match.group(1))
+
+
+def main():
+    args = sys.argv[1:]
+    sim = '.pio/build/native/program'
+    if len(args) >= 2 and args[0] == '--sim':
+        sim = args[1]
+        args = args[2:]
+
+    without_baro = run(sim, args + ['--no-baro'])
+    with_baro = run(sim, args)
+    blocking_baro = run(sim, args + ['--blocking-baro'])
+    minimum = without_baro * (1.0 - TOLERANCE)
+    print('IMU rate without the barometer:       {:.1f} Hz'.format(without_baro))
+    print('IMU rate with the state machine:      {:.1f} Hz'.format(with_baro))
+    print('IMU rate with the blocking driver:    {:.1f} Hz'.format(blocking_baro))
+    print('Minimum rate with the barometer:      {:.1f} Hz ({:.0f} % tolerance)'.format(minimum, TOLERANCE * 100))
+    if blocking_baro >= minimum:
+        sys.exit('The blocking driver does not lower the sample rate, so the check does not work')
+    if with_baro < minimum:
+        sys.exit('The barometer lowers the sample rate of the IMU by {:.1f} Hz'.format(without_baro - with_baro))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,380 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Converts a log file in memory into CSV or columns of floats using several threads. The records are split into
+// segments at record or block boundaries, which are decoded and converted in parallel and written in order.
+// This is shared by log_decoder and bench_decoder.
+//
+// The columnar output starts with a log_convert_file_header_t followed by groups of rows. Every group starts with the
+// number of rows as an uint32_t followed by each column in the order of log_convert_column_e. The timestamp is an
+// uint32_t in us, the pressure an int32_t in pascal and the rest are floats. Only the samples are stored
+
+#ifndef __log_convert_h__
+#define __log_convert_h__
+
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "altitude.h"
+#include "csv_encoder.h"
+#include "log_file.h"
+
+#define LOG_CONVERT_SEGMENT_RECORDS (65536U) // Records in a segment i.e. the amount of work given to a thread at a time
+#define LOG_CONVERT_MAGIC           (0x4C4F4352UL) // "RCOL" in little endian
+#define LOG_CONVERT_VERSION         (1U)
+
+typedef enum {
+  LOG_CONVERT_CSV = 0, // The same CSV file as the logger sends
+  LOG_CONVERT_COLUMNAR = 1, // Columns of floats in groups of rows
+} log_convert_format_e;
+
+typedef enum {
+  LOG_CONVERT_TIMESTAMP = 0, // us
+  LOG_CONVERT_PRESSURE, // Pa
+  LOG_CONVERT_ALTITUDE, // m above the ground
+  LOG_CONVERT_GYRO_X, LOG_CONVERT_GYRO_Y, LOG_CONVERT_GYRO_Z, // deg/s
+  LOG_CONVERT_ACC_X, LOG_CONVERT_ACC_Y, LOG_CONVERT_ACC_Z, // m/s^2
+  LOG_CONVERT_COLUMNS,
+} log_convert_column_e;
+
+/** Header at the start of the columnar output */
+typedef struct {
+  uint32_t magic; /*!< Set to LOG_CONVERT_MAGIC */
+  uint16_t version; /*!< Set to LOG_CONVERT_VERSION */
+  uint16_t columns; /*!< Set to LOG_CONVERT_COLUMNS */
+} __attribute__((packed)) log_convert_file_header_t;
+
+/** Range of bytes in the file converted by a single thread */
+typedef struct {
+  size_t begin, end;
+} log_convert_segment_t;
+
+/** A log file split into segments */
+typedef struct {
+  log_header_t header;
+  const uint8_t *data;
+  size_t size;
+  size_t valid_size; /*!< Bytes before an incomplete record at the end of an uncompressed log */
+  size_t records; /*!< Number of records. Corrupted blocks are only found while converting */
+  std::vector<log_convert_segment_t> segments;
+} log_convert_t;
+
+/** Output of a conversion */
+typedef struct {
+  size_t records; /*!< Records decoded */
+  size_t samples; /*!< Sample records decoded */
+  size_t bytes; /*!< Bytes written */
+  size_t corrupted; /*!< Offset of an incomplete record at the end of an uncompressed log or zero */
+  size_t corrupted_blocks; /*!< Compressed blocks which could not be decoded, see LogConvert_Decode() */
+} log_convert_result_t;
+
+// Reads the header of the block at "pos". Returns false if it is corrupted or the file ends within the block
+static inline bool LogConvert_ReadBlockHeader(const log_convert_t *convert, size_t pos, log_block_header_t *block_header) {
+  if (convert->size - pos < sizeof(log_block_header_t))
+    return false;
+  memcpy(block_header, convert->data + pos, sizeof(log_block_header_t));
+  return LogCodec_IsValidBlock(pos, block_header) && block_header->length <= convert->size - pos;
+}
+
+// Checks the header and the size of the file and splits it into segments. Returns false if it is not a log file
+static inline bool LogConvert_Open(log_convert_t *convert, const uint8_t *data, size_t size) {
+  if (!LogFile_ParseHeader(data, size, &convert->header))
+    return false;
+  convert->data = data;
+  convert->size = size;
+  convert->records = 0;
+  convert->segments.clear();
+
+  size_t pos = convert->header.header_size;
+  if (!(convert->header.flags & LOG_FLAG_COMPRESSED)) {
+    // The records must fill the rest of the file
+    convert->records = (size - pos) / sizeof(log_record_t);
+    convert->valid_size = pos + convert->records * sizeof(log_record_t);
+    for (; pos < convert->valid_size; pos += LOG_CONVERT_SEGMENT_RECORDS * sizeof(log_record_t)) {
+      size_t end = pos + LOG_CONVERT_SEGMENT_RECORDS * sizeof(log_record_t);
+      convert->segments.push_back({ pos, end < convert->valid_size ? end : convert->valid_size });
+    }
+    return true;
+  }
+
+  // Follow the lengths of the blocks the same way as LogConvert_Decode() and end the segments where a new buffer of the
+  // log writer starts, as the decoding always gets back to those, even after a corrupted block
+  size_t begin = pos, count = 0;
+  while (pos < size) {
+    log_block_header_t block_header;
+    if (LogConvert_ReadBlockHeader(convert, pos, &block_header)) {
+      pos += block_header.length;
+      count += block_header.count;
+      convert->records += block_header.count;
+    } else
+      pos = LogCodec_NextBlock(pos);
+    if (count >= LOG_CONVERT_SEGMENT_RECORDS && pos % LOG_CODEC_BLOCK_SIZE == 0 && pos < size) {
+      convert->segments.push_back({ begin, pos });
+      begin = pos;
+      count = 0;
+    }
+  }
+  if (size > begin)
+    convert->segments.push_back({ begin, size });
+  convert->valid_size = size;
+  return true;
+}
+
+// Decodes the records in a segment. A block which can not be decoded is replaced by a LOG_RECORD_CORRUPTED record and
+// the decoding continues from the next block like the logger does. Returns the number of corrupted blocks
+static inline size_t LogConvert_Decode(const log_convert_t *convert, const log_convert_segment_t *segment, std::vector<log_record_t> *records) {
+  const uint8_t *data = convert->data;
+  records->clear();
+  if (!(convert->header.flags & LOG_FLAG_COMPRESSED)) {
+    records->resize((segment->end - segment->begin) / sizeof(log_record_t));
+    memcpy(records->data(), data + segment->begin, segment->end - segment->begin);
+    return 0;
+  }
+
+  log_record_t record;
+  size_t corrupted = 0;
+  for (size_t pos = segment->begin; pos < segment->end;) {
+    log_block_header_t block_header;
+    bool valid = LogConvert_ReadBlockHeader(convert, pos, &block_header);
+    if (valid) {
+      const uint8_t *p = data + pos + sizeof(block_header), *end = data + pos + block_header.length;
+      log_codec_state_t state;
+      LogCodec_Reset(&state);
+      for (uint16_t i = 0; i < block_header.count && valid; i++) {
+        size_t n = LogCodec_Decode(&state, p, end - p, &record);
+        if (n == 0)
+          valid = false; // The rest of the block can not be trusted
+        else {
+          p += n;
+          records->push_back(record);
+        }
+      }
+    }
+    if (valid)
+      pos += block_header.length;
+    else {
+      LogFormat_SetCorrupted(&record, (uint32_t)pos);
+      records->push_back(record);
+      pos = LogCodec_NextBlock(pos);
+      corrupted++;
+    }
+  }
+  return corrupted;
+}
+
+// Follows the LOG_RECORD_RANGE records, so "range" becomes the range after the records
+static inline void LogConvert_UpdateRange(const std::vector<log_record_t> &records, mpu6500_range_t *range) {
+  for (const log_record_t &record : records) {
+    if (record.type == LOG_RECORD_RANGE)
+      *range = LogFormat_GetRange(&record);
+  }
+}
+
+// Returns the factors converting the raw readings into deg/s and m/s^2 for a range, see csv_encoder_t
+static inline void LogConvert_GetScale(const log_header_t *header, const mpu6500_range_t *range, float *gyro_scale, float *acc_scale) {
+  if (range->gyro != CSV_ENCODER_RANGE_HEADER) {
+    *gyro_scale = 1.0f / MPU6500_GetGyroScaleFactor(range->gyro);
+    *acc_scale = GRAVITATIONAL_ACCELERATION / MPU6500_GetAccScaleFactor(range->acc);
+    return;
+  }
+  *gyro_scale = header->gyroScaleFactor > 0 ? 1.0f / header->gyroScaleFactor : 0;
+  *acc_scale = header->accScaleFactor > 0 ? GRAVITATIONAL_ACCELERATION / header->accScaleFactor : 0;
+}
+
+// Formats the records using the CSV encoder of the logger, so the output is the same as the file it sends.
+// "range" is the range at the first record
+static inline void LogConvert_FormatCsv(const log_header_t *header, const mpu6500_range_t *range, const std::vector<log_record_t> &records, std::string *out) {
+  csv_encoder_t csv_encoder;
+  CsvEncoder_Init(&csv_encoder, header);
+  CsvEncoder_Restore(&csv_encoder, 0, range); // The column names are only written once
+  out->resize(records.size() * CSV_ENCODER_MAX_ROW_SIZE);
+  size_t length = 0;
+  for (const log_record_t &record : records)
+    length += CsvEncoder_Format(&csv_encoder, &record, &(*out)[length]);
+  out->resize(length);
+}
+
+/** Rows from "row" until the next run are scaled using the same range */
+typedef struct {
+  uint32_t row;
+  float gyro_scale, acc_scale;
+} log_convert_run_t;
+
+// Splits the samples into columns first, so the scaling is done by simple loops over arrays, which the compiler vectorises.
+// "range" is the range at the first record
+static inline void LogConvert_FormatColumns(const log_header_t *header, const mpu6500_range_t *range, const std::vector<log_record_t> &records, std::string *out, size_t *samples) {
+  std::vector<log_convert_run_t> runs(1);
+  runs[0].row = 0;
+  LogConvert_GetScale(header, range, &runs[0].gyro_scale, &runs[0].acc_scale);
+  std::vector<uint32_t> timestamp;
+  std::vector<int32_t> pressure;
+  std::vector<int16_t> raw[6];
+  timestamp.reserve(records.size());
+  pressure.reserve(records.size());
+  for (std::vector<int16_t> &column : raw)
+    column.reserve(records.size());
+  for (const log_record_t &record : records) {
+    if (record.type == LOG_RECORD_RANGE) {
+      const mpu6500_range_t new_range = LogFormat_GetRange(&record);
+      log_convert_run_t run = { (uint32_t)timestamp.size(), 0, 0 };
+      LogConvert_GetScale(header, &new_range, &run.gyro_scale, &run.acc_scale);
+      if (runs.back().row == run.row)
+        runs.back() = run; // No samples were taken using the previous range
+      else
+        runs.push_back(run);
+    }
+    if (record.type != LOG_RECORD_SAMPLE)
+      continue;
+    timestamp.push_back(record.timestamp);
+    pressure.push_back(LogFormat_GetPressure(&record));
+    for (uint8_t axis = 0; axis < 3; axis++) {
+      raw[axis].push_back(record.sample.gyro.data[axis]);
+      raw[3 + axis].push_back(record.sample.acc.data[axis]);
+    }
+  }
+
+  const uint32_t rows = (uint32_t)timestamp.size();
+  *samples = rows;
+  out->resize(sizeof(rows) + LOG_CONVERT_COLUMNS * rows * sizeof(float));
+  uint8_t *p = (uint8_t*)&(*out)[0];
+  memcpy(p, &rows, sizeof(rows));
+  p += sizeof(rows);
+  memcpy(p, timestamp.data(), rows * sizeof(uint32_t));
+  p += rows * sizeof(uint32_t);
+  memcpy(p, pressure.data(), rows * sizeof(int32_t));
+  p += rows * sizeof(int32_t);
+
+  // The barometer is sampled slower than the IMU, so the altitude is only calculated when the pressure changes
+  std::vector<float> column(rows);
+  const int32_t ground_altitude = header->ground_pressure > 0 ? Altitude_FromPressure(header->ground_pressure) : 0; // Older logs use the absolute altitude
+  float altitude = 0;
+  for (uint32_t i = 0; i < rows; i++) {
+    if (i == 0 || pressure[i] != pressure[i - 1])
+      altitude = (Altitude_FromPressure(pressure[i]) - ground_altitude) / 1000.0f;
+    column[i] = altitude;
+  }
+  memcpy(p, column.data(), rows * sizeof(float));
+  p += rows * sizeof(float);
+
+  for (uint8_t i = 0; i < 6; i++) {
+    const int16_t *in = raw[i].data();
+    float *values = column.data();
+    for (size_t k = 0; k < runs.size(); k++) {
+      const float scale = i < 3 ? runs[k].gyro_scale : runs[k].acc_scale;
+      const uint32_t end = k + 1 < runs.size() ? runs[k + 1].row : rows;
+      for (uint32_t j = runs[k].row; j < end; j++)
+        values[j] = in[j] * scale;
+    }
+    memcpy(p, values, rows * sizeof(float));
+    p += rows * sizeof(float);
+  }
+}
+
+/** Work done by a single thread */
+typedef struct {
+  std::vector<log_record_t> records;
+  mpu6500_range_t range; /*!< Range at the start of the segment */
+  std::string out;
+  size_t samples;
+  size_t corrupted_blocks;
+} log_convert_job_t;
+
+static inline void LogConvert_DecodeJob(const log_convert_t *convert, const log_convert_segment_t *segment, log_convert_job_t *job) {
+  job->corrupted_blocks = LogConvert_Decode(convert, segment, &job->records);
+}
+
+static inline void LogConvert_FormatJob(const log_convert_t *convert, log_convert_format_e format, log_convert_job_t *job) {
+  job->samples = 0;
+  if (format == LOG_CONVERT_CSV) {
+    LogConvert_FormatCsv(&convert->header, &job->range, job->records, &job->out);
+    for (const log_record_t &record : job->records)
+      job->samples += record.type == LOG_RECORD_SAMPLE;
+  } else
+    LogConvert_FormatColumns(&convert->header, &job->range, job->records, &job->out, &job->samples);
+}
+
+// Converts the log using up to "threads" threads and writes it to "out". Corrupted blocks and an incomplete tail are
+// reported in the result and marked in the CSV file the same way as the logger does. Returns false if the output could not be written
+static inline bool LogConvert_Run(const log_convert_t *convert, log_convert_format_e format, unsigned threads, FILE *out, log_convert_result_t *result) {
+  memset(result, 0, sizeof(log_convert_result_t));
+  if (threads == 0)
+    threads = 1;
+
+  std::string start;
+  if (format == LOG_CONVERT_CSV) {
+    csv_encoder_t csv_encoder;
+    CsvEncoder_Init(&csv_encoder, &convert->header);
+    uint8_t names[CSV_ENCODER_MAX_ROW_SIZE];
+    start.assign((const char*)names, CsvEncoder_Flush(&csv_encoder, names, sizeof(names)));
+  } else {
+    const log_convert_file_header_t file_header = { LOG_CONVERT_MAGIC, LOG_CONVERT_VERSION, LOG_CONVERT_COLUMNS };
+    start.assign((const char*)&file_header, sizeof(file_header));
+  }
+  if (fwrite(start.data(), 1, start.size(), out) != start.size())
+    return false;
+  result->bytes = start.size();
+
+  std::vector<log_convert_job_t> jobs(threads);
+  const std::vector<log_convert_segment_t> &segments = convert->segments;
+  mpu6500_range_t range = { CSV_ENCODER_RANGE_HEADER, CSV_ENCODER_RANGE_HEADER };
+  for (size_t first = 0; first < segments.size(); first += threads) {
+    size_t n = segments.size() - first < threads ? segments.size() - first : threads;
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < n; i++)
+      workers.emplace_back(LogConvert_DecodeJob, convert, &segments[first + i], &jobs[i]);
+    LogConvert_DecodeJob(convert, &segments[first], &jobs[0]); // The calling thread does the first one
+    for (std::thread &worker : workers)
+      worker.join();
+
+    // The range at the start of a segment depends on the segments before it, so it is found before they are formatted
+    for (size_t i = 0; i < n; i++) {
+      jobs[i].range = range;
+      LogConvert_UpdateRange(jobs[i].records, &range);
+    }
+    workers.clear();
+    for (size_t i = 1; i < n; i++)
+      workers.emplace_back(LogConvert_FormatJob, convert, format, &jobs[i]);
+    LogConvert_FormatJob(convert, format, &jobs[0]);
+    for (std::thread &worker : workers)
+      worker.join();
+
+    for (size_t i = 0; i < n; i++) {
+      const log_convert_job_t *job = &jobs[i];
+      if (fwrite(job->out.data(), 1, job->out.size(), out) != job->out.size())
+        return false;
+      result->bytes += job->out.size();
+      result->records += job->records.size();
+      result->samples += job->samples;
+      result->corrupted_blocks += job->corrupted_blocks;
+    }
+  }
+  if (convert->valid_size != convert->size)
+    result->corrupted = convert->valid_size;
+
+  if (result->corrupted && format == LOG_CONVERT_CSV) {
+    static const char corrupted[] = CSV_ENCODER_CORRUPTED;
+    if (fwrite(corrupted, 1, sizeof(corrupted) - 1, out) != sizeof(corrupted) - 1)
+      return false;
+    result->bytes += sizeof(corrupted) - 1;
+  }
+  return true;
+}
+
+#endif // __log_convert_h__
@@ -0,0 +1,94 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Converts a log file into CSV or columns of floats on the host, so the ESP8266 does not have to do it.
+// The file is memory mapped and converted using all cores, see log_convert.h.
+// Build: g++ -O2 -std=c++11 -pthread -Iinclude tools/log_decoder.cpp src/altitude.cpp src/csv_encoder.cpp src/log_codec.cpp -o log_decoder
+// Usage: ./log_decoder [-c] [-j threads] [-o output] log.bin > log.csv
+//   -c  Write the samples as columns of floats instead of CSV
+//   -j  Number of threads. All cores are used by default
+//   -o  Write to a file instead of stdout
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "log_convert.h"
+
+int main(int argc, char *argv[]) {
+  log_convert_format_e format = LOG_CONVERT_CSV;
+  unsigned threads = std::thread::hardware_concurrency();
+  const char *output = nullptr;
+  int opt;
+  while ((opt = getopt(argc, argv, "cj:o:")) != -1) {
+    if (opt == 'c')
+      format = LOG_CONVERT_COLUMNAR;
+    else if (opt == 'j')
+      threads = atoi(optarg);
+    else if (opt == 'o')
+      output = optarg;
+    else
+      optind = argc + 1; // Print the usage
+  }
+  if (optind != argc - 1) {
+    fprintf(stderr, "Usage: %s [-c] [-j threads] [-o output] log.bin\n", argv[0]);
+    return 1;
+  }
+  const char *path = argv[optind];
+
+  int fd = open(path, O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    fprintf(stderr, "Failed to open: %s\n", path);
+    return 1;
+  }
+  const size_t size = st.st_size;
+  void *data = size ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+  close(fd);
+  log_convert_t convert;
+  if (data == MAP_FAILED || !LogConvert_Open(&convert, (const uint8_t*)data, size)) {
+    fprintf(stderr, "Not a valid log file: %s\n", path);
+    return 1;
+  }
+  madvise(data, size, MADV_SEQUENTIAL);
+
+  FILE *out = output ? fopen(output, "wb") : stdout;
+  if (!out) {
+    fprintf(stderr, "Failed to create: %s\n", output);
+    return 1;
+  }
+  log_convert_result_t result;
+  bool written = LogConvert_Run(&convert, format, threads, out, &result);
+  if (fflush(out) != 0 || (output && fclose(out) != 0))
+    written = false;
+  munmap(data, size);
+  if (!written) {
+    fprintf(stderr, "Failed to write the output\n");
+    return 1;
+  }
+
+  if (result.corrupted_blocks)
+    fprintf(stderr, "The log file is corrupted, %zu blocks were skipped\n", result.corrupted_blocks);
+  if (result.corrupted)
+    fprintf(stderr, "The log file is corrupted after byte %zu, the last %zu bytes were skipped\n", result.corrupted, size - result.corrupted);
+  if (result.corrupted_blocks || result.corrupted)
+    return 2;
+  return 0;
+}
@@ -0,0 +1,143 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Host side helper for loading a log file into memory. This is shared by the tools in this directory
+
+#ifndef __log_file_h__
+#define __log_file_h__
+
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <vector>
+
+#include "log_codec.h"
+#include "log_format.h"
+
+// Parses the header. Fields missing in older versions are set to zero. Returns false if the file is not a valid log file
+static inline bool LogFile_ParseHeader(const uint8_t *data, size_t size, log_header_t *header) {
+  memset(header, 0, sizeof(log_header_t));
+  const size_t fixed_size = offsetof(log_header_t, record_size);
+  if (size < fixed_size)
+    return false;
+  memcpy(header, data, fixed_size);
+  if (header->magic != LOG_MAGIC || header->version > LOG_VERSION || header->header_size < fixed_size || header->header_size > size)
+    return false;
+  memcpy((uint8_t*)header + fixed_size, data + fixed_size, (header->header_size < sizeof(log_header_t) ? header->header_size : sizeof(log_header_t)) - fixed_size);
+  return header->record_size == sizeof(log_record_t);
+}
+
+// Parses the header and decodes all records. Returns false if the file is not a valid log file.
+// "corrupted" is set if the file ends with an incomplete record or a compressed block could not be decoded. A corrupted
+// block is replaced by a LOG_RECORD_CORRUPTED record and the decoding continues from the next block like the logger does
+static inline bool LogFile_Parse(const uint8_t *data, size_t size, log_header_t *header, std::vector<log_record_t> *records, bool *corrupted) {
+  *corrupted = false;
+  if (!LogFile_ParseHeader(data, size, header))
+    return false;
+
+  size_t pos = header->header_size;
+  log_record_t record;
+  if (!(header->flags & LOG_FLAG_COMPRESSED)) {
+    for (; pos + sizeof(log_record_t) <= size; pos += sizeof(log_record_t)) {
+      memcpy(&record, data + pos, sizeof(log_record_t));
+      records->push_back(record);
+    }
+    *corrupted = pos != size;
+    return true;
+  }
+
+  while (pos < size) {
+    log_block_header_t block_header;
+    bool valid = size - pos >= sizeof(block_header);
+    if (valid) {
+      memcpy(&block_header, data + pos, sizeof(block_header));
+      valid = LogCodec_IsValidBlock(pos, &block_header) && block_header.length <= size - pos; // The file may end within the block
+    }
+    if (valid) {
+      const uint8_t *p = data + pos + sizeof(block_header), *end = data + pos + block_header.length;
+      log_codec_state_t state;
+      LogCodec_Reset(&state);
+      for (uint16_t i = 0; i < block_header.count && valid; i++) {
+        size_t n = LogCodec_Decode(&state, p, end - p, &record);
+        if (n == 0)
+          valid = false;
+        else {
+          p += n;
+          records->push_back(record);
+        }
+      }
+    }
+    if (valid)
+      pos += block_header.length;
+    else {
+      *corrupted = true;
+      LogFormat_SetCorrupted(&record, pos);
+      records->push_back(record);
+      pos = LogCodec_NextBlock(pos);
+    }
+  }
+  return true;
+}
+
+// Packs the records into padded blocks the same way as the log writer does. The first "offset" bytes are left for the
+// header of the log, so the blocks are aligned like in a log file, see LogCodec_NextBlock(). The last block is only
+// padded if "pad" is set. Returns the number of bytes used including the offset
+static inline size_t LogFile_Encode(const std::vector<log_record_t> &records, size_t offset, bool pad, std::vector<uint8_t> *out) {
+  out->assign(offset + ((records.size() * LOG_CODEC_MAX_RECORD_SIZE) / LOG_CODEC_BLOCK_SIZE + 2) * LOG_CODEC_BLOCK_SIZE, 0);
+  size_t block = offset, pos = offset + sizeof(log_block_header_t);
+  log_block_header_t block_header = { 0, 0 };
+  log_codec_state_t state;
+  LogCodec_Reset(&state);
+  for (const log_record_t &record : records) {
+    uint8_t encoded[LOG_CODEC_MAX_RECORD_SIZE];
+    log_codec_state_t next = state;
+    size_t n = LogCodec_Encode(&next, &record, encoded);
+    if (pos + n > LogCodec_NextBlock(block)) {
+      block_header.length = (uint16_t)(LogCodec_NextBlock(block) - block);
+      memcpy(&(*out)[block], &block_header, sizeof(block_header));
+      block = LogCodec_NextBlock(block);
+      pos = block + sizeof(log_block_header_t);
+      block_header.count = 0;
+      LogCodec_Reset(&next);
+      n = LogCodec_Encode(&next, &record, encoded);
+    }
+    memcpy(&(*out)[pos], encoded, n);
+    pos += n;
+    block_header.count++;
+    state = next;
+  }
+  if (pad)
+    pos = LogCodec_NextBlock(block);
+  block_header.length = (uint16_t)(pos - block);
+  memcpy(&(*out)[block], &block_header, sizeof(block_header));
+  out->resize(pos);
+  return pos;
+}
+
+static inline bool LogFile_Load(const char *path, std::vector<uint8_t> *data) {
+  FILE *f = fopen(path, "rb");
+  if (!f)
+    return false;
+  uint8_t buf[1 << 16];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+    data->insert(data->end(), buf, buf + n);
+  fclose(f);
+  return true;
+}
+
+#endif // __log_file_h__
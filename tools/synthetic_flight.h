@@ -0,0 +1,143 @@
+/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Generates a deterministic synthetic flight, so the tools can be run without a recorded log:
+// pad, boost, coast, apogee, descent under a parachute and landed
+
+#ifndef __synthetic_flight_h__
+#define __synthetic_flight_h__
+
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+#include "log_format.h"
+
+#define SYNTHETIC_FLIGHT_LAUNCH     (5.0)   // Default time of the launch in s
+#define SYNTHETIC_FLIGHT_BURN       (1.5)   // Burn time in s
+#define SYNTHETIC_FLIGHT_THRUST     (60.0)  // Acceleration during the burn in m/s^2
+#define SYNTHETIC_FLIGHT_DESCENT    (-5.0)  // Vertical velocity under the parachute in m/s
+
+typedef struct {
+  uint32_t seed;
+  double launch; // Time of the launch in s
+  double time, altitude, velocity; // In s, m and m/s
+  bool parachute;
+} synthetic_flight_t;
+
+/** Sensor readings in physical units */
+typedef struct {
+  double gyro[3]; // Angular rate in deg/s
+  double acc[3]; // Specific force in g
+  double pressure; // Pressure in pascal
+} synthetic_sample_t;
+
+// Returns a normally distributed random value using the Box-Muller transform
+static inline double SyntheticFlight_Noise(synthetic_flight_t *flight, double sigma) {
+  double u[2];
+  for (int i = 0; i < 2; i++) {
+    flight->seed ^= flight->seed << 13; // Xorshift32
+    flight->seed ^= flight->seed >> 17;
+    flight->seed ^= flight->seed << 5;
+    u[i] = (flight->seed + 1.0) / 4294967297.0;
+  }
+  return sigma * sqrt(-2.0 * log(u[0])) * cos(2.0 * M_PI * u[1]);
+}
+
+static inline void SyntheticFlight_Init(synthetic_flight_t *flight) {
+  memset(flight, 0, sizeof(synthetic_flight_t));
+  flight->seed = 0x12345678;
+  flight->launch = SYNTHETIC_FLIGHT_LAUNCH;
+}
+
+// Fills in a header matching the scale factors used by SyntheticFlight_ToRecord()
+static inline void SyntheticFlight_Header(log_header_t *header, uint16_t sample_rate) {
+  memset(header, 0, sizeof(log_header_t));
+  header->magic = LOG_MAGIC;
+  header->version = LOG_VERSION;
+  header->header_size = sizeof(log_header_t);
+  header->record_size = sizeof(log_record_t);
+  header->sample_rate = sample_rate;
+  header->gyroScaleFactor = 131.0f; // +-250 deg/s
+  header->accScaleFactor = 2048.0f; // +-16 g
+  header->ground_pressure = 101325; // The flight starts at sea level
+}
+
+// Advances the flight by "dt" seconds and returns the sensor readings at the new time
+static inline void SyntheticFlight_Step(synthetic_flight_t *flight, double dt, synthetic_sample_t *sample) {
+  const double g = GRAVITATIONAL_ACCELERATION;
+  double t = flight->time += dt;
+  double force = g, vibration = 0.01 * g, spin = 0; // Specific force along the rocket in m/s^2 and the roll rate in deg/s
+
+  if (t >= flight->launch && flight->altitude >= 0) {
+    if (t < flight->launch + SYNTHETIC_FLIGHT_BURN) {
+      force = SYNTHETIC_FLIGHT_THRUST + g; // Boost
+      vibration = 0.3 * g;
+      spin = 200.0 * (t - flight->launch) / SYNTHETIC_FLIGHT_BURN;
+    } else if (!flight->parachute) {
+      force = -0.002 * flight->velocity * fabs(flight->velocity); // Coast with drag
+      vibration = 0.05 * g;
+      spin = 200.0;
+      if (flight->velocity < 0)
+        flight->parachute = true; // Apogee
+    } else {
+      // Under the parachute the drag balances gravity at the descent rate
+      force = g + 2.0 * (SYNTHETIC_FLIGHT_DESCENT - flight->velocity);
+      vibration = 0.1 * g;
+      spin = 20.0 * sin(t);
+    }
+    flight->velocity += (force - g) * dt;
+    flight->altitude += flight->velocity * dt;
+    if (flight->altitude < 0) {
+      flight->altitude = flight->velocity = 0; // Landed
+      force = g;
+    }
+  }
+
+  sample->pressure = 101325.0 * pow(1.0 - flight->altitude / 44330.0, 5.255) + SyntheticFlight_Noise(flight, 4.0);
+  for (int axis = 0; axis < 3; axis++)
+    sample->acc[axis] = ((axis == 2 ? force : 0) + SyntheticFlight_Noise(flight, vibration)) / g;
+  for (int axis = 0; axis < 3; axis++)
+    sample->gyro[axis] = (axis == 2 ? spin : 0) + SyntheticFlight_Noise(flight, 0.15);
+}
+
+// Converts the readings into raw counts using the scale factors in the header
+static inline void SyntheticFlight_ToRecord(const log_header_t *header, double time, const synthetic_sample_t *sample, log_record_t *record) {
+  record->timestamp = (uint32_t)(time * 1e6 + 0.5);
+  record->type = LOG_RECORD_SAMPLE;
+  LogFormat_SetPressure(record, (int32_t)lround(sample->pressure));
+  for (int axis = 0; axis < 3; axis++) {
+    double a = sample->acc[axis] * header->accScaleFactor, w = sample->gyro[axis] * header->gyroScaleFactor;
+    record->sample.acc.data[axis] = (int16_t)fmax(-32768.0, fmin(32767.0, lround(a)));
+    record->sample.gyro.data[axis] = (int16_t)fmax(-32768.0, fmin(32767.0, lround(w)));
+  }
+}
+
+static inline void SyntheticFlight_Generate(std::vector<log_record_t> *records, log_header_t *header, uint16_t sample_rate, double duration) {
+  synthetic_flight_t flight;
+  SyntheticFlight_Init(&flight);
+  SyntheticFlight_Header(header, sample_rate);
+  size_t n = (size_t)(duration * sample_rate);
+  records->resize(n);
+  for (size_t i = 0; i < n; i++) {
+    synthetic_sample_t sample;
+    SyntheticFlight_Step(&flight, 1.0 / sample_rate, &sample);
+    SyntheticFlight_ToRecord(header, flight.time, &sample, &(*records)[i]);
+  }
+}
+
+#endif // __synthetic_flight_h__
@@ -0,0 +1,114 @@
+# Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+#
+# This software may be distributed and modified under the terms of the GNU
+# General Public License version 2 (GPL2) as published by the Free Software
+# Foundation and appearing in the file GPL2.TXT included in the packaging of
+# this file. Please note that GPL2 Section 2[b] requires that all works based
+# on this software must also be made publicly available under the terms of
+# the GPL2 ("Copyleft").
+#
+# Contact information
+# -------------------
+#
+# Kristian Lauszus
+# Web      :  https://lauszus.com
+# e-mail   :  lauszus@gmail.com
+
+# Compresses the files in the web directory into include/web_assets.h, so they are sent from the flash as they are.
+# This is run by PlatformIO before every build of the firmware, but it can also be run by hand:
+#   python3 tools/web_assets.py
+
+import gzip
+import hashlib
+import os
+
+TYPES = {
+    '.html': 'text/html',
+    '.js': 'application/javascript',
+    '.css': 'text/css',
+}
+
+HEADER = '''/* Copyright (C) 2019 Kristian Lauszus and Mads Bornebusch. All rights reserved.
+
+ This software may be distributed and modified under the terms of the GNU
+ General Public License version 2 (GPL2) as published by the Free Software
+ Foundation and appearing in the file GPL2.TXT included in the packaging of
+ this file. Please note that GPL2 Section 2[b] requires that all works based
+ on this software must also be made publicly available under the terms of
+ the GPL2 ("Copyleft").
+
+ Contact information
+ -------------------
+
+ Kristian Lauszus
+ Web      :  https://lauszus.com
+ e-mail   :  lauszus@gmail.com
+*/
+
+// Generated from the web directory by tools/web_assets.py. Do not edit
+
+#ifndef __web_assets_h__
+#define __web_assets_h__
+
+#include <Arduino.h>
+
+/** A gzip compressed file stored in the flash */
+typedef struct {
+  const char *url; /*!< The file is served at this URL */
+  const char *type; /*!< Content type */
+  const uint8_t *data; /*!< Compressed content */
+  uint32_t length; /*!< Length of the compressed content in bytes */
+  const char *etag; /*!< Hash of the content, so a cached copy is only sent again when the firmware changes it */
+} web_asset_t;
+'''
+
+
+def url(name):
+    base = os.path.splitext(name)[0]
+    if base == 'index':
+        return '/'
+    if name.endswith('.html'):
+        return '/' + base  # The pages are served without the extension
+    return '/' + name
+
+
+def generate(root):
+    web = os.path.join(root, 'web')
+    assets = []
+    out = [HEADER]
+    for name in sorted(os.listdir(web)):
+        ext = os.path.splitext(name)[1]
+        if ext not in TYPES:
+            continue
+        with open(os.path.join(web, name), 'rb') as f:
+            content = f.read()
+        data = gzip.compress(content, 9, mtime=0)  # The time is left out, so the output only changes with the content
+        symbol = 'web_' + name.replace('.', '_').replace('-', '_')
+        out.append('\n// %s: %u bytes, %u bytes compressed\n' % (name, len(content), len(data)))
+        out.append('static const uint8_t %s[] PROGMEM = {\n' % symbol)
+        for i in range(0, len(data), 16):
+            out.append('  ' + ', '.join('0x%02X' % b for b in data[i:i + 16]) + ',\n')
+        out.append('};\n')
+        etag = hashlib.sha1(content).hexdigest()[:16]
+        assets.append('  { "%s", "%s", %s, sizeof(%s), "\\"%s\\"" },\n' % (url(name), TYPES[ext], symbol, symbol, etag))
+    out.append('\nstatic const web_asset_t web_assets[] = {\n')
+    out.extend(assets)
+    out.append('};\n\n#endif // __web_assets_h__\n')
+    text = ''.join(out)
+
+    # Only write the file when it has changed, so the firmware is not rebuilt
+    path = os.path.join(root, 'include', 'web_assets.h')
+    if os.path.exists(path):
+        with open(path) as f:
+            if f.read() == text:
+                return
+    with open(path, 'w') as f:
+        f.write(text)
+    print('Generated ' + path)
+
+
+try:
+    Import('env')  # Run by PlatformIO
+    generate(env.subst('$PROJECT_DIR'))
+except NameError:
+    generate(os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')))
@@ -0,0 +1,110 @@
+// Decodes a binary log file as described in log_format.h and log_codec.h, so the logger does not have to convert it.
+// Returns the header and the samples as arrays of the time in s, altitude in m, acceleration in g and angular rate in deg/s
+var LOG_MAGIC = 0x474F4C52, LOG_FLAG_COMPRESSED = 1, LOG_RECORD_SIZE = 20, LOG_BLOCK_SIZE = 2048;
+var LOG_RECORD_SAMPLE = 0, LOG_RECORD_LAUNCH = 3, LOG_RECORD_PHASE = 4, LOG_RECORD_RANGE = 6;
+var GYRO_SCALE_FACTORS = [131, 65.5, 32.8, 16.4], ACC_SCALE_FACTORS = [16384, 8192, 4096, 2048];
+var PHASES = ['pad', 'boost', 'coast', 'apogee', 'descent', 'landed'];
+
+function altitude(pressure) {
+  return 44330 * (1 - Math.pow(pressure / 101325, 1 / 5.255));
+}
+
+function decodeLog(buffer) {
+  var v = new DataView(buffer), size = buffer.byteLength;
+  if (size < 32 || v.getUint32(0, true) != LOG_MAGIC)
+    throw 'Not a log file';
+  var headerSize = v.getUint16(6, true);
+  if (headerSize < 32 || headerSize > size || v.getUint16(8, true) != LOG_RECORD_SIZE)
+    throw 'Unsupported log file';
+  var header = {
+    version: v.getUint16(4, true),
+    sample_rate: v.getUint16(10, true),
+    flags: headerSize >= 36 ? v.getUint32(32, true) : 0,
+    ground_pressure: headerSize >= 40 ? v.getInt32(36, true) : 0
+  };
+  var gyroScale = v.getFloat32(12, true), accScale = v.getFloat32(16, true), ground = NaN;
+  var log = { header: header, time: [], alt: [], acc: [[], [], []], gyro: [[], [], []], events: [], corrupted: false };
+
+  function record(timestamp, type, p, gyro, acc, arg) {
+    if (type == LOG_RECORD_SAMPLE) {
+      if (isNaN(ground)) // The first pressure is used as the ground for older logs
+        ground = altitude(header.ground_pressure > 0 ? header.ground_pressure : p);
+      log.time.push(timestamp / 1e6);
+      log.alt.push(altitude(p) - ground);
+      for (var axis = 0; axis < 3; axis++) {
+        log.gyro[axis].push(gyro[axis] / gyroScale);
+        log.acc[axis].push(acc[axis] / accScale);
+      }
+    } else if (type == LOG_RECORD_RANGE) {
+      gyroScale = GYRO_SCALE_FACTORS[arg[0] & 3];
+      accScale = ACC_SCALE_FACTORS[arg[1] & 3];
+    } else if (type == LOG_RECORD_LAUNCH)
+      log.events.push([timestamp / 1e6, 'launch']);
+    else if (type == LOG_RECORD_PHASE)
+      log.events.push([timestamp / 1e6, PHASES[arg[0]] || 'unknown']);
+  }
+
+  var pos = headerSize;
+  if (!(header.flags & LOG_FLAG_COMPRESSED)) {
+    for (; pos + LOG_RECORD_SIZE <= size; pos += LOG_RECORD_SIZE) {
+      var p = v.getUint8(pos + 5) | (v.getUint8(pos + 6) << 8) | (v.getUint8(pos + 7) << 16);
+      record(v.getUint32(pos, true), v.getUint8(pos + 4), p,
+        [v.getInt16(pos + 8, true), v.getInt16(pos + 10, true), v.getInt16(pos + 12, true)],
+        [v.getInt16(pos + 14, true), v.getInt16(pos + 16, true), v.getInt16(pos + 18, true)],
+        [v.getUint32(pos + 8, true), v.getUint32(pos + 12, true), v.getUint32(pos + 16, true)]);
+    }
+    log.corrupted = pos != size;
+    return log;
+  }
+
+  // Every block starts with its length and the number of records. The values are zig-zag varints relative to the
+  // previous record, see log_codec.cpp. A corrupted block is skipped like the logger does, see LogCodec_NextBlock()
+  var bytes = new Uint8Array(buffer), end;
+  function varint() {
+    var value = 0;
+    for (var shift = 0; shift < 35 && pos < end; shift += 7) {
+      var byte = bytes[pos++];
+      value += (byte & 0x7F) * Math.pow(2, shift);
+      if (!(byte & 0x80))
+        return value >>> 0;
+    }
+    throw 'corrupted';
+  }
+  function unzigzag(value) {
+    return (value >>> 1) ^ -(value & 1);
+  }
+  while (pos < size) {
+    var block = pos, next = (Math.floor(block / LOG_BLOCK_SIZE) + 1) * LOG_BLOCK_SIZE;
+    var timestamp = 0, dt = 0, pressure = 0, gyro = [0, 0, 0], acc = [0, 0, 0];
+    try {
+      if (size - pos < 4)
+        throw 'corrupted';
+      var length = v.getUint16(pos, true), count = v.getUint16(pos + 2, true);
+      end = block + length;
+      if (length < 4 || end > next || end > size)
+        throw 'corrupted';
+      pos += 4;
+      for (var i = 0; i < count; i++) {
+        dt = (dt + unzigzag(varint())) >>> 0;
+        timestamp = (timestamp + dt) >>> 0;
+        var value = varint();
+        if (value & 1) {
+          var type = value >>> 1;
+          record(timestamp, type, 0, null, null, [varint(), varint(), varint()]);
+          continue;
+        }
+        pressure += unzigzag(value >>> 1);
+        for (var axis = 0; axis < 3; axis++)
+          gyro[axis] = (gyro[axis] + unzigzag(varint())) << 16 >> 16;
+        for (var axis = 0; axis < 3; axis++)
+          acc[axis] = (acc[axis] + unzigzag(varint())) << 16 >> 16;
+        record(timestamp, LOG_RECORD_SAMPLE, pressure, gyro, acc, null);
+      }
+      pos = end;
+    } catch (e) {
+      log.corrupted = true;
+      pos = next;
+    }
+  }
+  return log;
+}
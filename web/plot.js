@@ -0,0 +1,35 @@
+// Draws the lines in the canvas with the given id. "x" holds the x-value of every point or is null if the points are
+// evenly spaced over "n" points. Every column of pixels is drawn as the minimum and maximum in it, so long logs draw fast
+var colors = ['#d00', '#080', '#00d'];
+function plot(id, lines, x, n) {
+  var c = document.getElementById(id), ctx = c.getContext('2d');
+  var min = Infinity, max = -Infinity;
+  lines.forEach(function(line) { line.forEach(function(y) { min = Math.min(min, y); max = Math.max(max, y); }); });
+  if (!(max > min)) { min -= 1; max += 1; }
+  var x0 = x ? x[0] : 0, x1 = x ? x[x.length - 1] : n - 1;
+  if (!(x1 > x0)) x1 = x0 + 1;
+  ctx.clearRect(0, 0, c.width, c.height);
+  ctx.fillStyle = '#000';
+  ctx.fillText(max.toFixed(2), 2, 10);
+  ctx.fillText(min.toFixed(2), 2, c.height - 2);
+  if (x) {
+    ctx.textAlign = 'right';
+    ctx.fillText(x0.toFixed(1) + ' - ' + x1.toFixed(1) + ' s', c.width - 2, c.height - 2);
+    ctx.textAlign = 'left';
+  }
+  var sx = (c.width - 1) / (x1 - x0), sy = (c.height - 1) / (max - min);
+  lines.forEach(function(line, j) {
+    ctx.strokeStyle = colors[j];
+    ctx.beginPath();
+    var column = -1, lo = 0, hi = 0;
+    for (var i = 0; i < line.length; i++) {
+      var px = Math.round(((x ? x[i] : i) - x0) * sx), y = line[i];
+      if (px != column) {
+        if (column >= 0) { ctx.lineTo(column, (max - lo) * sy); ctx.lineTo(column, (max - hi) * sy); }
+        column = px; lo = hi = y;
+      } else { lo = Math.min(lo, y); hi = Math.max(hi, y); }
+    }
+    if (column >= 0) { ctx.lineTo(column, (max - lo) * sy); ctx.lineTo(column, (max - hi) * sy); }
+    ctx.stroke();
+  });
+}